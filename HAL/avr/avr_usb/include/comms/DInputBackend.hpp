@@ -17,7 +17,7 @@ class DInputBackend : public CommunicationBackend {
 
   private:
     int16_t GetDpadAngle(bool left, bool right, bool down, bool up);
-    Joystick_ *_joystick;
+    Joystick_ _joystick;
 };
 
 #endif
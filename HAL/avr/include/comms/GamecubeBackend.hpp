@@ -14,11 +14,12 @@ class GamecubeBackend : public CommunicationBackend {
         int polling_rate,
         int data_pin
     );
-    ~GamecubeBackend();
     void SendReport();
 
+    bool CanStall(uint32_t duration_us);
+
   private:
-    CGamecubeConsole *_gamecube;
+    CGamecubeConsole _gamecube;
     Gamecube_Data_t _data;
     int _delay;
 };
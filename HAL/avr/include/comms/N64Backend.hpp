@@ -14,11 +14,12 @@ class N64Backend : public CommunicationBackend {
         int polling_rate,
         int data_pin
     );
-    ~N64Backend();
     void SendReport();
 
+    bool CanStall(uint32_t duration_us);
+
   private:
-    CN64Console *_n64;
+    CN64Console _n64;
     N64_Data_t _data;
     int _delay;
 };
@@ -2,9 +2,7 @@
 #define _INPUT_NUNCHUKINPUT_HPP
 
 #include "core/InputSource.hpp"
-
-#include <ArduinoNunchuk.hpp>
-#include <Wire.h>
+#include "stdlib.hpp"
 
 class NunchukInput : public InputSource {
   public:
@@ -14,7 +12,17 @@ class NunchukInput : public InputSource {
     void UpdateInputs(InputState &inputs);
 
   protected:
-    ArduinoNunchuk *_nunchuk;
+    bool _connected = false;
+    bool _has_sample = false;
+    uint32_t _transfer_started = 0;
+    uint32_t _conversion_requested = 0;
+
+    uint8_t _stick_x = 0;
+    uint8_t _stick_y = 0;
+    bool _button_c = false;
+    bool _button_z = false;
+
+    void StartTransfer();
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -10,6 +10,8 @@ namespace serial {
     void write(uint8_t byte);
     void write(uint8_t *bytes, size_t len);
     int available_for_write();
+    int available();
+    int read();
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,21 @@
+#ifndef _STORAGE_HPP
+#define _STORAGE_HPP
+
+#include "stdlib.hpp"
+
+// EEPROM, split in half for the two banks.
+#define STORAGE_BANK_SIZE ((E2END + 1) / 2)
+// Longest that a write stalls everything for, which is about 3.4ms for each of the bytes in a
+// KeyValueStore record.
+#define STORAGE_WRITE_TIME_US 14000
+// Same for erasing len bytes, as each one is written separately.
+#define STORAGE_ERASE_TIME_US(len) ((len) * 3400UL)
+
+namespace storage {
+    uint8_t read(uint8_t bank, size_t offset);
+    void write(uint8_t bank, size_t offset, const uint8_t *data, size_t len);
+    // Sets at least the first len bytes of the bank back to 0xFF.
+    void erase(uint8_t bank, size_t len);
+}
+
+#endif
\ No newline at end of file
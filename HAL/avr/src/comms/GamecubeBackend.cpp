@@ -11,9 +11,9 @@ GamecubeBackend::GamecubeBackend(
     int polling_rate,
     int data_pin
 )
-    : CommunicationBackend(input_sources, input_source_count) {
-    _gamecube = new CGamecubeConsole(data_pin);
+    : CommunicationBackend(input_sources, input_source_count), _gamecube(data_pin) {
     _data = defaultGamecubeData;
+    _frame_clock.SetFramePeriod(FRAME_PERIOD_NTSC_US);
 
     if (polling_rate > 0) {
         // Delay used between input updates to postpone them until right before the
@@ -25,10 +25,6 @@ GamecubeBackend::GamecubeBackend(
     }
 }
 
-GamecubeBackend::~GamecubeBackend() {
-    delete _gamecube;
-}
-
 void GamecubeBackend::SendReport() {
     // Update inputs from all sources at once.
     ScanInputs();
@@ -58,8 +54,14 @@ void GamecubeBackend::SendReport() {
     _data.report.left = _outputs.triggerLAnalog + 31;
     _data.report.right = _outputs.triggerRAnalog + 31;
 
-    // Send outputs to console.
-    _gamecube->write(_data);
+    // Send outputs to console. This waits for the console to poll, so it also tells us when it did.
+    _gamecube.write(_data);
+    _frame_clock.Poll(micros());
+
+    SampleInputs(_delay);
+}
 
-    delayMicroseconds(_delay);
+bool GamecubeBackend::CanStall(uint32_t duration_us) {
+    // Saving even one EEPROM record takes longer than the gap between two polls.
+    return false;
 }
@@ -8,9 +8,9 @@ N64Backend::N64Backend(
     int polling_rate,
     int data_pin
 )
-    : CommunicationBackend(input_sources, input_source_count) {
-    _n64 = new CN64Console(data_pin);
+    : CommunicationBackend(input_sources, input_source_count), _n64(data_pin) {
     _data = defaultN64Data;
+    _frame_clock.SetFramePeriod(FRAME_PERIOD_NTSC_US);
 
     if (polling_rate > 0) {
         // Delay used between input updates to postpone them until right before the
@@ -22,10 +22,6 @@ N64Backend::N64Backend(
     }
 }
 
-N64Backend::~N64Backend() {
-    delete _n64;
-}
-
 void N64Backend::SendReport() {
     // Update inputs from all sources at once.
     ScanInputs();
@@ -54,8 +50,14 @@ void N64Backend::SendReport() {
     _data.report.xAxis = _outputs.leftStickX - 128;
     _data.report.yAxis = _outputs.leftStickY - 128;
 
-    // Send outputs to console.
-    _n64->write(_data);
+    // Send outputs to console. This waits for the console to poll, so it also tells us when it did.
+    _n64.write(_data);
+    _frame_clock.Poll(micros());
+
+    SampleInputs(_delay);
+}
 
-    delayMicroseconds(_delay);
+bool N64Backend::CanStall(uint32_t duration_us) {
+    // Saving even one EEPROM record takes longer than the gap between two polls.
+    return false;
 }
@@ -2,8 +2,119 @@
 
 #include "gpio.hpp"
 
-#include <ArduinoNunchuk.hpp>
-#include <Wire.h>
+#include <avr/interrupt.h>
+#include <util/twi.h>
+
+#define NUNCHUK_ADDRESS 0x52
+#define NUNCHUK_REPORT_LEN 6
+#define NUNCHUK_I2C_FREQ 100000
+#define NUNCHUK_I2C_TIMEOUT_US 2000
+#define NUNCHUK_TRANSFER_TIMEOUT_US 10000
+// Time the Nunchuk needs after a conversion request before the report can be read.
+#define NUNCHUK_CONVERSION_DELAY_US 200
+
+enum class TransferState : uint8_t {
+    IDLE,
+    READING,
+    WRITING,
+    DONE,
+    CONVERTING,
+    ERROR,
+};
+
+// Shared with the TWI interrupt handler.
+static volatile TransferState transfer_state = TransferState::IDLE;
+static volatile uint8_t rx_index = 0;
+static volatile uint8_t rx_buffer[NUNCHUK_REPORT_LEN];
+
+static inline void twi_continue(uint8_t flags = 0) {
+    TWCR = _BV(TWINT) | _BV(TWEN) | _BV(TWIE) | flags;
+}
+
+static inline void twi_stop() {
+    TWCR = _BV(TWINT) | _BV(TWEN) | _BV(TWSTO);
+}
+
+/*
+ * Each transfer reads the report that was converted on the previous request, then writes 0x00 to
+ * request the next conversion so it is ready by the time we come back. The whole transaction is
+ * driven from here so the main loop never has to wait on the bus.
+ */
+ISR(TWI_vect) {
+    switch (TW_STATUS) {
+        case TW_START:
+        case TW_REP_START:
+            if (transfer_state == TransferState::READING) {
+                TWDR = (NUNCHUK_ADDRESS << 1) | TW_READ;
+            } else {
+                TWDR = (NUNCHUK_ADDRESS << 1) | TW_WRITE;
+            }
+            twi_continue();
+            break;
+        case TW_MR_SLA_ACK:
+            rx_index = 0;
+            twi_continue(_BV(TWEA));
+            break;
+        case TW_MR_DATA_ACK:
+            rx_buffer[rx_index++] = TWDR;
+            // NACK the last byte to tell the Nunchuk we're done reading.
+            twi_continue(rx_index < NUNCHUK_REPORT_LEN - 1 ? _BV(TWEA) : 0);
+            break;
+        case TW_MR_DATA_NACK:
+            rx_buffer[rx_index++] = TWDR;
+            // Stop and then start again for the conversion request.
+            transfer_state = TransferState::WRITING;
+            twi_continue(_BV(TWSTO) | _BV(TWSTA));
+            break;
+        case TW_MT_SLA_ACK:
+            TWDR = 0x00;
+            twi_continue();
+            break;
+        case TW_MT_DATA_ACK:
+            twi_stop();
+            transfer_state = TransferState::DONE;
+            break;
+        default:
+            // NACK from the Nunchuk (e.g. unplugged), arbitration lost, or bus error.
+            twi_stop();
+            transfer_state = TransferState::ERROR;
+            break;
+    }
+}
+
+static bool twi_wait() {
+    uint32_t start = micros();
+    while (!(TWCR & _BV(TWINT))) {
+        if (micros() - start > NUNCHUK_I2C_TIMEOUT_US) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Polled write used only during initialisation, before the interrupt handler takes over.
+static bool twi_write_blocking(const uint8_t *bytes, uint8_t len) {
+    bool ok = false;
+
+    TWCR = _BV(TWINT) | _BV(TWSTA) | _BV(TWEN);
+    if (!twi_wait() || TW_STATUS != TW_START) {
+        twi_stop();
+        return false;
+    }
+
+    TWDR = (NUNCHUK_ADDRESS << 1) | TW_WRITE;
+    TWCR = _BV(TWINT) | _BV(TWEN);
+    ok = twi_wait() && TW_STATUS == TW_MT_SLA_ACK;
+
+    for (uint8_t i = 0; ok && i < len; i++) {
+        TWDR = bytes[i];
+        TWCR = _BV(TWINT) | _BV(TWEN);
+        ok = twi_wait() && TW_STATUS == TW_MT_DATA_ACK;
+    }
+
+    twi_stop();
+    return ok;
+}
 
 NunchukInput::NunchukInput(int detect_pin) {
     delay(50);
@@ -11,24 +122,47 @@ NunchukInput::NunchukInput(int detect_pin) {
     if (detect_pin > -1) {
         gpio::init_pin(detect_pin, gpio::GpioMode::GPIO_INPUT_PULLUP);
         if (gpio::read_digital(detect_pin)) {
-            _nunchuk = nullptr;
             return;
         }
     }
 
-    _nunchuk = new ArduinoNunchuk(Wire);
+    gpio::init_pin(SDA, gpio::GpioMode::GPIO_INPUT_PULLUP);
+    gpio::init_pin(SCL, gpio::GpioMode::GPIO_INPUT_PULLUP);
+    TWSR = 0;
+    TWBR = ((F_CPU / NUNCHUK_I2C_FREQ) - 16) / 2;
+    TWCR = _BV(TWEN);
 
-    if (!_nunchuk->init() || !_nunchuk->update()) {
+    // Initialise the Nunchuk in unencrypted mode and request the first conversion. This is the only
+    // part that blocks, and it only happens once on boot.
+    const uint8_t disable_encryption_1[] = { 0xF0, 0x55 };
+    const uint8_t disable_encryption_2[] = { 0xFB, 0x00 };
+    const uint8_t conversion_request[] = { 0x00 };
+    bool connected = twi_write_blocking(disable_encryption_1, sizeof(disable_encryption_1));
+    delayMicroseconds(1000);
+    connected = connected &&
+                twi_write_blocking(disable_encryption_2, sizeof(disable_encryption_2));
+    delayMicroseconds(1000);
+    connected = connected && twi_write_blocking(conversion_request, sizeof(conversion_request));
+
+    if (!connected) {
         // If a Nunchuk isn't connected we don't want i2c to stay enabled because it might interfere
-        // with inputs if i2c pins are also used for buttons. The destructor of ArduinoNunchuk
-        // ends the i2c communication.
-        delete _nunchuk;
-        _nunchuk = nullptr;
+        // with inputs if i2c pins are also used for buttons.
+        TWCR = 0;
+        gpio::init_pin(SDA, gpio::GpioMode::GPIO_INPUT);
+        gpio::init_pin(SCL, gpio::GpioMode::GPIO_INPUT);
+        return;
     }
+
+    _connected = true;
+    delayMicroseconds(1000);
+    StartTransfer();
 }
 
 NunchukInput::~NunchukInput() {
-    delete _nunchuk;
+    if (_connected) {
+        TWCR = 0;
+        transfer_state = TransferState::IDLE;
+    }
 }
 
 InputScanSpeed NunchukInput::ScanSpeed() {
@@ -36,11 +170,54 @@ InputScanSpeed NunchukInput::ScanSpeed() {
 }
 
 void NunchukInput::UpdateInputs(InputState &inputs) {
-    if (_nunchuk != nullptr && _nunchuk->update()) {
+    if (!_connected) {
+        return;
+    }
+
+    // The interrupt handler never touches the buffer once it has finished, so no need to mask
+    // interrupts while copying out of it.
+    switch (transfer_state) {
+        case TransferState::DONE:
+            _stick_x = rx_buffer[0];
+            _stick_y = rx_buffer[1];
+            _button_z = !(rx_buffer[5] & 0x01);
+            _button_c = !(rx_buffer[5] & 0x02);
+            _has_sample = true;
+            // Give the Nunchuk time to convert the next report before reading it. This is timed
+            // from when we first see the transfer done, which can only be later than when it was.
+            _conversion_requested = micros();
+            transfer_state = TransferState::CONVERTING;
+            break;
+        case TransferState::CONVERTING:
+            if (micros() - _conversion_requested >= NUNCHUK_CONVERSION_DELAY_US) {
+                StartTransfer();
+            }
+            break;
+        case TransferState::ERROR:
+            // Keep the last good sample and try again next time.
+            StartTransfer();
+            break;
+        default:
+            if (micros() - _transfer_started > NUNCHUK_TRANSFER_TIMEOUT_US) {
+                // Bus got stuck somehow, so reset the TWI peripheral and start over.
+                TWCR = 0;
+                TWCR = _BV(TWEN);
+                StartTransfer();
+            }
+            break;
+    }
+
+    if (_has_sample) {
         inputs.nunchuk_connected = true;
-        inputs.nunchuk_x = _nunchuk->stickX();
-        inputs.nunchuk_y = _nunchuk->stickY();
-        inputs.nunchuk_c = _nunchuk->buttonC();
-        inputs.nunchuk_z = _nunchuk->buttonZ();
+        inputs.nunchuk_x = _stick_x;
+        inputs.nunchuk_y = _stick_y;
+        inputs.nunchuk_c = _button_c;
+        inputs.nunchuk_z = _button_z;
     }
 }
+
+void NunchukInput::StartTransfer() {
+    _transfer_started = micros();
+    transfer_state = TransferState::READING;
+    twi_continue(_BV(TWSTA));
+}
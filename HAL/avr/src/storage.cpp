@@ -0,0 +1,26 @@
+#include "storage.hpp"
+
+#include "stdlib.hpp"
+
+#include <avr/eeprom.h>
+
+namespace storage {
+    static uint8_t *address(uint8_t bank, size_t offset) {
+        return (uint8_t *)(bank * STORAGE_BANK_SIZE + offset);
+    }
+
+    uint8_t read(uint8_t bank, size_t offset) {
+        return eeprom_read_byte(address(bank, offset));
+    }
+
+    void write(uint8_t bank, size_t offset, const uint8_t *data, size_t len) {
+        eeprom_update_block(data, address(bank, offset), len);
+    }
+
+    void erase(uint8_t bank, size_t len) {
+        // EEPROM has no erase as such, and bytes that are already 0xFF don't need writing.
+        for (size_t i = 0; i < len && i < STORAGE_BANK_SIZE; i++) {
+            eeprom_update_byte(address(bank, i), 0xFF);
+        }
+    }
+}
\ No newline at end of file
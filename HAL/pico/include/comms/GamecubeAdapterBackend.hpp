@@ -0,0 +1,37 @@
+#ifndef _COMMS_GAMECUBEADAPTERBACKEND_HPP
+#define _COMMS_GAMECUBEADAPTERBACKEND_HPP
+
+#include "comms/gc_adapter.hpp"
+#include "core/CommunicationBackend.hpp"
+#include "core/InputSource.hpp"
+#include "stdlib.hpp"
+
+#include <Adafruit_TinyUSB.h>
+
+// USB interface of the adapter, with an interrupt IN endpoint for reports and an interrupt OUT
+// endpoint for commands.
+class GamecubeAdapterInterface : public Adafruit_USBD_Interface {
+  public:
+    bool begin();
+    uint16_t getInterfaceDescriptor(uint8_t itfnum, uint8_t *buf, uint16_t bufsize);
+};
+
+/*
+ * Shows up as an official GameCube controller adapter (WUP-028) with the controller in port 1, so
+ * that Dolphin gets the outputs as native GameCube values without any scaling. Reports are sent
+ * every 1ms rather than the real adapter's 8ms.
+ */
+class GamecubeAdapterBackend : public CommunicationBackend {
+  public:
+    GamecubeAdapterBackend(InputSource **input_sources, size_t input_source_count);
+    void SendReport();
+
+    // Whether the host has asked the controller to rumble.
+    bool Rumble();
+
+  private:
+    GamecubeAdapterInterface _interface;
+    uint8_t _report[GC_ADAPTER_REPORT_SIZE];
+};
+
+#endif
@@ -16,13 +16,28 @@ class GamecubeBackend : public CommunicationBackend {
         int sm = -1,
         int offset = -1
     );
-    ~GamecubeBackend();
     void SendReport();
     int GetOffset();
 
+    // Console poll timing, learned from the start time of each poll. Times are in microseconds
+    // as returned by time_us_32().
+    bool PollPhaseLocked();
+    uint32_t PollPeriodUs();
+    uint32_t NextPollStart();
+    uint32_t LastReportTime();
+
+    bool CanStall(uint32_t duration_us);
+
   private:
-    GamecubeConsole *_gamecube;
+    GamecubeConsole _gamecube;
     gc_report_t _report;
+
+    volatile uint32_t _last_poll_start = 0;
+    volatile uint32_t _poll_period_x16 = 0;
+    volatile uint8_t _consistent_polls = 0;
+    volatile uint32_t _last_report_time = 0;
+
+    void TrackPollTiming(uint32_t poll_start);
 };
 
 #endif
@@ -16,12 +16,13 @@ class N64Backend : public CommunicationBackend {
         int sm = -1,
         int offset = -1
     );
-    ~N64Backend();
     void SendReport();
     int GetOffset();
 
+    bool CanStall(uint32_t duration_us);
+
   private:
-    N64Console *_n64;
+    N64Console _n64;
     n64_report_t _report;
 };
 
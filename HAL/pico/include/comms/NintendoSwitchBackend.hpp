@@ -44,13 +44,14 @@ class NintendoSwitchBackend : public CommunicationBackend {
     NintendoSwitchBackend(InputSource **input_sources, size_t input_source_count);
     ~NintendoSwitchBackend();
 
+    static const uint8_t descriptor[];
+
     static void RegisterDescriptor();
 
     void SendReport();
 
   protected:
     static const uint8_t _report_id = 0;
-    static uint8_t _descriptor[];
 
     switch_gamepad_report_t _report;
 
@@ -0,0 +1,40 @@
+#ifndef _COMMS_SWITCHPROBACKEND_HPP
+#define _COMMS_SWITCHPROBACKEND_HPP
+
+#include "comms/switch_pro.hpp"
+#include "core/CommunicationBackend.hpp"
+#include "core/InputSource.hpp"
+#include "stdlib.hpp"
+
+#include <Adafruit_TinyUSB.h>
+
+/*
+ * Shows up as a Nintendo Switch Pro Controller, going through the same handshake with the Switch
+ * as a real one (see comms/switch_pro.hpp). Unlike NintendoSwitchBackend, the sticks are sent with
+ * 12 bits of precision.
+ *
+ * This uses its own HID interface rather than TUCompositeHID, so it can't be combined with other
+ * HID backends.
+ */
+class SwitchProBackend : public CommunicationBackend {
+  public:
+    SwitchProBackend(InputSource **input_sources, size_t input_source_count);
+    void SendReport();
+
+  private:
+    static const uint8_t _descriptor[];
+    // Static because the HID report callback doesn't get told which backend it's for.
+    static switch_pro::Protocol _protocol;
+
+    Adafruit_USBD_HID _usb_hid;
+    uint8_t _report[SWITCH_PRO_REPORT_SIZE];
+
+    static void SetReport(
+        uint8_t report_id,
+        hid_report_type_t report_type,
+        uint8_t const *buffer,
+        uint16_t bufsize
+    );
+};
+
+#endif
@@ -17,7 +17,7 @@ class KeyboardMode : public InputMode {
     void Press(uint8_t keycode, bool press);
 
   private:
-    TUKeyboard *_keyboard;
+    TUKeyboard _keyboard;
 
     virtual void UpdateKeys(InputState &inputs) = 0;
 };
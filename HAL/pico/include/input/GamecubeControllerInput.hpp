@@ -1,6 +1,7 @@
 #ifndef _INPUT_GAMECUBECONTROLLERINPUT_HPP
 #define _INPUT_GAMECUBECONTROLLERINPUT_HPP
 
+#include "comms/GamecubeBackend.hpp"
 #include "core/InputSource.hpp"
 #include "core/state.hpp"
 
@@ -16,14 +17,37 @@ class GamecubeControllerInput : public InputSource {
         int sm = -1,
         int offset = -1
     );
-    ~GamecubeControllerInput();
     InputScanSpeed ScanSpeed();
     void UpdateInputs(InputState &inputs);
     int GetOffset();
 
+    // Schedule controller reads from the backend's learned console poll phase, so that each read
+    // finishes margin_us before the console's next poll. The polling_rate passed to the
+    // constructor should be well above the console's poll rate when using this, so that the
+    // library doesn't hold back reads that we've already timed ourselves.
+    // Opt-in only: without this, reads happen whenever UpdateInputs() is called, as before.
+    void SyncToBackend(GamecubeBackend *backend, uint32_t margin_us = 20);
+
+    // Time from the controller responding to the stick data being sent to the console. Only
+    // measured when synced to a backend.
+    uint32_t StickDataAge();
+    uint32_t MaxStickDataAge();
+
   protected:
-    GamecubeController *_controller;
+    GamecubeController _controller;
     gc_report_t _report;
+
+    GamecubeBackend *_backend = nullptr;
+    uint32_t _margin_us = 0;
+    uint32_t _read_duration_us = 400;
+    uint32_t _sample_time = 0;
+    uint32_t _last_measured_report = 0;
+    bool _has_sample = false;
+    uint32_t _stick_data_age = 0;
+    uint32_t _max_stick_data_age = 0;
+
+    void WaitForReadSlot();
+    void UpdateStickDataAge();
 };
 
-#endif
\ No newline at end of file
+#endif
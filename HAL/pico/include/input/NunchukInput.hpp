@@ -2,19 +2,31 @@
 #define _INPUT_NUNCHUKINPUT_HPP
 
 #include "core/InputSource.hpp"
+#include "stdlib.hpp"
 
-#include <ArduinoNunchuk.hpp>
-#include <Wire.h>
+#include <hardware/i2c.h>
 
 class NunchukInput : public InputSource {
   public:
-    NunchukInput(TwoWire &wire = Wire, int detect_pin = -1, int sda_pin = 4, int scl_pin = 5);
+    NunchukInput(i2c_inst_t *i2c = i2c0, int detect_pin = -1, int sda_pin = 4, int scl_pin = 5);
     ~NunchukInput();
     InputScanSpeed ScanSpeed();
     void UpdateInputs(InputState &inputs);
 
   protected:
-    ArduinoNunchuk *_nunchuk;
+    i2c_inst_t *_i2c = nullptr;
+    bool _transfer_pending = false;
+    bool _has_sample = false;
+    bool _converting = false;
+    uint32_t _conversion_requested = 0;
+
+    uint8_t _stick_x = 0;
+    uint8_t _stick_y = 0;
+    bool _button_c = false;
+    bool _button_z = false;
+
+    void StartTransfer();
+    bool PollTransfer();
 };
 
 #endif
\ No newline at end of file
@@ -10,6 +10,24 @@ enum class ConnectedConsole {
     NONE,
 };
 
+typedef struct {
+    ConnectedConsole console;
+    // Whether the console was remembered from before a warm reboot instead of being detected.
+    bool remembered;
+    // Microseconds since boot when we first replied to the console, or 0 if we never did.
+    uint32_t first_reply_us;
+    // Microseconds since boot when detection finished.
+    uint32_t finished_us;
+} ConsoleDetection;
+
+/*
+ * Watches the Joybus line once for whichever console command comes first, replying to probes so
+ * that the console carries on to the commands that tell GameCube and N64 apart. The result is kept
+ * in the watchdog scratch registers, so after a warm reboot it is reused without detecting again.
+ */
 ConnectedConsole detect_console(uint joybus_pin);
 
-#endif
+// How the last call to detect_console() went.
+const ConsoleDetection &last_console_detection();
+
+#endif
\ No newline at end of file
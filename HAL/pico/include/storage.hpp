@@ -0,0 +1,39 @@
+#ifndef _STORAGE_HPP
+#define _STORAGE_HPP
+
+#include "stdlib.hpp"
+
+#include <hardware/flash.h>
+
+// The last two sectors of flash, one for each bank. This is where the Arduino EEPROM library keeps
+// its data too, so the two can't be used together.
+#define STORAGE_BANK_SIZE FLASH_SECTOR_SIZE
+// Longest that a write stalls everything for, going by the flash chip's maximum page program time.
+#define STORAGE_WRITE_TIME_US 3000
+// Same for erasing, which always erases the whole sector.
+#define STORAGE_ERASE_TIME_US(len) 400000
+
+// The sector before the banks holds a profile (see core/Profile.hpp), which
+// builder_scripts/profile_tool.py packs into a UF2 file that writes only to this sector.
+#define PROFILE_REGION_SIZE FLASH_SECTOR_SIZE
+// Longest that replacing the profile stalls everything for: erasing the sector, then programming
+// every page of it.
+#define PROFILE_WRITE_TIME_US \
+    (STORAGE_ERASE_TIME_US(PROFILE_REGION_SIZE) + \
+     PROFILE_REGION_SIZE / FLASH_PAGE_SIZE * STORAGE_WRITE_TIME_US)
+
+namespace storage {
+    // Reads straight from flash through XIP, without copying anything into RAM.
+    uint8_t read(uint8_t bank, size_t offset);
+    // Can only clear bits, so anything written to has to have been erased first.
+    void write(uint8_t bank, size_t offset, const uint8_t *data, size_t len);
+    // Sets at least the first len bytes of the bank back to 0xFF. Takes tens of milliseconds.
+    void erase(uint8_t bank, size_t len);
+
+    // Where the profile is, if one has been flashed, for reading in place through XIP.
+    const uint8_t *profile_region();
+    // Replaces the profile. Takes up to PROFILE_WRITE_TIME_US.
+    void write_profile(const uint8_t *data, size_t len);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,219 @@
+#include "comms/GamecubeAdapterBackend.hpp"
+
+#include "comms/gc_adapter.hpp"
+#include "core/CommunicationBackend.hpp"
+#include "core/state.hpp"
+
+#include <Adafruit_TinyUSB.h>
+#include <device/usbd_pvt.h>
+
+// Maximum number of class drivers registered by other libraries that we pass through alongside our
+// own.
+#define MAX_APP_DRIVERS 4
+
+// The only port that the controller shows up in.
+#define GC_ADAPTER_PORT 0
+
+/* USB class driver */
+
+static uint8_t ep_in = 0;
+static uint8_t ep_out = 0;
+static uint8_t command[GC_ADAPTER_RUMBLE_SIZE];
+static volatile bool initialised = false;
+static volatile bool rumble = false;
+
+static void driver_init() {}
+
+static void driver_reset(uint8_t rhport) {
+    ep_in = 0;
+    ep_out = 0;
+    initialised = false;
+    rumble = false;
+}
+
+static uint16_t driver_open(
+    uint8_t rhport,
+    tusb_desc_interface_t const *itf_desc,
+    uint16_t max_len
+) {
+    // The XInput interface is vendor specific as well, but has its own subclass.
+    TU_VERIFY(itf_desc->bInterfaceClass == TUSB_CLASS_VENDOR_SPECIFIC, 0);
+    TU_VERIFY(itf_desc->bInterfaceSubClass == 0 && itf_desc->bInterfaceProtocol == 0, 0);
+
+    uint16_t len = sizeof(tusb_desc_interface_t) +
+                   itf_desc->bNumEndpoints * sizeof(tusb_desc_endpoint_t);
+    TU_VERIFY(max_len >= len, 0);
+
+    uint8_t const *p_desc = tu_desc_next(itf_desc);
+    for (uint8_t i = 0; i < itf_desc->bNumEndpoints; i++) {
+        tusb_desc_endpoint_t const *ep_desc = (tusb_desc_endpoint_t const *)p_desc;
+        TU_ASSERT(usbd_edpt_open(rhport, ep_desc), 0);
+        if (tu_edpt_dir(ep_desc->bEndpointAddress) == TUSB_DIR_IN) {
+            ep_in = ep_desc->bEndpointAddress;
+        } else {
+            ep_out = ep_desc->bEndpointAddress;
+        }
+        p_desc = tu_desc_next(p_desc);
+    }
+
+    TU_ASSERT(usbd_edpt_xfer(rhport, ep_out, command, sizeof(command)), 0);
+    return len;
+}
+
+static bool driver_control_xfer_cb(
+    uint8_t rhport,
+    uint8_t stage,
+    tusb_control_request_t const *request
+) {
+    // Dolphin sends a HID SET_PROTOCOL request on start, which some third party adapters need.
+    if (request->bmRequestType_bit.type != TUSB_REQ_TYPE_CLASS || request->bRequest != 0x0B) {
+        return false;
+    }
+    if (stage == CONTROL_STAGE_SETUP) {
+        return tud_control_status(rhport, request);
+    }
+    return true;
+}
+
+static bool driver_xfer_cb(
+    uint8_t rhport,
+    uint8_t ep_addr,
+    xfer_result_t result,
+    uint32_t xferred_bytes
+) {
+    if (ep_addr == ep_out) {
+        if (xferred_bytes > 0 && command[0] == gc_adapter::INIT) {
+            initialised = true;
+        }
+        bool port_rumble;
+        if (gc_adapter::decode_rumble(command, xferred_bytes, GC_ADAPTER_PORT, port_rumble)) {
+            rumble = port_rumble;
+        }
+        TU_ASSERT(usbd_edpt_xfer(rhport, ep_out, command, sizeof(command)));
+    }
+    return true;
+}
+
+static usbd_class_driver_t create_driver() {
+    usbd_class_driver_t driver = {};
+    driver.init = driver_init;
+    driver.reset = driver_reset;
+    driver.open = driver_open;
+    driver.control_xfer_cb = driver_control_xfer_cb;
+    driver.xfer_cb = driver_xfer_cb;
+    return driver;
+}
+
+/*
+ * TinyUSB only asks for extra class drivers through usbd_app_driver_get_cb(), which the XInput
+ * library already defines. It is wrapped at link time (see -Wl,--wrap in platformio.ini) so that
+ * our driver can be added to whichever ones the libraries register.
+ */
+extern "C" {
+    usbd_class_driver_t const *__real_usbd_app_driver_get_cb(uint8_t *driver_count)
+        __attribute__((weak));
+
+    usbd_class_driver_t const *__wrap_usbd_app_driver_get_cb(uint8_t *driver_count) {
+        static usbd_class_driver_t drivers[MAX_APP_DRIVERS + 1];
+        uint8_t count = 0;
+
+        if (__real_usbd_app_driver_get_cb != nullptr) {
+            uint8_t other_count = 0;
+            usbd_class_driver_t const *others = __real_usbd_app_driver_get_cb(&other_count);
+            for (; count < other_count && count < MAX_APP_DRIVERS; count++) {
+                drivers[count] = others[count];
+            }
+        }
+        drivers[count++] = create_driver();
+
+        *driver_count = count;
+        return drivers;
+    }
+}
+
+/* Interface */
+
+bool GamecubeAdapterInterface::begin() {
+    return TinyUSBDevice.addInterface(*this);
+}
+
+uint16_t GamecubeAdapterInterface::getInterfaceDescriptor(
+    uint8_t itfnum,
+    uint8_t *buf,
+    uint16_t bufsize
+) {
+    // USB core will automatically update endpoint numbers.
+    // clang-format off
+    uint8_t const desc[] = {
+        // Interface
+        9, TUSB_DESC_INTERFACE, itfnum, 0, 2, TUSB_CLASS_VENDOR_SPECIFIC, 0x00, 0x00, 0,
+        // Endpoint in
+        7, TUSB_DESC_ENDPOINT, 0x80, TUSB_XFER_INTERRUPT,
+        U16_TO_U8S_LE(GC_ADAPTER_REPORT_SIZE), 1,
+        // Endpoint out
+        7, TUSB_DESC_ENDPOINT, 0x00, TUSB_XFER_INTERRUPT,
+        U16_TO_U8S_LE(GC_ADAPTER_RUMBLE_SIZE), 1,
+    };
+    // clang-format on
+    uint16_t const len = sizeof(desc);
+
+    if (bufsize < len) {
+        return 0;
+    }
+    memcpy(buf, desc, len);
+    return len;
+}
+
+/* Backend */
+
+GamecubeAdapterBackend::GamecubeAdapterBackend(
+    InputSource **input_sources,
+    size_t input_source_count
+)
+    : CommunicationBackend(input_sources, input_source_count) {
+    // Dolphin claims interface 0 but takes the last endpoints it finds on the device, so the
+    // adapter has to be the only interface. Ending the serial port takes its interface out of the
+    // configuration, and nothing else adds one, so the adapter ends up as interface 0. This means
+    // the configuration protocol isn't available with this backend.
+    Serial.end();
+    USBDevice.setManufacturerDescriptor("Nintendo");
+    USBDevice.setProductDescriptor("WUP-028");
+    USBDevice.setID(GC_ADAPTER_VID, GC_ADAPTER_PID);
+    _interface.begin();
+
+    gc_adapter::encode_report(OutputState(), GC_ADAPTER_PORT, _report);
+}
+
+void GamecubeAdapterBackend::SendReport() {
+    ScanInputs(InputScanSpeed::SLOW);
+    ScanInputs(InputScanSpeed::MEDIUM);
+
+    // Dolphin also has to have initialised the adapter before it reads any reports.
+    if (SkipUnlessReady(tud_ready() && initialised)) {
+        return;
+    }
+
+    // Wait until the host has read the last report, which it does every 1ms.
+    while (tud_ready() && usbd_edpt_busy(0, ep_in)) {
+        tight_loop_contents();
+    }
+
+    ScanInputs(InputScanSpeed::FAST);
+
+    UpdateOutputs();
+
+    gc_adapter::encode_report(_outputs, GC_ADAPTER_PORT, _report);
+
+    if (!usbd_edpt_claim(0, ep_in)) {
+        return;
+    }
+    if (!usbd_edpt_xfer(0, ep_in, _report, sizeof(_report))) {
+        usbd_edpt_release(0, ep_in);
+        return;
+    }
+    ReportSent();
+}
+
+bool GamecubeAdapterBackend::Rumble() {
+    return rumble;
+}
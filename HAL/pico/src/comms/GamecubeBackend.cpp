@@ -6,6 +6,11 @@
 #include <hardware/pio.h>
 #include <hardware/timer.h>
 
+// Number of consecutive consistent poll intervals before we trust the learned poll phase.
+static constexpr uint8_t poll_lock_threshold = 8;
+// Time to leave for scanning inputs before the next poll after stalling.
+static constexpr uint32_t stall_margin_us = 500;
+
 GamecubeBackend::GamecubeBackend(
     InputSource **input_sources,
     size_t input_source_count,
@@ -14,13 +19,10 @@ GamecubeBackend::GamecubeBackend(
     int sm,
     int offset
 )
-    : CommunicationBackend(input_sources, input_source_count) {
-    _gamecube = new GamecubeConsole(data_pin, pio, sm, offset);
+    : CommunicationBackend(input_sources, input_source_count),
+      _gamecube(data_pin, pio, sm, offset) {
     _report = default_gc_report;
-}
-
-GamecubeBackend::~GamecubeBackend() {
-    delete _gamecube;
+    _frame_clock.SetFramePeriod(FRAME_PERIOD_NTSC_US);
 }
 
 void GamecubeBackend::SendReport() {
@@ -29,7 +31,10 @@ void GamecubeBackend::SendReport() {
     ScanInputs(InputScanSpeed::MEDIUM);
 
     // Read inputs
-    _gamecube->WaitForPollStart();
+    _gamecube.WaitForPollStart();
+    uint32_t poll_start = time_us_32();
+    TrackPollTiming(poll_start);
+    _frame_clock.Poll(poll_start);
 
     // Update fast inputs in response to poll.
     // But wait 40us first so that we read inputs at the start of the 3rd byte of the poll command
@@ -63,11 +68,69 @@ void GamecubeBackend::SendReport() {
     _report.r_analog = _outputs.triggerRAnalog;
 
     // Send outputs to console unless poll command is invalid.
-    if (_gamecube->WaitForPollEnd() != PollStatus::ERROR) {
-        _gamecube->SendReport(&_report);
+    if (_gamecube.WaitForPollEnd() != PollStatus::ERROR) {
+        _last_report_time = time_us_32();
+        _gamecube.SendReport(&_report);
+        ReportSent();
     }
 }
 
 int GamecubeBackend::GetOffset() {
-    return _gamecube->GetOffset();
+    return _gamecube.GetOffset();
+}
+
+void GamecubeBackend::TrackPollTiming(uint32_t poll_start) {
+    uint32_t interval_x16 = (poll_start - _last_poll_start) << 4;
+    _last_poll_start = poll_start;
+
+    // An interval that is way off from what we've seen so far (e.g. console paused polling, or a
+    // game switched polling rate) means our phase estimate is no longer any good, so start over.
+    uint32_t tolerance = _poll_period_x16 / 4;
+    if (_poll_period_x16 == 0 || interval_x16 > _poll_period_x16 + tolerance ||
+        interval_x16 < _poll_period_x16 - tolerance) {
+        _poll_period_x16 = interval_x16;
+        _consistent_polls = 0;
+        return;
+    }
+
+    // Exponential moving average smooths out jitter in when we notice the poll starting.
+    _poll_period_x16 = _poll_period_x16 - (_poll_period_x16 >> 3) + (interval_x16 >> 3);
+    if (_consistent_polls < poll_lock_threshold) {
+        _consistent_polls++;
+    }
+}
+
+bool GamecubeBackend::PollPhaseLocked() {
+    return _consistent_polls >= poll_lock_threshold;
+}
+
+uint32_t GamecubeBackend::PollPeriodUs() {
+    return _poll_period_x16 >> 4;
+}
+
+uint32_t GamecubeBackend::NextPollStart() {
+    uint32_t period = PollPeriodUs();
+    uint32_t next_poll = _last_poll_start + period;
+    if (period == 0) {
+        return next_poll;
+    }
+
+    // If we've missed polls since the last one we saw, project forwards to the next upcoming one.
+    uint32_t now = time_us_32();
+    while ((int32_t)(next_poll - now) < 0) {
+        next_poll += period;
+    }
+    return next_poll;
+}
+
+uint32_t GamecubeBackend::LastReportTime() {
+    return _last_report_time;
+}
+
+bool GamecubeBackend::CanStall(uint32_t duration_us) {
+    // Without a locked poll phase we have no idea when the next poll is coming.
+    if (!PollPhaseLocked()) {
+        return false;
+    }
+    return (int32_t)(NextPollStart() - time_us_32()) > (int32_t)(duration_us + stall_margin_us);
 }
@@ -13,13 +13,9 @@ N64Backend::N64Backend(
     int sm,
     int offset
 )
-    : CommunicationBackend(input_sources, input_source_count) {
-    _n64 = new N64Console(data_pin, pio, sm, offset);
+    : CommunicationBackend(input_sources, input_source_count), _n64(data_pin, pio, sm, offset) {
     _report = default_n64_report;
-}
-
-N64Backend::~N64Backend() {
-    delete _n64;
+    _frame_clock.SetFramePeriod(FRAME_PERIOD_NTSC_US);
 }
 
 void N64Backend::SendReport() {
@@ -28,7 +24,8 @@ void N64Backend::SendReport() {
     ScanInputs(InputScanSpeed::MEDIUM);
 
     // Read inputs
-    _n64->WaitForPoll();
+    _n64.WaitForPoll();
+    _frame_clock.Poll(time_us_32());
 
     // Update fast inputs in response to poll.
     ScanInputs(InputScanSpeed::FAST);
@@ -58,9 +55,15 @@ void N64Backend::SendReport() {
     _report.stick_y = _outputs.leftStickY - 128;
 
     // Send outputs to console.
-    _n64->SendReport(&_report);
+    _n64.SendReport(&_report);
+    ReportSent();
 }
 
 int N64Backend::GetOffset() {
-    return _n64->GetOffset();
+    return _n64.GetOffset();
+}
+
+bool N64Backend::CanStall(uint32_t duration_us) {
+    // We don't keep track of when the console polls, so never risk missing one.
+    return false;
 }
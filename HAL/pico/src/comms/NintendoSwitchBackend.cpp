@@ -57,7 +57,7 @@
 
 // clang-format on
 
-uint8_t NintendoSwitchBackend::_descriptor[] = { HID_REPORT_DESC() };
+constexpr uint8_t NintendoSwitchBackend::descriptor[] = { HID_REPORT_DESC() };
 
 NintendoSwitchBackend::NintendoSwitchBackend(InputSource **input_sources, size_t input_source_count)
     : CommunicationBackend(input_sources, input_source_count) {
@@ -96,7 +96,7 @@ NintendoSwitchBackend::NintendoSwitchBackend(InputSource **input_sources, size_t
 NintendoSwitchBackend::~NintendoSwitchBackend() {}
 
 void NintendoSwitchBackend::RegisterDescriptor() {
-    TUCompositeHID::addDescriptor(_descriptor, sizeof(_descriptor));
+    TUCompositeHID::registerDescriptors<NintendoSwitchBackend>();
 }
 
 void NintendoSwitchBackend::SendReport() {
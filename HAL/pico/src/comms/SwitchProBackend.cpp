@@ -0,0 +1,176 @@
+#include "comms/SwitchProBackend.hpp"
+
+#include "comms/switch_pro.hpp"
+#include "core/CommunicationBackend.hpp"
+#include "core/state.hpp"
+
+#include <Adafruit_TinyUSB.h>
+
+// The Pro Controller is polled every 8ms.
+#define SWITCH_PRO_POLL_INTERVAL_MS 8
+
+// clang-format off
+
+// HID report descriptor of a real Pro Controller. The Switch only really cares about the report
+// IDs and sizes, as the contents of each report are vendor specific.
+const uint8_t SwitchProBackend::_descriptor[] = {
+    0x05, 0x01,                    // Usage Page (Generic Desktop)
+    0x15, 0x00,                    // Logical Minimum (0)
+    0x09, 0x04,                    // Usage (Joystick)
+    0xA1, 0x01,                    // Collection (Application)
+    0x85, 0x30,                    //   Report ID (0x30)
+    0x05, 0x01,                    //   Usage Page (Generic Desktop)
+    0x05, 0x09,                    //   Usage Page (Button)
+    0x19, 0x01,                    //   Usage Minimum (1)
+    0x29, 0x0A,                    //   Usage Maximum (10)
+    0x15, 0x00,                    //   Logical Minimum (0)
+    0x25, 0x01,                    //   Logical Maximum (1)
+    0x75, 0x01,                    //   Report Size (1)
+    0x95, 0x0A,                    //   Report Count (10)
+    0x55, 0x00,                    //   Unit Exponent (0)
+    0x65, 0x00,                    //   Unit (None)
+    0x81, 0x02,                    //   Input (Data, Variable, Absolute)
+    0x05, 0x09,                    //   Usage Page (Button)
+    0x19, 0x0B,                    //   Usage Minimum (11)
+    0x29, 0x0E,                    //   Usage Maximum (14)
+    0x15, 0x00,                    //   Logical Minimum (0)
+    0x25, 0x01,                    //   Logical Maximum (1)
+    0x75, 0x01,                    //   Report Size (1)
+    0x95, 0x04,                    //   Report Count (4)
+    0x81, 0x02,                    //   Input (Data, Variable, Absolute)
+    0x75, 0x01,                    //   Report Size (1)
+    0x95, 0x02,                    //   Report Count (2)
+    0x81, 0x03,                    //   Input (Constant, Variable, Absolute)
+    0x0B, 0x01, 0x00, 0x01, 0x00,  //   Usage (Pointer)
+    0xA1, 0x00,                    //   Collection (Physical)
+    0x0B, 0x30, 0x00, 0x01, 0x00,  //     Usage (X)
+    0x0B, 0x31, 0x00, 0x01, 0x00,  //     Usage (Y)
+    0x0B, 0x32, 0x00, 0x01, 0x00,  //     Usage (Z)
+    0x0B, 0x35, 0x00, 0x01, 0x00,  //     Usage (Rz)
+    0x15, 0x00,                    //     Logical Minimum (0)
+    0x27, 0xFF, 0xFF, 0x00, 0x00,  //     Logical Maximum (65535)
+    0x75, 0x10,                    //     Report Size (16)
+    0x95, 0x04,                    //     Report Count (4)
+    0x81, 0x02,                    //     Input (Data, Variable, Absolute)
+    0xC0,                          //   End Collection
+    0x0B, 0x39, 0x00, 0x01, 0x00,  //   Usage (Hat Switch)
+    0x15, 0x00,                    //   Logical Minimum (0)
+    0x25, 0x07,                    //   Logical Maximum (7)
+    0x35, 0x00,                    //   Physical Minimum (0)
+    0x46, 0x3B, 0x01,              //   Physical Maximum (315)
+    0x65, 0x14,                    //   Unit (Degrees)
+    0x75, 0x04,                    //   Report Size (4)
+    0x95, 0x01,                    //   Report Count (1)
+    0x81, 0x02,                    //   Input (Data, Variable, Absolute)
+    0x05, 0x09,                    //   Usage Page (Button)
+    0x19, 0x0F,                    //   Usage Minimum (15)
+    0x29, 0x12,                    //   Usage Maximum (18)
+    0x15, 0x00,                    //   Logical Minimum (0)
+    0x25, 0x01,                    //   Logical Maximum (1)
+    0x75, 0x01,                    //   Report Size (1)
+    0x95, 0x04,                    //   Report Count (4)
+    0x81, 0x02,                    //   Input (Data, Variable, Absolute)
+    0x75, 0x08,                    //   Report Size (8)
+    0x95, 0x34,                    //   Report Count (52)
+    0x81, 0x03,                    //   Input (Constant, Variable, Absolute)
+    0x06, 0x00, 0xFF,              //   Usage Page (Vendor Defined)
+    0x85, 0x21,                    //   Report ID (0x21)
+    0x09, 0x01,                    //   Usage (1)
+    0x75, 0x08,                    //   Report Size (8)
+    0x95, 0x3F,                    //   Report Count (63)
+    0x81, 0x03,                    //   Input (Constant, Variable, Absolute)
+    0x85, 0x81,                    //   Report ID (0x81)
+    0x09, 0x02,                    //   Usage (2)
+    0x75, 0x08,                    //   Report Size (8)
+    0x95, 0x3F,                    //   Report Count (63)
+    0x81, 0x03,                    //   Input (Constant, Variable, Absolute)
+    0x85, 0x01,                    //   Report ID (0x01)
+    0x09, 0x03,                    //   Usage (3)
+    0x75, 0x08,                    //   Report Size (8)
+    0x95, 0x3F,                    //   Report Count (63)
+    0x91, 0x83,                    //   Output (Constant, Variable, Absolute, Volatile)
+    0x85, 0x10,                    //   Report ID (0x10)
+    0x09, 0x04,                    //   Usage (4)
+    0x75, 0x08,                    //   Report Size (8)
+    0x95, 0x3F,                    //   Report Count (63)
+    0x91, 0x83,                    //   Output (Constant, Variable, Absolute, Volatile)
+    0x85, 0x80,                    //   Report ID (0x80)
+    0x09, 0x05,                    //   Usage (5)
+    0x75, 0x08,                    //   Report Size (8)
+    0x95, 0x3F,                    //   Report Count (63)
+    0x91, 0x83,                    //   Output (Constant, Variable, Absolute, Volatile)
+    0x85, 0x82,                    //   Report ID (0x82)
+    0x09, 0x06,                    //   Usage (6)
+    0x75, 0x08,                    //   Report Size (8)
+    0x95, 0x3F,                    //   Report Count (63)
+    0x91, 0x83,                    //   Output (Constant, Variable, Absolute, Volatile)
+    0xC0,                          // End Collection
+};
+
+// clang-format on
+
+switch_pro::Protocol SwitchProBackend::_protocol;
+
+SwitchProBackend::SwitchProBackend(InputSource **input_sources, size_t input_source_count)
+    : CommunicationBackend(input_sources, input_source_count),
+      _usb_hid(
+          _descriptor,
+          sizeof(_descriptor),
+          HID_ITF_PROTOCOL_NONE,
+          SWITCH_PRO_POLL_INTERVAL_MS,
+          true
+      ) {
+    USBDevice.setManufacturerDescriptor("Nintendo Co., Ltd.");
+    USBDevice.setProductDescriptor("Pro Controller");
+    USBDevice.setID(SWITCH_PRO_VID, SWITCH_PRO_PID);
+
+    // The HID interface has to come before the serial one.
+    Serial.end();
+    _usb_hid.setReportCallback(nullptr, SetReport);
+    _usb_hid.begin();
+    Serial.begin(115200);
+}
+
+void SwitchProBackend::SendReport() {
+    ScanInputs(InputScanSpeed::SLOW);
+    ScanInputs(InputScanSpeed::MEDIUM);
+
+    if (SkipUnlessReady(TinyUSBDevice.mounted())) {
+        return;
+    }
+
+    while (!_usb_hid.ready()) {
+        tight_loop_contents();
+    }
+
+    ScanInputs(InputScanSpeed::FAST);
+
+    UpdateOutputs();
+
+    // Nothing gets sent until the Switch has started the handshake.
+    size_t len = _protocol.NextInputReport(_outputs, _report);
+    if (len > 0) {
+        _usb_hid.sendReport(_report[0], _report + 1, len - 1);
+        ReportSent();
+    }
+}
+
+void SwitchProBackend::SetReport(
+    uint8_t report_id,
+    hid_report_type_t report_type,
+    uint8_t const *buffer,
+    uint16_t bufsize
+) {
+    // Reports that come in on the OUT endpoint start with their report ID, but for ones sent as a
+    // SET_REPORT request it's passed separately.
+    if (report_id == 0) {
+        _protocol.HandleOutputReport(buffer, bufsize);
+        return;
+    }
+
+    uint8_t report[SWITCH_PRO_REPORT_SIZE];
+    size_t len = bufsize < sizeof(report) - 1 ? bufsize : sizeof(report) - 1;
+    report[0] = report_id;
+    memcpy(report + 1, buffer, len);
+    _protocol.HandleOutputReport(report, len + 1);
+}
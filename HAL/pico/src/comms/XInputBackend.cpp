@@ -8,26 +8,21 @@
 XInputBackend::XInputBackend(InputSource **input_sources, size_t input_source_count)
     : CommunicationBackend(input_sources, input_source_count) {
     Serial.end();
-    _xinput = new Adafruit_USBD_XInput();
-    _xinput->begin();
+    _xinput.begin();
     Serial.begin(115200);
 
     TinyUSBDevice.setID(0x0738, 0x4726);
-
-    while (!_xinput->ready()) {
-        delay(1);
-    }
-}
-
-XInputBackend::~XInputBackend() {
-    delete _xinput;
 }
 
 void XInputBackend::SendReport() {
     ScanInputs(InputScanSpeed::SLOW);
     ScanInputs(InputScanSpeed::MEDIUM);
 
-    while (!_xinput->ready()) {
+    if (SkipUnlessReady(TinyUSBDevice.mounted())) {
+        return;
+    }
+
+    while (!_xinput.ready()) {
         tight_loop_contents();
     }
 
@@ -62,6 +57,7 @@ void XInputBackend::SendReport() {
     _report.rx = ((_outputs.rightStickX - 128) * 65535 / 255) * 1.266 + 128 + 0.49;
     _report.ry = ((_outputs.rightStickY - 128) * 65535 / 255) * 1.256 + 128 + 1.48;
 
-    _xinput->sendReport(&_report);
+    _xinput.sendReport(&_report);
+    ReportSent();
 }
 
@@ -5,22 +5,20 @@
 #include <TUKeyboard.hpp>
 
 KeyboardMode::KeyboardMode() {
-    _keyboard = new TUKeyboard();
-    _keyboard->begin();
+    _keyboard.begin();
 }
 
 KeyboardMode::~KeyboardMode() {
-    _keyboard->releaseAll();
-    _keyboard->sendState();
-    delete _keyboard;
+    _keyboard.releaseAll();
+    _keyboard.sendState();
 }
 
 void KeyboardMode::SendReport(InputState &inputs) {
     HandleSocd(inputs);
     UpdateKeys(inputs);
-    _keyboard->sendState();
+    _keyboard.sendState();
 }
 
 void KeyboardMode::Press(uint8_t keycode, bool press) {
-    _keyboard->setPressed(keycode, press);
+    _keyboard.setPressed(keycode, press);
 }
\ No newline at end of file
@@ -1,8 +1,10 @@
 #include "input/GamecubeControllerInput.hpp"
 
+#include "comms/GamecubeBackend.hpp"
 #include "core/InputSource.hpp"
 
 #include <GamecubeController.hpp>
+#include <hardware/timer.h>
 
 GamecubeControllerInput::GamecubeControllerInput(
     uint pin,
@@ -10,21 +12,35 @@ GamecubeControllerInput::GamecubeControllerInput(
     PIO pio,
     int sm,
     int offset
-) {
-    _controller = new GamecubeController(pin, polling_rate, pio, sm, offset);
-}
-
-GamecubeControllerInput::~GamecubeControllerInput() {
-    delete _controller;
-}
+)
+    : _controller(pin, polling_rate, pio, sm, offset) {}
 
 InputScanSpeed GamecubeControllerInput::ScanSpeed() {
     return InputScanSpeed::SLOW;
 }
 
 void GamecubeControllerInput::UpdateInputs(InputState &inputs) {
+    if (_backend != nullptr) {
+        UpdateStickDataAge();
+        WaitForReadSlot();
+    }
+
+    uint32_t read_start = time_us_32();
+
     // Only update inputs if poll response is received.
-    if (_controller->Poll(&_report, false)) {
+    if (_controller.Poll(&_report, false)) {
+        _sample_time = time_us_32();
+        _has_sample = true;
+
+        // Track roughly the worst case read duration so we don't cut it fine when scheduling: jump
+        // straight up to longer reads, but only slowly come back down.
+        uint32_t read_duration = _sample_time - read_start;
+        if (read_duration > _read_duration_us) {
+            _read_duration_us = read_duration;
+        } else {
+            _read_duration_us -= (_read_duration_us - read_duration) / 16;
+        }
+
         inputs.nunchuk_connected = true;
         inputs.nunchuk_x = _report.stick_x;
         inputs.nunchuk_y = _report.stick_y;
@@ -33,5 +49,56 @@ void GamecubeControllerInput::UpdateInputs(InputState &inputs) {
 }
 
 int GamecubeControllerInput::GetOffset() {
-    return _controller->GetOffset();
+    return _controller.GetOffset();
+}
+
+void GamecubeControllerInput::SyncToBackend(GamecubeBackend *backend, uint32_t margin_us) {
+    _backend = backend;
+    _margin_us = margin_us;
+}
+
+uint32_t GamecubeControllerInput::StickDataAge() {
+    return _stick_data_age;
+}
+
+uint32_t GamecubeControllerInput::MaxStickDataAge() {
+    return _max_stick_data_age;
+}
+
+void GamecubeControllerInput::WaitForReadSlot() {
+    // Until the backend has a stable poll phase, just read straight away like in unsynced mode.
+    if (!_backend->PollPhaseLocked()) {
+        return;
+    }
+
+    uint32_t period = _backend->PollPeriodUs();
+    uint32_t lead_time = _read_duration_us + _margin_us;
+    if (lead_time >= period) {
+        return;
+    }
+
+    // The controller is on its own state machine, so the console can start polling us while the
+    // read is still in progress without either transfer getting corrupted. What we can't do is
+    // still be blocked on the read when our reply is due, so if we've missed the window for the
+    // upcoming poll then aim for the one after.
+    uint32_t now = time_us_32();
+    uint32_t read_at = _backend->NextPollStart() - lead_time;
+    if ((int32_t)(read_at - now) < 0) {
+        read_at += period;
+    }
+    busy_wait_us_32(read_at - now);
+}
+
+void GamecubeControllerInput::UpdateStickDataAge() {
+    uint32_t report_time = _backend->LastReportTime();
+    if (!_has_sample || report_time == _last_measured_report ||
+        (int32_t)(report_time - _sample_time) < 0) {
+        return;
+    }
+    _last_measured_report = report_time;
+
+    _stick_data_age = report_time - _sample_time;
+    if (_stick_data_age > _max_stick_data_age) {
+        _max_stick_data_age = _stick_data_age;
+    }
 }
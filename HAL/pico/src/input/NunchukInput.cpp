@@ -2,40 +2,70 @@
 
 #include "gpio.hpp"
 
-#include <Wire.h>
+#include <hardware/gpio.h>
+#include <hardware/i2c.h>
 
-NunchukInput::NunchukInput(TwoWire &wire, int detect_pin, int sda_pin, int scl_pin) {
+#define NUNCHUK_ADDRESS 0x52
+#define NUNCHUK_REPORT_LEN 6
+#define NUNCHUK_I2C_TIMEOUT_US 2000
+// Time the Nunchuk needs after a conversion request before the report can be read.
+#define NUNCHUK_CONVERSION_DELAY_US 200
+
+static bool write_bytes(i2c_inst_t *i2c, const uint8_t *bytes, size_t len) {
+    int written =
+        i2c_write_timeout_us(i2c, NUNCHUK_ADDRESS, bytes, len, false, NUNCHUK_I2C_TIMEOUT_US);
+    return written == (int)len;
+}
+
+NunchukInput::NunchukInput(i2c_inst_t *i2c, int detect_pin, int sda_pin, int scl_pin) {
     delay(50);
 
     if (sda_pin < 0 || scl_pin < 0) {
-        _nunchuk = nullptr;
         return;
     }
 
     if (detect_pin > -1) {
         gpio::init_pin(detect_pin, gpio::GpioMode::GPIO_INPUT_PULLUP);
         if (gpio::read_digital(detect_pin)) {
-            _nunchuk = nullptr;
             return;
         }
     }
 
-    wire.setSDA(sda_pin);
-    wire.setSCL(scl_pin);
+    i2c_init(i2c, 100 * 1000);
+    gpio_set_function(sda_pin, GPIO_FUNC_I2C);
+    gpio_set_function(scl_pin, GPIO_FUNC_I2C);
+    gpio_pull_up(sda_pin);
+    gpio_pull_up(scl_pin);
 
-    _nunchuk = new ArduinoNunchuk(wire);
+    // Initialise the Nunchuk in unencrypted mode and request the first conversion. This is the only
+    // part that blocks, and it only happens once on boot.
+    const uint8_t disable_encryption_1[] = { 0xF0, 0x55 };
+    const uint8_t disable_encryption_2[] = { 0xFB, 0x00 };
+    const uint8_t conversion_request[] = { 0x00 };
+    bool connected = write_bytes(i2c, disable_encryption_1, sizeof(disable_encryption_1));
+    busy_wait_us(1000);
+    connected = connected && write_bytes(i2c, disable_encryption_2, sizeof(disable_encryption_2));
+    busy_wait_us(1000);
+    connected = connected && write_bytes(i2c, conversion_request, sizeof(conversion_request));
 
-    if (!_nunchuk->init() || !_nunchuk->update()) {
+    if (!connected) {
         // If a Nunchuk isn't connected we don't want i2c to stay enabled because it might interfere
-        // with inputs if i2c pins are also used for buttons. The destructor of ArduinoNunchuk
-        // ends the i2c communication.
-        delete _nunchuk;
-        _nunchuk = nullptr;
+        // with inputs if i2c pins are also used for buttons.
+        i2c_deinit(i2c);
+        gpio_init(sda_pin);
+        gpio_init(scl_pin);
+        return;
     }
+
+    _i2c = i2c;
+    busy_wait_us(1000);
+    StartTransfer();
 }
 
 NunchukInput::~NunchukInput() {
-    delete _nunchuk;
+    if (_i2c != nullptr) {
+        i2c_deinit(_i2c);
+    }
 }
 
 InputScanSpeed NunchukInput::ScanSpeed() {
@@ -43,11 +73,74 @@ InputScanSpeed NunchukInput::ScanSpeed() {
 }
 
 void NunchukInput::UpdateInputs(InputState &inputs) {
-    if (_nunchuk != nullptr && _nunchuk->update()) {
+    if (_i2c == nullptr) {
+        return;
+    }
+
+    // Collect the previous transfer if the hardware has finished it, and queue up the next one
+    // once the Nunchuk has had time to convert it. This is timed from when we first see the
+    // conversion request finished, which can only be later than when it really did.
+    if (PollTransfer()) {
+        if (!_converting) {
+            _converting = true;
+            _conversion_requested = micros();
+        }
+        if (micros() - _conversion_requested >= NUNCHUK_CONVERSION_DELAY_US) {
+            StartTransfer();
+        }
+    }
+
+    if (_has_sample) {
         inputs.nunchuk_connected = true;
-        inputs.nunchuk_x = _nunchuk->stickX();
-        inputs.nunchuk_y = _nunchuk->stickY();
-        inputs.nunchuk_c = _nunchuk->buttonC();
-        inputs.nunchuk_z = _nunchuk->buttonZ();
+        inputs.nunchuk_x = _stick_x;
+        inputs.nunchuk_y = _stick_y;
+        inputs.nunchuk_c = _button_c;
+        inputs.nunchuk_z = _button_z;
     }
 }
+
+void NunchukInput::StartTransfer() {
+    i2c_hw_t *hw = i2c_get_hw(_i2c);
+
+    // The whole transaction fits in the TX FIFO, so the controller can carry it out without any
+    // further involvement from us: read the report that was converted on the previous request, then
+    // write 0x00 to request the next conversion so it is ready by the time we come back.
+    for (int i = 0; i < NUNCHUK_REPORT_LEN; i++) {
+        hw->data_cmd =
+            I2C_IC_DATA_CMD_CMD_BITS | (i == NUNCHUK_REPORT_LEN - 1 ? I2C_IC_DATA_CMD_STOP_BITS : 0);
+    }
+    hw->data_cmd = 0x00 | I2C_IC_DATA_CMD_STOP_BITS;
+
+    _transfer_pending = true;
+    _converting = false;
+}
+
+bool NunchukInput::PollTransfer() {
+    i2c_hw_t *hw = i2c_get_hw(_i2c);
+
+    // A NACK (e.g. Nunchuk unplugged) aborts the transfer and flushes the TX FIFO. Discard anything
+    // that was received and try again next time; the last good sample is kept in the meantime.
+    if (hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS) {
+        (void)hw->clr_tx_abrt;
+        while (i2c_get_read_available(_i2c) > 0) {
+            (void)hw->data_cmd;
+        }
+        _transfer_pending = false;
+    }
+
+    if (_transfer_pending && i2c_get_read_available(_i2c) >= NUNCHUK_REPORT_LEN) {
+        uint8_t report[NUNCHUK_REPORT_LEN];
+        for (int i = 0; i < NUNCHUK_REPORT_LEN; i++) {
+            report[i] = (uint8_t)hw->data_cmd;
+        }
+        _stick_x = report[0];
+        _stick_y = report[1];
+        _button_z = !(report[5] & 0x01);
+        _button_c = !(report[5] & 0x02);
+        _has_sample = true;
+        _transfer_pending = false;
+    }
+
+    // Only start a new transfer once the trailing conversion request has gone out on the bus.
+    return !_transfer_pending && hw->txflr == 0 && !(hw->status & I2C_IC_STATUS_MST_ACTIVITY_BITS);
+}
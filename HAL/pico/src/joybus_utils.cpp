@@ -1,23 +1,127 @@
 #include "joybus_utils.hpp"
 
-#include <GamecubeConsole.hpp>
-#include <N64Console.hpp>
+#include <hardware/structs/watchdog.h>
+#include <hardware/timer.h>
+#include <hardware/watchdog.h>
+#include <joybus.hpp>
 
 #define VBUS_SENSE_PIN 24
 
-ConnectedConsole detect_console(uint joybus_pin) {
-    gpio_init(VBUS_SENSE_PIN);
-    gpio_set_dir(VBUS_SENSE_PIN, GPIO_IN);
-    bool vbus_powered = gpio_get(VBUS_SENSE_PIN);
+// How long to watch the line for before deciding that there's no console. Consoles probe for
+// controllers every frame or so, so this gives them a few chances.
+#define DETECT_TIMEOUT_US 50000
+
+// Time to wait for the stop bit at the end of a command before replying.
+#define REPLY_DELAY_US 4
+
+// Marks the watchdog scratch register that holds the detected console.
+#define SCRATCH_MAGIC 0x4A420000
+#define SCRATCH_MAGIC_MASK 0xFFFF0000
+
+enum JoybusCommand : uint8_t {
+    JOYBUS_PROBE = 0x00,
+    JOYBUS_N64_POLL = 0x01,
+    JOYBUS_GC_POLL = 0x40,
+    JOYBUS_GC_ORIGIN = 0x41,
+    JOYBUS_GC_RECALIBRATE = 0x42,
+    JOYBUS_RESET = 0xFF,
+};
+
+// Replies to a probe: device type followed by status.
+static uint8_t gc_status[] = { 0x09, 0x00, 0x03 };
+static uint8_t n64_status[] = { 0x05, 0x00, 0x02 };
+
+static ConsoleDetection detection = {};
+
+static bool load_console(ConnectedConsole &console) {
+    if (!watchdog_caused_reboot()) {
+        return false;
+    }
+    uint32_t saved = watchdog_hw->scratch[0];
+    if ((saved & SCRATCH_MAGIC_MASK) != SCRATCH_MAGIC || watchdog_hw->scratch[1] != ~saved) {
+        return false;
+    }
+    uint32_t value = saved & ~SCRATCH_MAGIC_MASK;
+    if (value > (uint32_t)ConnectedConsole::NONE) {
+        return false;
+    }
+    console = (ConnectedConsole)value;
+    return true;
+}
+
+static void save_console(ConnectedConsole console) {
+    uint32_t saved = SCRATCH_MAGIC | (uint32_t)console;
+    watchdog_hw->scratch[0] = saved;
+    watchdog_hw->scratch[1] = ~saved;
+}
+
+static ConnectedConsole watch_joybus(uint joybus_pin, bool vbus_powered) {
+    joybus_port_t port;
+    joybus_port_init(&port, joybus_pin, pio0, -1, -1);
+
+    ConnectedConsole console = ConnectedConsole::NONE;
+    // Without 5V it could be either console, so take turns replying as a GameCube controller and an
+    // N64 controller until one of them carries on. 5V means it can't be an N64.
+    bool reply_as_gc = true;
 
-    if (GamecubeConsole(joybus_pin).Detect()) {
-        return ConnectedConsole::GAMECUBE;
+    uint32_t start = time_us_32();
+    uint32_t elapsed;
+    while ((elapsed = time_us_32() - start) < DETECT_TIMEOUT_US) {
+        uint8_t command;
+        if (joybus_receive_bytes(&port, &command, 1, DETECT_TIMEOUT_US - elapsed, true) != 1) {
+            continue;
+        }
+
+        if (command == JOYBUS_GC_POLL || command == JOYBUS_GC_ORIGIN ||
+            command == JOYBUS_GC_RECALIBRATE) {
+            console = ConnectedConsole::GAMECUBE;
+            break;
+        }
+        if (command == JOYBUS_N64_POLL) {
+            console = ConnectedConsole::N64;
+            break;
+        }
+        if (command != JOYBUS_PROBE && command != JOYBUS_RESET) {
+            // Something we don't understand, so wait for it to finish and start over.
+            busy_wait_us(100);
+            joybus_port_reset(&port);
+            continue;
+        }
+
+        busy_wait_us(REPLY_DELAY_US);
+        if (reply_as_gc) {
+            joybus_send_bytes(&port, gc_status, sizeof(gc_status));
+        } else {
+            joybus_send_bytes(&port, n64_status, sizeof(n64_status));
+        }
+        if (detection.first_reply_us == 0) {
+            detection.first_reply_us = time_us_32();
+        }
+        reply_as_gc = vbus_powered || !reply_as_gc;
     }
 
-    // 5V is not connected when plugged into N64 so we check that first to save time.
-    if (!vbus_powered && N64Console(joybus_pin).Detect()) {
-        return ConnectedConsole::N64;
+    joybus_port_terminate(&port);
+    return console;
+}
+
+ConnectedConsole detect_console(uint joybus_pin) {
+    detection = {};
+
+    if (load_console(detection.console)) {
+        detection.remembered = true;
+    } else {
+        gpio_init(VBUS_SENSE_PIN);
+        gpio_set_dir(VBUS_SENSE_PIN, GPIO_IN);
+        bool vbus_powered = gpio_get(VBUS_SENSE_PIN);
+
+        detection.console = watch_joybus(joybus_pin, vbus_powered);
+        save_console(detection.console);
     }
 
-    return ConnectedConsole::NONE;
+    detection.finished_us = time_us_32();
+    return detection.console;
+}
+
+const ConsoleDetection &last_console_detection() {
+    return detection;
 }
@@ -28,4 +28,12 @@ namespace serial {
     int available_for_write() {
         return Serial.availableForWrite();
     }
+
+    int available() {
+        return Serial.available();
+    }
+
+    int read() {
+        return Serial.read();
+    }
 }
\ No newline at end of file
@@ -0,0 +1,70 @@
+#include "storage.hpp"
+
+#include "stdlib.hpp"
+
+#include <hardware/flash.h>
+
+#define STORAGE_FLASH_OFFSET (PICO_FLASH_SIZE_BYTES - 2 * STORAGE_BANK_SIZE)
+#define PROFILE_FLASH_OFFSET (STORAGE_FLASH_OFFSET - PROFILE_REGION_SIZE)
+
+namespace storage {
+    static uint32_t bank_offset(uint8_t bank) {
+        return STORAGE_FLASH_OFFSET + bank * STORAGE_BANK_SIZE;
+    }
+
+    uint8_t read(uint8_t bank, size_t offset) {
+        const uint8_t *data = (const uint8_t *)(XIP_BASE + bank_offset(bank));
+        return data[offset];
+    }
+
+    static void program(uint32_t flash_offset, size_t offset, const uint8_t *data, size_t len) {
+        // Flash is programmed a page at a time, so pad the data out with 0xFF, which leaves the
+        // rest of the page as it was.
+        uint8_t page[FLASH_PAGE_SIZE];
+        while (len > 0) {
+            size_t page_start = offset / FLASH_PAGE_SIZE * FLASH_PAGE_SIZE;
+            size_t page_offset = offset - page_start;
+            size_t chunk = min(len, FLASH_PAGE_SIZE - page_offset);
+            memset(page, 0xFF, sizeof(page));
+            memcpy(page + page_offset, data, chunk);
+
+            // Nothing can run from flash while it's being programmed, so that means no interrupts
+            // and keeping the other core out of the way.
+            noInterrupts();
+            rp2040.idleOtherCore();
+            flash_range_program(flash_offset + page_start, page, FLASH_PAGE_SIZE);
+            rp2040.resumeOtherCore();
+            interrupts();
+
+            offset += chunk;
+            data += chunk;
+            len -= chunk;
+        }
+    }
+
+    void write(uint8_t bank, size_t offset, const uint8_t *data, size_t len) {
+        program(bank_offset(bank), offset, data, len);
+    }
+
+    void erase(uint8_t bank, size_t len) {
+        noInterrupts();
+        rp2040.idleOtherCore();
+        flash_range_erase(bank_offset(bank), STORAGE_BANK_SIZE);
+        rp2040.resumeOtherCore();
+        interrupts();
+    }
+
+    const uint8_t *profile_region() {
+        return (const uint8_t *)(XIP_BASE + PROFILE_FLASH_OFFSET);
+    }
+
+    void write_profile(const uint8_t *data, size_t len) {
+        noInterrupts();
+        rp2040.idleOtherCore();
+        flash_range_erase(PROFILE_FLASH_OFFSET, PROFILE_REGION_SIZE);
+        rp2040.resumeOtherCore();
+        interrupts();
+
+        program(PROFILE_FLASH_OFFSET, 0, data, len);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,700 @@
+"""
+Configures a controller over USB serial while it's in use, with the protocol in
+src/core/ConfigProtocol.cpp and the commands in src/core/ConfigCommands.cpp (needs pyserial):
+
+    python builder_scripts/configurator.py info /dev/ttyACM0
+    python builder_scripts/configurator.py stats /dev/ttyACM0
+    python builder_scripts/configurator.py mode /dev/ttyACM0 ultimate
+    python builder_scripts/configurator.py read-profile /dev/ttyACM0 profile.bin
+    python builder_scripts/configurator.py write-profile /dev/ttyACM0 config/pico/profile.json
+    python builder_scripts/configurator.py dump /dev/ttyACM0 capture.bin
+
+Check the protocol against a stand-in for the controller on a pseudo-terminal:
+
+    python builder_scripts/configurator.py check
+
+The check builds a small program on the host, so it needs a C++ compiler ($CXX, or c++ by default)
+and a system with pseudo-terminals.
+"""
+
+import argparse
+import os
+import select
+import signal
+import struct
+import subprocess
+import sys
+import tempfile
+import time
+
+import host_build
+import profile_tool
+
+PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+PROTOCOL_VERSION = 1
+REQUEST_SYNC = 0xA5
+REPLY_SYNC = 0x5A
+MAX_PAYLOAD = 64
+REPLY_OVERHEAD = 5
+
+# Commands, as in config_protocol::Command.
+INFO = 0x01
+GET_STATS = 0x02
+SET_MODE = 0x03
+READ_PROFILE = 0x04
+WRITE_PROFILE = 0x05
+SAVE_PROFILE = 0x06
+DUMP_INPUTS = 0x07
+
+# Statuses, as in config_protocol::Status.
+OK = 0x00
+MORE = 0x01
+UNKNOWN_COMMAND = 0x02
+BAD_REQUEST = 0x03
+BAD_CHECKSUM = 0x04
+UNSUPPORTED = 0x05
+INVALID = 0x06
+STATUSES = [
+    "OK",
+    "MORE",
+    "UNKNOWN_COMMAND",
+    "BAD_REQUEST",
+    "BAD_CHECKSUM",
+    "UNSUPPORTED",
+    "INVALID",
+]
+
+STATS_CONSOLE_REMEMBERED = 1 << 0
+STATS_FRAME_CLOCK_LOCKED = 1 << 1
+STATS_PROFILE_SAVE_PENDING = 1 << 2
+STATS_PRESS_TIMES = 1 << 3
+
+CAPTURE_MAGIC = b"HBIR"
+CAPTURE_HEADER_SIZE = 12
+CAPTURE_RECORD_SIZE = 12
+
+# Largest profile that the controller takes over serial (CONFIG_PROFILE_BUFFER_SIZE).
+PROFILE_BUFFER_SIZE = 256
+
+
+class ProtocolError(Exception):
+    pass
+
+
+def crc8(data):
+    """CRC-8 with polynomial 0x07, the same as the firmware."""
+    crc = 0
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07 if crc & 0x80 else crc << 1) & 0xFF
+    return crc
+
+
+def status_name(status):
+    return STATUSES[status] if status < len(STATUSES) else "status %d" % status
+
+
+class FdPort:
+    """A file descriptor, e.g. a pseudo-terminal, that reads like a pyserial port does."""
+
+    def __init__(self, fd, timeout=0.1):
+        self._fd = fd
+        self._timeout = timeout
+
+    def read(self, size):
+        ready, _, _ = select.select([self._fd], [], [], self._timeout)
+        return os.read(self._fd, size) if ready else b""
+
+    def write(self, data):
+        while data:
+            data = data[os.write(self._fd, data) :]
+
+
+class Connection:
+    """
+    Sends requests and waits for their replies. Anything else coming from the controller, like
+    input viewer reports, is skipped over.
+    """
+
+    def __init__(self, port, timeout=2):
+        self._port = port
+        self._timeout = timeout
+        self._buffer = b""
+
+    def send(self, data):
+        self._port.write(data)
+
+    def request(self, command, payload=b""):
+        """Returns the final status and the payloads of every reply joined together."""
+        frame = bytes([command, len(payload)]) + payload
+        self.send(bytes([REQUEST_SYNC]) + frame + bytes([crc8(frame)]))
+
+        data = b""
+        while True:
+            status, reply = self.reply(command)
+            data += reply
+            if status != MORE:
+                return status, data
+
+    def reply(self, command):
+        deadline = time.monotonic() + self._timeout
+        while True:
+            start = self._buffer.find(bytes([REPLY_SYNC]))
+            self._buffer = self._buffer[start:] if start >= 0 else b""
+            if len(self._buffer) >= REPLY_OVERHEAD - 1:
+                length = self._buffer[3]
+                if self._buffer[1] != command or length > MAX_PAYLOAD:
+                    self._buffer = self._buffer[1:]
+                    continue
+                if len(self._buffer) >= REPLY_OVERHEAD + length:
+                    frame = self._buffer[: REPLY_OVERHEAD + length]
+                    if crc8(frame[1:-1]) != frame[-1]:
+                        self._buffer = self._buffer[1:]
+                        continue
+                    self._buffer = self._buffer[len(frame) :]
+                    return frame[2], frame[4:-1]
+            if time.monotonic() > deadline:
+                raise ProtocolError("No reply to command %d" % command)
+            self._buffer += self._port.read(256)
+
+    def command(self, command, payload=b""):
+        """Like request(), but anything other than OK is an error."""
+        status, data = self.request(command, payload)
+        if status != OK:
+            raise ProtocolError("Command %d failed: %s" % (command, status_name(status)))
+        return data
+
+
+def info(connection):
+    data = connection.command(INFO)
+    version, max_payload, longest_slice_us = struct.unpack("<BBH", data)
+    return {"version": version, "max_payload": max_payload, "longest_slice_us": longest_slice_us}
+
+
+def stats(connection):
+    data = connection.command(GET_STATS)
+    fields = struct.unpack("<IIIBIHH", data)
+    flags = fields[3]
+    return {
+        "time_to_first_report_us": fields[0],
+        "console_first_reply_us": fields[1],
+        "console_detection_us": fields[2],
+        "console_remembered": bool(flags & STATS_CONSOLE_REMEMBERED),
+        "frame_clock_locked": bool(flags & STATS_FRAME_CLOCK_LOCKED),
+        "profile_save_pending": bool(flags & STATS_PROFILE_SAVE_PENDING),
+        "press_times": bool(flags & STATS_PRESS_TIMES),
+        "frame_boundaries": fields[4],
+        "frame_average_error_us": fields[5],
+        "frame_max_error_us": fields[6],
+    }
+
+
+def set_mode(connection, mode):
+    connection.command(SET_MODE, struct.pack("<H", profile_tool.modes().index(mode)))
+
+
+def read_profile(connection):
+    """Returns the controller's profile, or None if it doesn't have one."""
+    header_size = profile_tool.PROFILE_HEADER_SIZE
+    header = connection.command(READ_PROFILE, struct.pack("<HB", 0, header_size))
+    if header[:4] != profile_tool.PROFILE_MAGIC:
+        return None
+    size = struct.unpack_from("<H", header, 8)[0]
+    data = header
+    while len(data) < size:
+        chunk = min(size - len(data), MAX_PAYLOAD)
+        data += connection.command(READ_PROFILE, struct.pack("<HB", len(data), chunk))
+    return data[:size]
+
+
+def send_profile(connection, data):
+    """Fills the controller's profile buffer, without saving it."""
+    chunk_size = MAX_PAYLOAD - 2
+    for offset in range(0, len(data), chunk_size):
+        chunk = data[offset : offset + chunk_size]
+        connection.command(WRITE_PROFILE, struct.pack("<H", offset) + chunk)
+
+
+def write_profile(connection, data):
+    """Sends a packed profile, which the controller saves once it has time and uses from then on."""
+    send_profile(connection, data)
+    connection.command(SAVE_PROFILE, struct.pack("<H", len(data)))
+
+
+def dump_inputs(connection):
+    """Returns the recorded inputs, in the capture format that replay.py reads."""
+    data = connection.command(DUMP_INPUTS)
+    if data[:4] != CAPTURE_MAGIC:
+        raise ProtocolError("Not an input capture")
+    count = struct.unpack_from("<I", data, 8)[0]
+    if len(data) != CAPTURE_HEADER_SIZE + count * CAPTURE_RECORD_SIZE:
+        raise ProtocolError("Input capture cut short")
+    return data
+
+
+def open_port(port):
+    import serial
+
+    return serial.Serial(port, 115200, timeout=0.1)
+
+
+# The serial port on a pseudo-terminal, with a count of the bytes read and written in each slice.
+HOST_SERIAL = """#ifndef _SERIAL_HPP
+#define _SERIAL_HPP
+
+#include "stdlib.hpp"
+
+namespace serial {
+    void init(unsigned long baudrate);
+    void close();
+    void print(const char *string);
+    void write(uint8_t byte);
+    void write(uint8_t *bytes, size_t len);
+    int available_for_write();
+    int available();
+    int read();
+}
+
+extern int serial_fd;
+extern size_t serial_bytes_read;
+extern size_t serial_bytes_written;
+
+#endif
+"""
+
+STAND_IN_SOURCE = r"""
+#include "core/CommunicationBackend.hpp"
+#include "core/ConfigCommands.hpp"
+#include "core/ConfigProtocol.hpp"
+#include "core/InputRecorder.hpp"
+#include "serial.hpp"
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#include <unistd.h>
+
+uint32_t host_time_us = 0;
+int serial_fd = -1;
+size_t serial_bytes_read = 0;
+size_t serial_bytes_written = 0;
+
+// Set from the check with signals: SIGUSR1 lets the backend stall, SIGUSR2 stops or starts the
+// port taking replies, like a configurator that has gone away, and SIGTERM stops the stand-in.
+static volatile sig_atomic_t can_stall = 0;
+static volatile sig_atomic_t port_blocked = 0;
+static volatile sig_atomic_t running = 1;
+
+// Modes have to be selected outside of ConfigProtocol::Service().
+static bool in_slice = false;
+
+namespace serial {
+    void init(unsigned long baudrate) {}
+
+    void close() {}
+
+    void print(const char *string) {
+        write((uint8_t *)string, strlen(string));
+    }
+
+    void write(uint8_t byte) {
+        write(&byte, 1);
+    }
+
+    void write(uint8_t *bytes, size_t len) {
+        serial_bytes_written += len;
+        while (len > 0) {
+            ssize_t written = ::write(serial_fd, bytes, len);
+            if (written > 0) {
+                bytes += written;
+                len -= written;
+            }
+        }
+    }
+
+    int available_for_write() {
+        return port_blocked ? 0 : 256;
+    }
+
+    int available() {
+        int count = 0;
+        ioctl(serial_fd, FIONREAD, &count);
+        return count;
+    }
+
+    int read() {
+        uint8_t byte;
+        if (::read(serial_fd, &byte, 1) != 1) {
+            return -1;
+        }
+        serial_bytes_read++;
+        return byte;
+    }
+}
+
+class StandInBackend : public CommunicationBackend {
+  public:
+    StandInBackend() : CommunicationBackend(nullptr, 0) {}
+
+    void SendReport() {}
+
+    bool CanStall(uint32_t duration_us) {
+        return can_stall;
+    }
+
+    bool Recording() {
+        return _input_recorder != nullptr;
+    }
+};
+
+static bool select_mode(CommunicationBackend *backend, uint16_t mode) {
+    if (mode >= 6) {
+        return false;
+    }
+    printf("mode %d%s\n", mode, in_slice ? " during a slice" : "");
+    return true;
+}
+
+static uint8_t profile_region[4096];
+
+static void write_profile(const uint8_t *data, size_t len) {
+    memset(profile_region, 0xFF, sizeof(profile_region));
+    memcpy(profile_region, data, len);
+    printf("profile written %zu\n", len);
+}
+
+// What the input viewer sends over the same port.
+static const char input_viewer_report[] = "0100100000001000000000001\n";
+
+int main(int argc, char **argv) {
+    serial_fd = atoi(argv[1]);
+    size_t record_count = atoi(argv[2]);
+    signal(SIGUSR1, [](int) { can_stall = 1; });
+    signal(SIGUSR2, [](int) { port_blocked = !port_blocked; });
+    signal(SIGTERM, [](int) { running = 0; });
+
+    // Made up inputs, which the check works out the same way.
+    static InputRecorder::Record records[64];
+    InputRecorder recorder(records);
+    for (size_t i = 0; i < record_count; i++) {
+        InputState inputs;
+        inputs.a = i & 1;
+        inputs.left = i & 2;
+        inputs.mod_x = i & 4;
+        inputs.nunchuk_connected = true;
+        inputs.nunchuk_x = i;
+        inputs.nunchuk_y = -(int)i;
+        recorder.Capture(inputs, 1000 * i);
+    }
+
+    memset(profile_region, 0xFF, sizeof(profile_region));
+
+    StandInBackend backend;
+    backend.SetInputRecorder(&recorder);
+    ConfigCommands commands(&backend, &recorder, select_mode, 6);
+    commands.SetProfileStorage(
+        profile_region,
+        sizeof(profile_region),
+        USABLE_PINS,
+        write_profile,
+        400000
+    );
+    commands.SetConsoleDetection(1234, 5678, true);
+    ConfigProtocol protocol(commands);
+
+    int status = 0;
+    bool was_blocked = false;
+    for (uint32_t slice = 0; running; slice++) {
+        if (was_blocked && !port_blocked) {
+            printf("unblocked, recording %s\n", backend.Recording() ? "on" : "off");
+        }
+        was_blocked = port_blocked;
+
+        if (slice % 5 == 0) {
+            serial::print(input_viewer_report);
+        }
+
+        // Like a report, each slice sees the time that it started at.
+        timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        host_time_us = (uint32_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+
+        serial_bytes_read = 0;
+        serial_bytes_written = 0;
+        in_slice = true;
+        protocol.Service();
+        in_slice = false;
+        commands.Update();
+        if (serial_bytes_read > CONFIG_RX_BYTES_PER_SLICE ||
+            serial_bytes_written > CONFIG_TX_BYTES_PER_SLICE) {
+            printf("slice read %zu and wrote %zu bytes\n", serial_bytes_read, serial_bytes_written);
+            status = 1;
+        }
+        fflush(stdout);
+        usleep(200);
+    }
+
+    printf("recording %s\n", backend.Recording() ? "on" : "off");
+    return status;
+}
+"""
+
+STAND_IN_CORE_SOURCES = [
+    "CommunicationBackend.cpp",
+    "ConfigCommands.cpp",
+    "ConfigProtocol.cpp",
+    "ControllerMode.cpp",
+    "FrameClock.cpp",
+    "InputMode.cpp",
+    "InputRecorder.cpp",
+    "InputSource.cpp",
+    "Profile.cpp",
+    "socd.cpp",
+]
+
+STAND_IN_RECORDS = 23
+
+
+def expected_capture(count):
+    """The capture that the stand-in's made up inputs should dump as."""
+    # Bit positions in pack_buttons() order: left is 0, a is 8, mod_x is 20.
+    data = CAPTURE_MAGIC + bytes([1, CAPTURE_RECORD_SIZE, 0, 0]) + struct.pack("<I", count)
+    for i in range(count):
+        buttons = (1 << 8 if i & 1 else 0) | (1 << 0 if i & 2 else 0) | (1 << 20 if i & 4 else 0)
+        buttons |= 1 << 22
+        data += struct.pack("<IIbbH", 1000 * i, buttons, i, -i, 1)
+    return data
+
+
+def build_stand_in(build_dir):
+    return host_build.build(
+        build_dir,
+        "stand_in",
+        {"serial.hpp": HOST_SERIAL, "stand_in.cpp": STAND_IN_SOURCE},
+        ["src/core/" + name for name in STAND_IN_CORE_SOURCES],
+        ["-D", "USABLE_PINS=%dUL" % profile_tool.usable_pins()],
+    )
+
+
+def check():
+    import pty
+    import tty
+
+    failures = []
+
+    def expect(ok, what):
+        if not ok:
+            failures.append(what)
+
+    with tempfile.TemporaryDirectory() as build_dir:
+        executable = build_stand_in(build_dir)
+
+        master, slave = pty.openpty()
+        tty.setraw(slave)
+        stand_in = subprocess.Popen(
+            [executable, str(slave), str(STAND_IN_RECORDS)],
+            pass_fds=[slave],
+            stdout=subprocess.PIPE,
+            text=True,
+        )
+        os.close(slave)
+        port = FdPort(master)
+        connection = Connection(port)
+
+        try:
+            result = info(connection)
+            expect(result["version"] == PROTOCOL_VERSION, "protocol version")
+            expect(result["max_payload"] == MAX_PAYLOAD, "max payload")
+
+            result = stats(connection)
+            expect(result["console_first_reply_us"] == 1234, "console first reply in stats")
+            expect(result["console_detection_us"] == 5678, "console detection in stats")
+            expect(result["console_remembered"], "remembered console in stats")
+            expect(not result["profile_save_pending"], "no profile save pending at first")
+            expect(not result["press_times"], "no press times in stats")
+
+            set_mode(connection, "ultimate")
+            status, _ = connection.request(SET_MODE, struct.pack("<H", 99))
+            expect(status == INVALID, "unknown mode")
+
+            expect(read_profile(connection) is None, "no profile at first")
+
+            # Saving has to wait until the backend can stall.
+            example = os.path.join(PROJECT_DIR, "config", "pico", "profile.json")
+            profile = profile_tool.pack(profile_tool.load(example))
+            write_profile(connection, profile)
+            expect(stats(connection)["profile_save_pending"], "profile save pending")
+            expect(read_profile(connection) is None, "profile written before the backend can stall")
+            status, _ = connection.request(WRITE_PROFILE, struct.pack("<H", 0) + b"x")
+            expect(status == INVALID, "profile changed while a save is pending")
+
+            stand_in.send_signal(signal.SIGUSR1)
+            deadline = time.monotonic() + 2
+            while stats(connection)["profile_save_pending"] and time.monotonic() < deadline:
+                pass
+            expect(read_profile(connection) == profile, "profile read back")
+
+            # A damaged profile is refused, and leaves the saved one alone.
+            damaged = profile[:20] + bytes([profile[20] ^ 1]) + profile[21:]
+            send_profile(connection, damaged)
+            status, _ = connection.request(SAVE_PROFILE, struct.pack("<H", len(damaged)))
+            expect(status == INVALID, "damaged profile")
+            status, _ = connection.request(SAVE_PROFILE, struct.pack("<H", 4096))
+            expect(status == INVALID, "oversized profile")
+            joybus_pin = profile_tool.pack({"buttons": {"a": 28}})
+            send_profile(connection, joybus_pin)
+            status, _ = connection.request(SAVE_PROFILE, struct.pack("<H", len(joybus_pin)))
+            expect(status == INVALID, "button on the Joybus pin")
+            timestamp = profile_tool.pack(
+                {"buttons": {"a": 1}, "socd_pairs": [["left", "right", "2ip_timestamp"]]}
+            )
+            send_profile(connection, timestamp)
+            status, _ = connection.request(SAVE_PROFILE, struct.pack("<H", len(timestamp)))
+            expect(status == INVALID, "2ip_timestamp without press times")
+            status, _ = connection.request(READ_PROFILE, struct.pack("<HB", 4090, 10))
+            expect(status == BAD_REQUEST, "read past the end")
+
+            expect(dump_inputs(connection) == expected_capture(STAND_IN_RECORDS), "dumped inputs")
+
+            # A dump whose replies stop going out is dropped after a while, and a new request drops
+            # one straight away. Either way recording carries on.
+            def send_request(command):
+                frame = bytes([command, 0])
+                connection.send(bytes([REQUEST_SYNC]) + frame + bytes([crc8(frame)]))
+
+            stand_in.send_signal(signal.SIGUSR2)
+            send_request(DUMP_INPUTS)
+            time.sleep(0.7)
+            stand_in.send_signal(signal.SIGUSR2)
+            info(connection)
+            stand_in.send_signal(signal.SIGUSR2)
+            send_request(DUMP_INPUTS)
+            time.sleep(0.05)
+            send_request(INFO)
+            time.sleep(0.05)
+            stand_in.send_signal(signal.SIGUSR2)
+            expect(connection.reply(INFO)[0] == OK, "request while a dump is stuck")
+
+            # Broken requests.
+            frame = bytes([INFO, 0])
+            connection.send(bytes([REQUEST_SYNC]) + frame + bytes([crc8(frame) ^ 1]))
+            expect(connection.reply(INFO)[0] == BAD_CHECKSUM, "bad checksum")
+            expect(connection.request(0x42)[0] == UNKNOWN_COMMAND, "unknown command")
+            connection.send(bytes([REQUEST_SYNC, GET_STATS, MAX_PAYLOAD + 1]))
+            expect(connection.reply(GET_STATS)[0] == BAD_REQUEST, "oversized request")
+
+            # A request cut short is dropped after a while, so the next one still gets through.
+            connection.send(bytes([REQUEST_SYNC, INFO]))
+            time.sleep(0.2)
+            info(connection)
+
+            # Requests sent back to back, faster than a slice reads them.
+            for _ in range(3):
+                frame = bytes([GET_STATS, 0])
+                connection.send(bytes([REQUEST_SYNC]) + frame + bytes([crc8(frame)]))
+            for _ in range(3):
+                expect(connection.reply(GET_STATS)[0] == OK, "back to back requests")
+        except ProtocolError as e:
+            failures.append(str(e))
+        finally:
+            stand_in.send_signal(signal.SIGTERM)
+            output, _ = stand_in.communicate(timeout=10)
+            os.close(master)
+
+    lines = output.splitlines()
+    expect(lines.count("mode 2") == 1 and "mode 99" not in lines, "modes selected")
+    expect(lines.count("profile written %d" % len(profile)) == 1, "profile written once")
+    expect("recording on" in lines, "recording resumed after the dump")
+    expect(lines.count("unblocked, recording on") == 2, "recording resumed after stuck dumps")
+    for line in lines:
+        if line.startswith("slice"):
+            failures.append(line)
+    expect(stand_in.returncode == 0, "stand-in exited cleanly")
+
+    for failure in failures:
+        print("FAILED: %s" % failure)
+    print("Configuration protocol: %s" % ("OK" if not failures else "FAILED"))
+    return 1 if failures else 0
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description="Configure a controller over USB serial.")
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    commands.add_parser("info", help="show the protocol version").add_argument("port")
+    commands.add_parser("stats", help="show startup and frame timing").add_argument("port")
+
+    mode_parser = commands.add_parser("mode", help="switch to another mode")
+    mode_parser.add_argument("port")
+    mode_parser.add_argument("mode", choices=profile_tool.modes())
+
+    read_parser = commands.add_parser("read-profile", help="save the controller's profile")
+    read_parser.add_argument("port")
+    read_parser.add_argument("output")
+
+    write_parser = commands.add_parser("write-profile", help="replace the controller's profile")
+    write_parser.add_argument("port")
+    write_parser.add_argument("profile")
+
+    dump_parser = commands.add_parser("dump", help="save the inputs recorded by the controller")
+    dump_parser.add_argument("port")
+    dump_parser.add_argument("output")
+
+    commands.add_parser("check", help="check the protocol against a stand-in controller")
+
+    args = parser.parse_args(argv)
+    if args.command == "check":
+        return check()
+
+    with open_port(args.port) as port:
+        connection = Connection(port)
+        try:
+            if args.command == "info":
+                for name, value in info(connection).items():
+                    print("%s: %s" % (name, value))
+            elif args.command == "stats":
+                for name, value in stats(connection).items():
+                    print("%s: %s" % (name, value))
+            elif args.command == "mode":
+                set_mode(connection, args.mode)
+            elif args.command == "read-profile":
+                data = read_profile(connection)
+                if data is None:
+                    print("No profile on the controller")
+                    return 1
+                with open(args.output, "wb") as f:
+                    f.write(data)
+            elif args.command == "write-profile":
+                profile = profile_tool.load(args.profile)
+                errors = profile_tool.validate(profile)
+                if errors:
+                    print("\n".join(errors))
+                    return 1
+                data = profile_tool.pack(profile)
+                if len(data) > PROFILE_BUFFER_SIZE:
+                    print("Profile is too big to send over serial")
+                    return 1
+                socd_types = [pair[2] for pair in profile.get("socd_pairs", [])]
+                if "2ip_timestamp" in socd_types and not stats(connection)["press_times"]:
+                    print("This firmware doesn't track press times, so it can't use 2ip_timestamp")
+                    return 1
+                write_profile(connection, data)
+                print("Saved")
+            elif args.command == "dump":
+                data = dump_inputs(connection)
+                with open(args.output, "wb") as f:
+                    f.write(data)
+                count = (len(data) - CAPTURE_HEADER_SIZE) // CAPTURE_RECORD_SIZE
+                print("Saved %d input changes to %s" % (count, args.output))
+        except ProtocolError as e:
+            print(e)
+            return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,126 @@
+"""
+Checks that the GameCube controller adapter reports (src/comms/gc_adapter.cpp) are laid out the way
+Dolphin reads them, and that rumble commands are understood.
+
+    python builder_scripts/gc_adapter_test.py
+
+Builds and runs a small program on the host, so it needs a C++ compiler ($CXX, or c++ by default).
+"""
+
+import sys
+
+import host_build
+
+TEST_SOURCE = r"""
+#include "comms/gc_adapter.hpp"
+#include "core/state.hpp"
+
+#include <stdio.h>
+
+static int failures = 0;
+
+static void check(bool ok, const char *what) {
+    if (!ok) {
+        printf("FAILED: %s\n", what);
+        failures++;
+    }
+}
+
+// Compares a report against the bytes that Dolphin expects, for a controller in the given port.
+static void check_report(
+    const char *what,
+    const OutputState &outputs,
+    uint8_t port,
+    const uint8_t (&expected)[GC_ADAPTER_PORT_SIZE]
+) {
+    uint8_t report[GC_ADAPTER_REPORT_SIZE + 1];
+    report[GC_ADAPTER_REPORT_SIZE] = 0xAA;
+    gc_adapter::encode_report(outputs, port, report);
+
+    check(report[0] == 0x21, what);
+    for (uint8_t p = 0; p < GC_ADAPTER_PORT_COUNT; p++) {
+        const uint8_t *state = report + 1 + p * GC_ADAPTER_PORT_SIZE;
+        for (size_t i = 0; i < GC_ADAPTER_PORT_SIZE; i++) {
+            check(state[i] == (p == port ? expected[i] : 0), what);
+        }
+    }
+    check(report[GC_ADAPTER_REPORT_SIZE] == 0xAA, "report doesn't overrun");
+}
+
+static void check_reports() {
+    check(GC_ADAPTER_REPORT_SIZE == 37, "report size");
+
+    // Neutral: wired controller, no buttons, centred sticks, released triggers.
+    check_report("neutral", OutputState(), 0, { 0x10, 0, 0, 128, 128, 128, 128, 0, 0 });
+
+    OutputState face;
+    face.a = true;
+    face.b = true;
+    face.x = true;
+    face.y = true;
+    face.start = true;
+    check_report("face buttons", face, 0, { 0x10, 0x0F, 0x01, 128, 128, 128, 128, 0, 0 });
+
+    OutputState dpad;
+    dpad.dpadLeft = true;
+    dpad.dpadRight = true;
+    dpad.dpadDown = true;
+    dpad.dpadUp = true;
+    check_report("D-pad", dpad, 0, { 0x10, 0xF0, 0, 128, 128, 128, 128, 0, 0 });
+
+    // Same as GamecubeBackend, select and home go on D-pad left and right.
+    OutputState menu;
+    menu.select = true;
+    menu.home = true;
+    check_report("select and home", menu, 0, { 0x10, 0x30, 0, 128, 128, 128, 128, 0, 0 });
+
+    OutputState shoulders;
+    shoulders.buttonR = true;
+    shoulders.triggerRDigital = true;
+    shoulders.triggerLDigital = true;
+    shoulders.triggerLAnalog = 140;
+    shoulders.triggerRAnalog = 49;
+    check_report("shoulders", shoulders, 0, { 0x10, 0, 0x0E, 128, 128, 128, 128, 140, 49 });
+
+    // Analog values are passed through untouched.
+    OutputState sticks;
+    sticks.leftStickX = 0;
+    sticks.leftStickY = 255;
+    sticks.rightStickX = 48;
+    sticks.rightStickY = 208;
+    check_report("sticks", sticks, 0, { 0x10, 0, 0, 0, 255, 48, 208, 0, 0 });
+    check_report("other port", sticks, 3, { 0x10, 0, 0, 0, 255, 48, 208, 0, 0 });
+}
+
+static void check_rumble() {
+    const uint8_t on[] = { 0x11, 1, 0, 0, 0 };
+    const uint8_t off[] = { 0x11, 0, 1, 1, 1 };
+    const uint8_t init[] = { 0x13 };
+    bool rumble = false;
+
+    check(gc_adapter::decode_rumble(on, sizeof(on), 0, rumble) && rumble, "rumble on");
+    check(gc_adapter::decode_rumble(off, sizeof(off), 0, rumble) && !rumble, "rumble off");
+    check(gc_adapter::decode_rumble(off, sizeof(off), 2, rumble) && rumble, "rumble other port");
+
+    rumble = true;
+    check(!gc_adapter::decode_rumble(init, sizeof(init), 0, rumble) && rumble, "not rumble");
+    check(!gc_adapter::decode_rumble(on, 3, 0, rumble), "short rumble command");
+}
+
+int main() {
+    check_reports();
+    check_rumble();
+    printf("GameCube adapter: %s\n", failures == 0 ? "OK" : "FAILED");
+    return failures != 0;
+}
+"""
+
+
+def main():
+    return host_build.run(
+        "test_gc_adapter", {"test_gc_adapter.cpp": TEST_SOURCE}, ["src/comms/gc_adapter.cpp"]
+    )
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,86 @@
+"""
+Builds the small programs that the checks in builder_scripts run on the host, against a stand-in
+for the HAL's stdlib.hpp. Needs a C++ compiler ($CXX, or c++ by default).
+"""
+
+import os
+import subprocess
+import tempfile
+
+PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+# Enough of the HAL for src/core, src/comms and src/modes to build on the host. The clock reads
+# host_time_us, which the program defines and moves on itself so that results don't depend on how
+# fast the host is, and delays return straight away.
+HOST_STDLIB = """#ifndef _HAL_STDLIB_HPP
+#define _HAL_STDLIB_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define memcpy_P memcpy
+#define pgm_read_byte(address) (*(const uint8_t *)(address))
+#define pgm_read_word(address) (*(const uint16_t *)(address))
+#define pgm_read_dword(address) (*(const uint32_t *)(address))
+
+extern uint32_t host_time_us;
+
+inline uint32_t micros() {
+    return host_time_us;
+}
+
+inline uint32_t millis() {
+    return host_time_us / 1000;
+}
+
+inline void delay(uint32_t ms) {}
+
+inline void delayMicroseconds(uint32_t us) {}
+
+#endif
+"""
+
+
+def write_files(build_dir, files):
+    """Writes the host stdlib.hpp and files (path in build_dir -> contents) into build_dir."""
+    files = dict({"stdlib.hpp": HOST_STDLIB}, **files)
+    for name, contents in files.items():
+        path = os.path.join(build_dir, name)
+        os.makedirs(os.path.dirname(path), exist_ok=True)
+        with open(path, "w") as f:
+            f.write(contents)
+
+
+def compile_sources(build_dir, sources, arguments, tree=PROJECT_DIR):
+    """Compiles sources against the headers in build_dir and in the tree's include directory."""
+    subprocess.run(
+        [os.environ.get("CXX", "c++"), "-std=gnu++17", "-O2", "-I", build_dir]
+        + ["-I", os.path.join(tree, "include")]
+        + sources
+        + arguments,
+        check=True,
+    )
+
+
+def build(build_dir, name, files, sources, arguments=[]):
+    """
+    Writes files into build_dir as write_files() does, then builds the .cpp files among them along
+    with sources (relative to the project) into a program called name. Returns its path.
+    """
+    write_files(build_dir, files)
+    executable = os.path.join(build_dir, name)
+    compile_sources(
+        build_dir,
+        [os.path.join(build_dir, path) for path in files if path.endswith(".cpp")]
+        + [os.path.join(PROJECT_DIR, path) for path in sources],
+        list(arguments) + ["-o", executable],
+    )
+    return executable
+
+
+def run(name, files, sources, arguments=[]):
+    """Builds a program as build() does in a temporary directory, runs it and returns its status."""
+    with tempfile.TemporaryDirectory() as build_dir:
+        return subprocess.run([build(build_dir, name, files, sources, arguments)]).returncode
@@ -0,0 +1,382 @@
+"""
+Checks that KeyValueStore (src/core/KeyValueStore.cpp) keeps its values across reboots, spreads its
+writes over both banks and survives losing power in the middle of a write, using storage that
+behaves like flash. Then runs it again on the AVR storage HAL (HAL/avr/src/storage.cpp), on top of
+a stand-in for the EEPROM functions from avr-libc.
+
+    python builder_scripts/kv_store_test.py
+
+Builds and runs a small program on the host, so it needs a C++ compiler ($CXX, or c++ by default).
+"""
+
+import os
+import subprocess
+import sys
+import tempfile
+
+import host_build
+
+# Small banks so that they fill up quickly.
+HOST_STORAGE = """#ifndef _STORAGE_HPP
+#define _STORAGE_HPP
+
+#include "stdlib.hpp"
+
+#define STORAGE_BANK_SIZE 64
+#define STORAGE_WRITE_TIME_US 1000
+#define STORAGE_ERASE_TIME_US(len) 400000
+
+namespace storage {
+    uint8_t read(uint8_t bank, size_t offset);
+    void write(uint8_t bank, size_t offset, const uint8_t *data, size_t len);
+    void erase(uint8_t bank, size_t len);
+}
+
+#endif
+"""
+
+AVR_EEPROM = """#include <stddef.h>
+#include <stdint.h>
+
+uint8_t eeprom_read_byte(const uint8_t *address);
+void eeprom_update_byte(uint8_t *address, uint8_t value);
+void eeprom_update_block(const void *source, void *address, size_t len);
+"""
+
+TEST_SOURCE = r"""
+#include "core/KeyValueStore.hpp"
+#include "storage.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static int failures = 0;
+
+static void check(bool ok, const char *what) {
+    if (!ok) {
+        printf("FAILED: %s\n", what);
+        failures++;
+    }
+}
+
+// Like flash, writes can only clear bits and erasing sets bytes back to 0xFF. Only the bytes asked
+// for are erased, which is all that the HAL promises. Power can be cut after a number of bytes have
+// been written, after which nothing else gets written.
+static uint8_t banks[2][STORAGE_BANK_SIZE];
+static int erases[2];
+static int writes;
+static long bytes_until_power_loss = -1;
+static bool wrote_unerased = false;
+
+namespace storage {
+    uint8_t read(uint8_t bank, size_t offset) {
+        return banks[bank][offset];
+    }
+
+    void write(uint8_t bank, size_t offset, const uint8_t *data, size_t len) {
+        writes++;
+        for (size_t i = 0; i < len; i++) {
+            if (bytes_until_power_loss == 0) {
+                return;
+            }
+            if (bytes_until_power_loss > 0) {
+                bytes_until_power_loss--;
+            }
+            wrote_unerased |= banks[bank][offset + i] != 0xFF;
+            banks[bank][offset + i] &= data[i];
+        }
+    }
+
+    void erase(uint8_t bank, size_t len) {
+        if (bytes_until_power_loss == 0) {
+            return;
+        }
+        erases[bank]++;
+        memset(banks[bank], 0xFF, len < STORAGE_BANK_SIZE ? len : STORAGE_BANK_SIZE);
+    }
+}
+
+static void reset_storage() {
+    memset(banks, 0xFF, sizeof(banks));
+    erases[0] = erases[1] = 0;
+    writes = 0;
+    bytes_until_power_loss = -1;
+}
+
+// What happens on every boot.
+static void boot(KeyValueStore &store) {
+    bytes_until_power_loss = -1;
+    store = KeyValueStore();
+    store.Load();
+    store.Compact();
+}
+
+static bool has_value(KeyValueStore &store, uint8_t key, uint16_t expected) {
+    uint16_t value;
+    return store.Get(key, value) && value == expected;
+}
+
+static void check_round_trip() {
+    reset_storage();
+    KeyValueStore store;
+    uint16_t value;
+
+    store.Load();
+    check(!store.Get(kv::LAST_MODE, value), "nothing in blank storage");
+    store.Compact();
+    check(erases[0] == 1, "blank storage gets a bank");
+
+    store.Set(kv::LAST_MODE, 3);
+    store.Set(kv::LAST_BACKEND, 0xBEEF);
+    check(has_value(store, kv::LAST_MODE, 3), "value available before commit");
+    check(writes == 1, "Set() doesn't write");
+    check(store.Pending(), "pending after set");
+
+    check(store.CommitTimeUs() == STORAGE_WRITE_TIME_US, "commit time with room in the bank");
+    store.Commit();
+    check(writes == 2, "commit writes one value at a time");
+    check(store.Pending(), "still pending after one commit");
+    store.Commit();
+    check(!store.Pending(), "second commit");
+
+    store.Set(kv::LAST_MODE, 3);
+    check(!store.Pending(), "setting the same value again isn't a change");
+    store.Set(KV_MAX_KEYS, 1);
+    check(!store.Pending() && !store.Get(KV_MAX_KEYS, value), "key out of range");
+
+    boot(store);
+    check(has_value(store, kv::LAST_MODE, 3), "value kept across boots");
+    check(has_value(store, kv::LAST_BACKEND, 0xBEEF), "16-bit value kept across boots");
+    check(erases[0] == 1 && erases[1] == 0, "no erase while the bank has room");
+    check(!wrote_unerased, "only ever writes to erased storage");
+}
+
+static void check_wear_levelling() {
+    reset_storage();
+    KeyValueStore store;
+    boot(store);
+
+    // Keep changing a value, rebooting every so often.
+    uint16_t mode = 0;
+    for (int changes = 1; changes <= 500; changes++) {
+        store.Set(kv::LAST_MODE, ++mode);
+        store.Set(kv::LAST_BACKEND, mode / 2);
+        while (store.Pending()) {
+            uint32_t commit_time_us = store.CommitTimeUs();
+            int erases_before = erases[0] + erases[1];
+            store.Commit();
+            if (erases[0] + erases[1] != erases_before) {
+                check(commit_time_us > 100 * STORAGE_WRITE_TIME_US, "commit time includes erasing");
+            }
+        }
+        if (changes % 7 == 0) {
+            boot(store);
+            check(has_value(store, kv::LAST_MODE, mode), "latest change kept across boots");
+            check(has_value(store, kv::LAST_BACKEND, mode / 2), "other key kept across boots");
+        }
+    }
+    check(erases[0] >= 10 && erases[1] >= 10, "erases spread over both banks");
+    check(abs(erases[0] - erases[1]) <= 1, "banks erased in turn");
+    check(!wrote_unerased, "only ever writes to erased storage");
+}
+
+static void check_power_loss() {
+    reset_storage();
+    KeyValueStore store;
+    boot(store);
+    store.Set(kv::LAST_MODE, 1);
+    store.Commit();
+
+    // Cut power partway through each byte of a record.
+    for (long bytes = 0; bytes < KV_RECORD_SIZE; bytes++) {
+        store.Set(kv::LAST_MODE, 2);
+        bytes_until_power_loss = bytes;
+        store.Commit();
+        boot(store);
+        check(has_value(store, kv::LAST_MODE, 1), "torn record ignored");
+
+        store.Set(kv::LAST_MODE, 1);
+        store.Set(kv::LAST_BACKEND, 7);
+        store.Commit();
+        check(!store.Pending(), "committing after a torn record");
+        boot(store);
+        check(has_value(store, kv::LAST_BACKEND, 7), "records after a torn one are read");
+    }
+
+    // Fill the bank up, then cut power at every point during compaction.
+    uint16_t mode = 100;
+    while (store.CommitTimeUs() == STORAGE_WRITE_TIME_US) {
+        store.Set(kv::LAST_MODE, ++mode);
+        store.Commit();
+    }
+    store.Set(kv::LAST_MODE, ++mode);
+    uint8_t saved[2][STORAGE_BANK_SIZE];
+    memcpy(saved, banks, sizeof(banks));
+    for (long bytes = 0; bytes <= 2 * KV_RECORD_SIZE + KV_HEADER_SIZE; bytes++) {
+        memcpy(banks, saved, sizeof(banks));
+        store = KeyValueStore();
+        store.Load();
+        bytes_until_power_loss = bytes;
+        store.Set(kv::LAST_MODE, mode);
+        store.Commit();
+
+        // The old bank is used until the new one gets its header, which is written last.
+        boot(store);
+        bool finished = bytes == 2 * KV_RECORD_SIZE + KV_HEADER_SIZE;
+        check(has_value(store, kv::LAST_MODE, finished ? mode : mode - 1), "compaction cut short");
+        check(has_value(store, kv::LAST_BACKEND, 7), "compaction cut short keeps every value");
+    }
+}
+
+static void check_sequence_wrap() {
+    reset_storage();
+    const uint8_t check_1 = kv::LAST_MODE ^ 1 ^ 0xA5;
+    const uint8_t check_2 = kv::LAST_MODE ^ 2 ^ 0xA5;
+    const uint8_t old_bank[] = { 'K', 'V', 0xFF, 0xFF, kv::LAST_MODE, 1, 0, check_1 };
+    const uint8_t new_bank[] = { 'K', 'V', 0x00, 0x00, kv::LAST_MODE, 2, 0, check_2 };
+    memcpy(banks[1], old_bank, sizeof(old_bank));
+    memcpy(banks[0], new_bank, sizeof(new_bank));
+
+    KeyValueStore store;
+    store.Load();
+    check(has_value(store, kv::LAST_MODE, 2), "sequence number wraps around");
+}
+
+int main() {
+    check_round_trip();
+    check_wear_levelling();
+    check_power_loss();
+    check_sequence_wrap();
+    printf("Key value store: %s\n", failures == 0 ? "OK" : "FAILED");
+    return failures != 0;
+}
+"""
+
+AVR_TEST_SOURCE = r"""
+#include "core/KeyValueStore.hpp"
+#include "storage.hpp"
+
+#include <stdio.h>
+
+static int failures = 0;
+
+static void check(bool ok, const char *what) {
+    if (!ok) {
+        printf("FAILED: %s\n", what);
+        failures++;
+    }
+}
+
+// EEPROM can change any byte to anything, but each byte written takes about 3.4ms and wears it out.
+static uint8_t eeprom[E2END + 1];
+static long byte_writes;
+static bool out_of_range = false;
+
+static size_t index_of(const void *address) {
+    size_t index = (size_t)address;
+    if (index > E2END) {
+        out_of_range = true;
+        return 0;
+    }
+    return index;
+}
+
+uint8_t eeprom_read_byte(const uint8_t *address) {
+    return eeprom[index_of(address)];
+}
+
+void eeprom_update_byte(uint8_t *address, uint8_t value) {
+    size_t index = index_of(address);
+    if (eeprom[index] != value) {
+        eeprom[index] = value;
+        byte_writes++;
+    }
+}
+
+void eeprom_update_block(const void *source, void *address, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        eeprom_update_byte((uint8_t *)address + i, ((const uint8_t *)source)[i]);
+    }
+}
+
+static void boot(KeyValueStore &store) {
+    store = KeyValueStore();
+    store.Load();
+    store.Compact();
+}
+
+static bool has_value(KeyValueStore &store, uint8_t key, uint16_t expected) {
+    uint16_t value;
+    return store.Get(key, value) && value == expected;
+}
+
+int main() {
+    check(STORAGE_WRITE_TIME_US >= KV_RECORD_SIZE * 3400, "write time covers a whole record");
+
+    // EEPROM from the factory, or after a chip erase.
+    memset(eeprom, 0xFF, sizeof(eeprom));
+    KeyValueStore store;
+    boot(store);
+    check(byte_writes == KV_HEADER_SIZE, "blank EEPROM only needs a header");
+
+    uint16_t mode = 0;
+    for (int changes = 1; changes <= 1000; changes++) {
+        store.Set(kv::LAST_MODE, ++mode);
+        long writes_before = byte_writes;
+        uint32_t commit_time_us = store.CommitTimeUs();
+        store.Commit();
+        if (commit_time_us == STORAGE_WRITE_TIME_US) {
+            check(byte_writes - writes_before <= KV_RECORD_SIZE, "one record per commit");
+        }
+        check(!store.Pending(), "committed");
+        if (changes % 7 == 0) {
+            boot(store);
+            check(has_value(store, kv::LAST_MODE, mode), "latest change kept across boots");
+        }
+    }
+    check(!out_of_range, "stays inside EEPROM");
+
+    // Rough figure for how evenly the bytes wear: every byte gets written at most once per pass
+    // through a bank, plus once when the bank is erased.
+    long passes = byte_writes / (E2END + 1);
+    check(passes < 20, "EEPROM writes spread out");
+
+    printf("Key value store on AVR EEPROM: %s\n", failures == 0 ? "OK" : "FAILED");
+    return failures != 0;
+}
+"""
+
+
+def main():
+    with tempfile.TemporaryDirectory() as build_dir:
+        flash_files = {"storage.hpp": HOST_STORAGE, "test_kv_store.cpp": TEST_SOURCE}
+        flash = host_build.build(
+            os.path.join(build_dir, "flash"),
+            "test_kv_store",
+            flash_files,
+            ["src/core/KeyValueStore.cpp"],
+        )
+
+        # The real AVR storage.hpp, so that it picks up the host stdlib.hpp next to it, with EEPROM
+        # the size of the ATmega328P's and ATmega32U4's.
+        avr_include = os.path.join(host_build.PROJECT_DIR, "HAL", "avr", "include")
+        with open(os.path.join(avr_include, "storage.hpp")) as f:
+            avr_storage = f.read()
+        avr_files = {
+            "storage.hpp": avr_storage,
+            os.path.join("avr", "eeprom.h"): AVR_EEPROM,
+            "test_kv_store.cpp": AVR_TEST_SOURCE,
+        }
+        avr = host_build.build(
+            os.path.join(build_dir, "avr"),
+            "test_kv_store",
+            avr_files,
+            ["src/core/KeyValueStore.cpp", "HAL/avr/src/storage.cpp"],
+            ["-D", "E2END=1023"],
+        )
+
+        return subprocess.run([flash]).returncode | subprocess.run([avr]).returncode
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,208 @@
+"""
+Checks that MacroEngine (src/core/MacroEngine.cpp) plays macros at the right times, and that the
+ProjectM mode plays its Z press macro once per press, using a made up clock so that the results
+don't depend on how fast the host is.
+
+    python builder_scripts/macro_test.py
+
+Builds and runs a small program on the host, so it needs a C++ compiler ($CXX, or c++ by default).
+"""
+
+import sys
+
+import host_build
+
+# Sources that the test builds along with src/core/MacroEngine.cpp, for the ProjectM mode.
+MODE_SOURCES = [
+    "src/core/ComboEngine.cpp",
+    "src/core/ControllerMode.cpp",
+    "src/core/FrameClock.cpp",
+    "src/core/InputMode.cpp",
+    "src/core/socd.cpp",
+    "src/modes/ProjectM.cpp",
+]
+
+TEST_SOURCE = r"""
+#include "core/FrameClock.hpp"
+#include "core/MacroEngine.hpp"
+#include "core/socd.hpp"
+#include "core/state.hpp"
+#include "modes/ProjectM.hpp"
+
+#include <new>
+#include <stdio.h>
+
+using namespace macro;
+
+uint32_t host_time_us = 0;
+
+static int failures = 0;
+
+static void check(bool ok, const char *what, uint32_t time) {
+    if (!ok) {
+        if (failures < 20) {
+            printf("FAILED: %s at %lu\n", what, (unsigned long)time);
+        }
+        failures++;
+    }
+}
+
+// Press X, then let go of it and fully press R 1000us later, for 3000us in total.
+static const Step timed_steps[] PROGMEM = {
+    {    0, press(OUTPUT_BIT(x))                                                                 },
+    { 1000, with_axis(Patch{ OUTPUT_BIT(triggerRDigital), OUTPUT_BIT(x), 0, {} }, TRIGGER_R, 140) },
+};
+static const Macro timed PROGMEM = { timed_steps, 2, MICROSECONDS, 3000 };
+
+// Hold down on the left stick for two frames, then the D-pad for one.
+static const Step frame_steps[] PROGMEM = {
+    { 0, with_axis(Patch{}, LEFT_STICK_Y, 0) },
+    { 2, press(OUTPUT_BIT(dpadDown))         },
+};
+static const Macro framed PROGMEM = { frame_steps, 2, FRAMES, 3 };
+
+// The mode's own outputs, which the macro is applied on top of.
+static OutputState mode_outputs() {
+    OutputState outputs;
+    outputs.x = true;
+    outputs.a = true;
+    outputs.rightStickX = 200;
+    return outputs;
+}
+
+static void check_timed(uint32_t start) {
+    MacroEngine engine;
+
+    // Poll every 100us, or sparsely to make sure steps still get caught up on.
+    for (uint32_t step = 1; step <= 1000; step *= 10) {
+        engine.Play(&timed, start, 0);
+        for (uint32_t elapsed = 0; elapsed < 4000; elapsed += 100 * step) {
+            OutputState outputs = mode_outputs();
+            engine.Apply(start + elapsed, 0, outputs);
+            bool second = elapsed >= 1000 && elapsed < 3000;
+            check(outputs.a, "mode output left alone", elapsed);
+            check(outputs.rightStickX == 200, "mode axis left alone", elapsed);
+            check(outputs.x == !second, "x", elapsed);
+            check(outputs.triggerRDigital == second, "R digital", elapsed);
+            check(outputs.triggerRAnalog == (second ? 140 : 0), "R analog", elapsed);
+            check(engine.Playing() == (elapsed < 3000), "playing", elapsed);
+        }
+    }
+}
+
+static void check_framed() {
+    MacroEngine engine;
+    uint32_t start_frame = 41;
+    engine.Play(&framed, 123456, start_frame);
+    for (uint32_t frame = start_frame; frame < start_frame + 5; frame++) {
+        // Several reports per frame, whose times shouldn't make any difference.
+        for (uint32_t report = 0; report < 4; report++) {
+            OutputState outputs = mode_outputs();
+            uint32_t elapsed = frame - start_frame;
+            engine.Apply(123456 + frame * 7919 + report * 1000, frame, outputs);
+            check(outputs.leftStickY == (elapsed < 2 ? 0 : 128), "left stick Y", elapsed);
+            check(outputs.dpadDown == (elapsed == 2), "D-pad down", elapsed);
+        }
+    }
+}
+
+static void check_replace_and_stop() {
+    MacroEngine engine;
+    engine.Play(&timed, 0, 0);
+    OutputState outputs = mode_outputs();
+    engine.Apply(1500, 0, outputs);
+    check(outputs.triggerRDigital, "first macro playing", 1500);
+
+    // Starting another macro replaces the one that's playing.
+    engine.Play(&framed, 1600, 10);
+    outputs = mode_outputs();
+    engine.Apply(1700, 10, outputs);
+    check(!outputs.triggerRDigital && outputs.leftStickY == 0, "second macro replaces first", 1700);
+
+    engine.Stop();
+    outputs = mode_outputs();
+    engine.Apply(1800, 10, outputs);
+    check(!engine.Playing() && outputs.leftStickY == 128, "stopped", 1800);
+}
+
+// Runs the mode for a report every millisecond, and returns the outputs of the last one.
+static OutputState run_reports(
+    ProjectM &mode,
+    FrameClock &frame_clock,
+    const InputState &inputs,
+    uint32_t count
+) {
+    OutputState outputs;
+    for (uint32_t i = 0; i < count; i++) {
+        host_time_us += 1000;
+        frame_clock.Update(host_time_us);
+        InputState scanned = inputs;
+        outputs = OutputState();
+        mode.UpdateOutputs(scanned, outputs);
+    }
+    return outputs;
+}
+
+static void check_project_m_z_press() {
+    alignas(ProjectM) static uint8_t storage[sizeof(ProjectM)];
+    ProjectMOptions options;
+    options.z_press_macro = true;
+    ProjectM *mode = new (storage) ProjectM(socd::SOCD_2IP_NO_REAC, options);
+    FrameClock frame_clock;
+    mode->SetFrameClock(&frame_clock);
+    host_time_us = 0;
+
+    InputState inputs;
+    run_reports(*mode, frame_clock, inputs, 5);
+
+    // Lightshield + A from the press until two frame boundaries later, and not after that even
+    // though Z is still held.
+    for (int press = 0; press < 2; press++) {
+        inputs.z = true;
+        uint32_t start_frame = 0;
+        for (uint32_t i = 0; i < 100; i++) {
+            OutputState outputs = run_reports(*mode, frame_clock, inputs, 1);
+            if (i == 0) {
+                start_frame = frame_clock.Frame();
+            }
+            bool playing = frame_clock.FramesSince(start_frame) < 2;
+            check(outputs.a == playing, "Z press A", host_time_us);
+            bool lightshield = outputs.triggerRAnalog == (playing ? 49 : 0);
+            check(lightshield, "Z press lightshield", host_time_us);
+            check(!outputs.buttonR, "no true Z press", host_time_us);
+        }
+        inputs.z = false;
+        run_reports(*mode, frame_clock, inputs, 10);
+    }
+
+    // Mod X + Z is still a true Z press.
+    inputs.mod_x = true;
+    run_reports(*mode, frame_clock, inputs, 1);
+    inputs.z = true;
+    OutputState outputs = run_reports(*mode, frame_clock, inputs, 1);
+    check(outputs.buttonR && !outputs.a && outputs.triggerRAnalog == 0, "Mod X + Z", host_time_us);
+
+    mode->~ProjectM();
+}
+
+int main() {
+    check_timed(0);
+    // Where the timer wraps around in the middle of the macro.
+    check_timed(0xFFFFFFFF - 1500);
+    check_framed();
+    check_replace_and_stop();
+    check_project_m_z_press();
+    printf("MacroEngine: %s\n", failures == 0 ? "OK" : "FAILED");
+    return failures != 0;
+}
+"""
+
+
+def main():
+    return host_build.run(
+        "test_macro", {"test_macro.cpp": TEST_SOURCE}, ["src/core/MacroEngine.cpp"] + MODE_SOURCES
+    )
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,371 @@
+"""
+Checks that the controller modes still give exactly the same outputs as the code they were
+converted from (the if-chains that became rule tables, and the copies of the D-pad layer, shield
+and Nunchuk handling that became stages), which is long gone from the tree. Each mode is run
+through every combination of the rectangle buttons, one button changing per report, and then
+through a long pseudo-random sequence that also plugs in and moves a Nunchuk. Every field of
+OutputState goes into a digest per configuration, which is compared with the digest that the old
+mode code gave, in builder_scripts/mode_outputs.txt.
+
+    python builder_scripts/mode_outputs_test.py
+
+The recorded digests came from the tree before the modes were converted (the baseline commit), and
+can be remade from any other checkout of HayBox, for instance with git worktree:
+
+    git worktree add /tmp/haybox-old <commit>
+    python builder_scripts/mode_outputs_test.py --record /tmp/haybox-old
+
+Builds and runs a small program on the host, so it needs a C++ compiler ($CXX, or c++ by default).
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+
+import host_build
+
+PROJECT_DIR = host_build.PROJECT_DIR
+
+DIGESTS_FILE = os.path.join(PROJECT_DIR, "builder_scripts", "mode_outputs.txt")
+
+# Controller modes whose outputs are checked: class name, header, and the constructor arguments of
+# each configuration to check.
+MODES = [
+    (
+        "Melee20Button",
+        "modes/Melee20Button.hpp",
+        {
+            "2ip_no_reac": "socd::SOCD_2IP_NO_REAC, Melee20ButtonOptions{ false }",
+            "2ip_no_reac_crouch_walk_os": "socd::SOCD_2IP_NO_REAC, Melee20ButtonOptions{ true }",
+            "none": "socd::SOCD_NONE, Melee20ButtonOptions{ false }",
+        },
+    ),
+    (
+        "ProjectM",
+        "modes/ProjectM.hpp",
+        {
+            "2ip_no_reac": "socd::SOCD_2IP_NO_REAC, ProjectMOptions{ false, true }",
+            "2ip_no_reac_true_z_press": "socd::SOCD_2IP_NO_REAC, ProjectMOptions{ true, true }",
+            "2ip_no_reac_no_max_jump": "socd::SOCD_2IP_NO_REAC, ProjectMOptions{ false, false }",
+            "none": "socd::SOCD_NONE, ProjectMOptions{ true, false }",
+        },
+    ),
+    ("Ultimate", "modes/Ultimate.hpp", {"2ip": "socd::SOCD_2IP", "none": "socd::SOCD_NONE"}),
+    ("UltimateR4", "modes/UltimateR4.hpp", {"2ip": "socd::SOCD_2IP", "none": "socd::SOCD_NONE"}),
+    ("Rivals2", "modes/Rivals2.hpp", {"2ip": "socd::SOCD_2IP", "none": "socd::SOCD_NONE"}),
+    (
+        "Melee18Button",
+        "modes/Melee18Button.hpp",
+        {
+            "2ip_no_reac": "socd::SOCD_2IP_NO_REAC, Melee18ButtonOptions{ false }",
+            "2ip_no_reac_crouch_walk_os": "socd::SOCD_2IP_NO_REAC, Melee18ButtonOptions{ true }",
+        },
+    ),
+    ("RivalsOfAether", "modes/RivalsOfAether.hpp", {"2ip": "socd::SOCD_2IP"}),
+    (
+        "FgcMode",
+        "modes/FgcMode.hpp",
+        {
+            "neutral": "socd::SOCD_NEUTRAL, socd::SOCD_NEUTRAL",
+            "neutral_dir2_priority": "socd::SOCD_NEUTRAL, socd::SOCD_DIR2_PRIORITY",
+        },
+    ),
+    ("DarkSouls", "modes/extra/DarkSouls.hpp", {"2ip": "socd::SOCD_2IP"}),
+    ("HollowKnight", "modes/extra/HollowKnight.hpp", {"2ip": "socd::SOCD_2IP"}),
+    ("MKWii", "modes/extra/MKWii.hpp", {"2ip": "socd::SOCD_2IP"}),
+    ("MultiVersus", "modes/extra/MultiVersus.hpp", {"2ip": "socd::SOCD_2IP"}),
+    ("RocketLeague", "modes/extra/RocketLeague.hpp", {"2ip": "socd::SOCD_2IP"}),
+    ("SaltAndSanctuary", "modes/extra/SaltAndSanctuary.hpp", {"2ip": "socd::SOCD_2IP"}),
+    ("ShovelKnight", "modes/extra/ShovelKnight.hpp", {"2ip": "socd::SOCD_2IP"}),
+    ("Ultimate2", "modes/extra/Ultimate2.hpp", {"2ip": "socd::SOCD_2IP"}),
+]
+
+# Sources under src/core that modes need. Only the ones that exist in the tree being built are used,
+# as older trees have fewer of them.
+CORE_SOURCES = [
+    "ComboEngine.cpp",
+    "ControllerMode.cpp",
+    "FrameClock.cpp",
+    "InputMode.cpp",
+    "MacroEngine.cpp",
+    "socd.cpp",
+]
+
+TEST_SOURCE = r"""
+#include "core/ControllerMode.hpp"
+#include "core/socd.hpp"
+#include "core/state.hpp"
+%(includes)s
+
+#if __has_include("core/FrameClock.hpp")
+#include "core/FrameClock.hpp"
+#define HAS_FRAME_CLOCK
+#endif
+
+#include <new>
+#include <stdio.h>
+
+// The test moves the clock on by a millisecond every report.
+uint32_t host_time_us = 0;
+
+#define RANDOM_REPORTS 1000000
+
+// Rectangle inputs in the order of InputState, which is the same in every version of it.
+static bool InputState::*const buttons[] = {
+    &InputState::left,        &InputState::right,     &InputState::down,   &InputState::up,
+    &InputState::c_left,      &InputState::c_right,   &InputState::c_down, &InputState::c_up,
+    &InputState::a,           &InputState::b,         &InputState::x,      &InputState::y,
+    &InputState::l,           &InputState::r,         &InputState::z,      &InputState::lightshield,
+    &InputState::midshield,   &InputState::select,    &InputState::start,  &InputState::home,
+    &InputState::mod_x,       &InputState::mod_y,
+};
+static const size_t button_count = sizeof(buttons) / sizeof(buttons[0]);
+
+// Modes can only be constructed in place (see InputMode), like set_mode() does on the controller.
+alignas(16) static uint8_t mode_storage[4096];
+
+typedef ControllerMode *(*CreateMode)();
+
+typedef struct {
+    const char *name;
+    CreateMode create;
+} ModeConfig;
+
+%(creators)s
+
+static const ModeConfig configs[] = {
+%(configs)s
+};
+
+// FNV-1a over every field of OutputState, so that padding and new fields don't matter.
+static uint64_t digest_outputs(uint64_t hash, const OutputState &o) {
+    const uint8_t fields[] = {
+        o.a,           o.b,           o.x,           o.y,           o.buttonL,
+        o.buttonR,     o.triggerLDigital,            o.triggerRDigital,
+        o.start,       o.select,      o.home,        o.dpadUp,      o.dpadDown,
+        o.dpadLeft,    o.dpadRight,   o.leftStickClick,             o.rightStickClick,
+        o.leftStickX,  o.leftStickY,  o.rightStickX, o.rightStickY, o.triggerLAnalog,
+        o.triggerRAnalog,
+    };
+    for (size_t i = 0; i < sizeof(fields); i++) {
+        hash = (hash ^ fields[i]) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+static uint64_t report(ControllerMode *mode, const InputState &raw_inputs, uint64_t hash) {
+#ifdef HAS_FRAME_CLOCK
+    static FrameClock frame_clock;
+    mode->SetFrameClock(&frame_clock);
+    frame_clock.Update(host_time_us);
+#endif
+    // The mode gets its own copy, like it gets freshly scanned inputs on the controller.
+    InputState inputs = raw_inputs;
+    OutputState outputs;
+    mode->UpdateOutputs(inputs, outputs);
+    host_time_us += 1000;
+    return digest_outputs(hash, outputs);
+}
+
+// Every combination of the rectangle inputs, in Gray code order so one button changes per report.
+static uint64_t all_buttons(ControllerMode *mode) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    InputState inputs;
+    hash = report(mode, inputs, hash);
+    for (uint32_t step = 1; step < (1UL << button_count); step++) {
+        size_t changed = __builtin_ctz(step);
+        inputs.*buttons[changed] = !(inputs.*buttons[changed]);
+        hash = report(mode, inputs, hash);
+    }
+    return hash;
+}
+
+// A few buttons change at a time, and a Nunchuk comes and goes with its stick all over the place.
+static uint64_t random_inputs(ControllerMode *mode) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    uint32_t seed = 1;
+    InputState inputs;
+    for (uint32_t i = 0; i < RANDOM_REPORTS; i++) {
+        seed = seed * 1103515245 + 12345;
+        uint32_t r = seed >> 8;
+        for (uint32_t j = 0; j <= (r & 3); j++) {
+            size_t changed = ((r >> (2 + 5 * j)) & 0x1F) %% button_count;
+            inputs.*buttons[changed] = !(inputs.*buttons[changed]);
+        }
+        seed = seed * 1103515245 + 12345;
+        r = seed >> 8;
+        if ((r & 0xFF) == 0) {
+            inputs.nunchuk_connected = !inputs.nunchuk_connected;
+        }
+        if (inputs.nunchuk_connected) {
+            inputs.nunchuk_x = (int8_t)(r >> 8);
+            inputs.nunchuk_y = (int8_t)(r >> 16);
+            inputs.nunchuk_c = (r >> 1) & 1;
+            inputs.nunchuk_z = (r >> 2) & 1;
+        } else {
+            inputs.nunchuk_x = 0;
+            inputs.nunchuk_y = 0;
+            inputs.nunchuk_c = false;
+            inputs.nunchuk_z = false;
+        }
+        hash = report(mode, inputs, hash);
+    }
+    return hash;
+}
+
+int main() {
+    for (size_t i = 0; i < sizeof(configs) / sizeof(configs[0]); i++) {
+        host_time_us = 0;
+        ControllerMode *mode = configs[i].create();
+        uint64_t buttons_digest = all_buttons(mode);
+        mode->~ControllerMode();
+
+        host_time_us = 0;
+        mode = configs[i].create();
+        uint64_t random_digest = random_inputs(mode);
+        mode->~ControllerMode();
+
+        printf(
+            "%%s %%016llx %%016llx\n",
+            configs[i].name,
+            (unsigned long long)buttons_digest,
+            (unsigned long long)random_digest
+        );
+    }
+    return 0;
+}
+"""
+
+
+def config_name(cls, config):
+    return "%s/%s" % (cls, config)
+
+
+def build(tree, build_dir, mode, core_objects):
+    cls, header, mode_configs = mode
+    creators = []
+    configs = []
+    for config, arguments in mode_configs.items():
+        function = "create_%s" % config
+        creators.append(
+            "static ControllerMode *%s() {\n"
+            "    static_assert(sizeof(%s) <= sizeof(mode_storage), \"Mode doesn't fit\");\n"
+            "    return new (mode_storage) %s(%s);\n"
+            "}\n" % (function, cls, cls, arguments)
+        )
+        configs.append('    { "%s", %s },' % (config_name(cls, config), function))
+
+    # Old versions of some modes declare a HandleSocd() that was never written, so they only
+    # linked because nothing used them. The base class version is what was meant.
+    mode_source = os.path.join(tree, "src", header[: -len(".hpp")] + ".cpp")
+    with open(os.path.join(tree, "include", header)) as f:
+        declares_handle_socd = "HandleSocd(" in f.read()
+    with open(mode_source) as f:
+        defines_handle_socd = "::HandleSocd(" in f.read()
+    if declares_handle_socd and not defines_handle_socd:
+        creators.append(
+            "void %s::HandleSocd(InputState &inputs) {\n"
+            "    InputMode::HandleSocd(inputs);\n"
+            "}\n" % cls
+        )
+
+    test_source = os.path.join(build_dir, "%s_test.cpp" % cls)
+    with open(test_source, "w") as f:
+        f.write(
+            TEST_SOURCE
+            % {
+                "includes": '#include "%s"' % header,
+                "creators": "\n".join(creators),
+                "configs": "\n".join(configs),
+            }
+        )
+
+    # Each mode gets its own program, as some old mode headers clash with each other.
+    executable = os.path.join(build_dir, "%s_test" % cls)
+    host_build.compile_sources(
+        build_dir, [test_source, mode_source] + core_objects, ["-o", executable], tree
+    )
+    return executable
+
+
+def run(tree):
+    output = ""
+    with tempfile.TemporaryDirectory() as build_dir:
+        host_build.write_files(build_dir, {})
+
+        core_objects = []
+        for name in CORE_SOURCES:
+            path = os.path.join(tree, "src", "core", name)
+            if os.path.exists(path):
+                core_objects.append(os.path.join(build_dir, name[: -len(".cpp")] + ".o"))
+                host_build.compile_sources(build_dir, [path], ["-c", "-o", core_objects[-1]], tree)
+
+        for mode in MODES:
+            executable = build(tree, build_dir, mode, core_objects)
+            output += subprocess.run(
+                [executable], check=True, capture_output=True, text=True
+            ).stdout
+
+    digests = {}
+    for line in output.splitlines():
+        name, buttons, random = line.split()
+        digests[name] = (buttons, random)
+    return digests
+
+
+def load_digests():
+    digests = {}
+    with open(DIGESTS_FILE) as f:
+        for line in f:
+            line = line.strip()
+            if line and not line.startswith("#"):
+                name, buttons, random = line.split()
+                digests[name] = (buttons, random)
+    return digests
+
+
+def record(tree):
+    digests = run(os.path.abspath(tree))
+    with open(DIGESTS_FILE, "w") as f:
+        f.write("# Controller mode output digests, made by mode_outputs_test.py --record.\n")
+        f.write("# <mode>/<configuration> <all buttons digest> <random inputs digest>\n")
+        for name in sorted(digests):
+            f.write("%s %s %s\n" % (name, *digests[name]))
+    print("Recorded %d configurations from %s" % (len(digests), tree))
+    return 0
+
+
+def check():
+    expected = load_digests()
+    actual = run(PROJECT_DIR)
+    failures = 0
+    for name in sorted(actual):
+        if name not in expected:
+            print("%s: no recorded digest" % name)
+            failures += 1
+            continue
+        buttons_ok = actual[name][0] == expected[name][0]
+        random_ok = actual[name][1] == expected[name][1]
+        if buttons_ok and random_ok:
+            print("%s: OK" % name)
+        else:
+            parts = (("all buttons", buttons_ok), ("random inputs", random_ok))
+            failed = [part for part, ok in parts if not ok]
+            print("%s: FAILED (%s)" % (name, ", ".join(failed)))
+            failures += 1
+    return failures != 0
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description="Check mode outputs against the old mode code.")
+    parser.add_argument("--record", metavar="TREE", help="record digests from another checkout")
+    args = parser.parse_args(argv)
+    if args.record:
+        return record(args.record)
+    return check()
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
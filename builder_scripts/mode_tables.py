@@ -0,0 +1,781 @@
+"""
+Generates the stick rule tables used by controller modes from the JSON specs in src/modes/specs.
+
+Runs automatically before every PlatformIO build. It can also be run by hand:
+
+    python builder_scripts/mode_tables.py           # regenerate the headers
+    python builder_scripts/mode_tables.py --check   # fail if any header is out of date
+    python builder_scripts/mode_tables.py --test    # also build and run a host-side test
+
+Each spec looks like this:
+
+    {
+        "mode": "Melee20Button",
+        "conditions": { "CROUCH_WALK_OS": "MODE_FLAG_0" },
+        "rules": [
+            { "comment": "q1/2 = 7000 7000", "when": ["DIAGONAL"], "left": [56, 56] },
+            { "when": ["MOD_X", "HORIZONTAL"], "left_x": 53 },
+            { "when": ["MOD_X", "DIAGONAL"], "unless": ["SHIELD"], "left": [59, 25] },
+            { "when": ["MOD_X", "C_HORIZONTAL"], "right": [68, 42], "y_sign": "Y" }
+        ]
+    }
+
+"when" lists the conditions that must all be held and "unless" the ones that must not be. The
+condition names are the ones from stick_rules::Condition, plus any aliases for mode specific flags
+given in "conditions". Each rule sets one of "left", "left_x", "left_y" or "right" to offsets from
+neutral. By default, X offsets follow the direction of the stick's own X axis and Y offsets follow
+the direction of its Y axis. "x_sign" and "y_sign" override this with X, Y, CX, CY or POSITIVE.
+Later rules override earlier ones, just like a chain of if statements.
+
+Besides the rule table, every stick that the rules touch also gets a lookup table holding the
+output for every combination of the conditions it depends on, for ControllerMode::ApplyStickLut().
+"""
+
+import itertools
+import json
+import math
+import os
+import random
+import re
+import sys
+
+try:
+    Import("env")
+    PROJECT_DIR = env.subst("$PROJECT_DIR")
+except NameError:
+    # Run directly rather than by PlatformIO.
+    env = None
+    PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+SPEC_DIR = os.path.join(PROJECT_DIR, "src", "modes", "specs")
+OUTPUT_DIR = os.path.join(PROJECT_DIR, "include", "modes", "generated")
+STICK_RULES_HEADER = os.path.join(PROJECT_DIR, "include", "core", "stick_rules.hpp")
+
+MAX_LINE_LENGTH = 100
+INDENT = "    "
+
+# Axes set by each kind of rule, and the default sign source for its X and Y offsets.
+RULE_KINDS = {
+    "left": ("LEFT_X | LEFT_Y", "X", "Y"),
+    "left_x": ("LEFT_X", "X", "Y"),
+    "left_y": ("LEFT_Y", "X", "Y"),
+    "right": ("RIGHT_X | RIGHT_Y", "CX", "CY"),
+}
+SIGNS = ("X", "Y", "CX", "CY", "POSITIVE")
+# In the order of their bits in stick_rules::Target.
+TARGETS = ("LEFT_X", "LEFT_Y", "RIGHT_X", "RIGHT_Y")
+
+# Number of random condition words checked per mode by the host-side test.
+RANDOM_TEST_CASES = 500
+
+
+class SpecError(Exception):
+    pass
+
+
+def condition_bits():
+    """Reads the condition bit positions straight out of core/stick_rules.hpp."""
+    with open(STICK_RULES_HEADER) as f:
+        source = f.read()
+    return {name: 1 << int(bit) for name, bit in re.findall(r"(\w+) = 1UL << (\d+),", source)}
+
+
+def snake_case(name):
+    return re.sub(r"(?<=[a-z0-9])(?=[A-Z])", "_", name).lower()
+
+
+class Rule:
+    def __init__(self, spec, index, conditions):
+        where = "rule %d" % index
+        kinds = [kind for kind in RULE_KINDS if kind in spec]
+        if len(kinds) != 1:
+            raise SpecError("%s must set exactly one of %s" % (where, ", ".join(RULE_KINDS)))
+        self.kind = kinds[0]
+        self.targets, default_x_sign, default_y_sign = RULE_KINDS[self.kind]
+
+        value = spec[self.kind]
+        if self.kind in ("left", "right"):
+            if not isinstance(value, list) or len(value) != 2:
+                raise SpecError("%s: %s must be [x, y]" % (where, self.kind))
+            self.x, self.y = value
+        elif self.kind == "left_x":
+            self.x, self.y = value, 0
+        else:
+            self.x, self.y = 0, value
+        for offset in (self.x, self.y):
+            if not isinstance(offset, int) or not -128 <= offset <= 127:
+                raise SpecError("%s: offset %r does not fit in an int8_t" % (where, offset))
+
+        self.x_sign = spec.get("x_sign", default_x_sign)
+        self.y_sign = spec.get("y_sign", default_y_sign)
+        for sign in (self.x_sign, self.y_sign):
+            if sign not in SIGNS:
+                raise SpecError("%s: unknown sign %r" % (where, sign))
+
+        self.when = spec.get("when", [])
+        self.unless = spec.get("unless", [])
+        for name in self.when + self.unless:
+            if name not in conditions:
+                raise SpecError("%s: unknown condition %r" % (where, name))
+        if set(self.when) & set(self.unless):
+            raise SpecError("%s can never match" % where)
+        self.when_mask = sum(conditions[name] for name in set(self.when))
+        self.unless_mask = sum(conditions[name] for name in set(self.unless))
+
+        comment = spec.get("comment", [])
+        self.comment = [comment] if isinstance(comment, str) else comment
+
+    def expression(self):
+        when = " | ".join(self.when) or "0"
+        unless = " | ".join(self.unless) or "0"
+        defaults = RULE_KINDS[self.kind][1:]
+        if (self.x_sign, self.y_sign) == defaults and self.kind != "right":
+            if self.kind == "left":
+                return "left_stick", [when, unless, str(self.x), str(self.y)]
+            offset = self.x if self.kind == "left_x" else self.y
+            return self.kind, [when, unless, str(offset)]
+        if self.kind == "right" and self.x_sign == "CX":
+            return "right_stick", [when, unless, str(self.x), "SIGN_" + self.y_sign, str(self.y)]
+        return "rule", [
+            when,
+            unless,
+            self.targets,
+            "SIGN_" + self.x_sign,
+            str(self.x),
+            "SIGN_" + self.y_sign,
+            str(self.y),
+        ]
+
+    def annotation(self):
+        # Angle and magnitude of full two-axis rules, to make the tables easier to audit.
+        if self.kind not in ("left", "right") or self.x == 0:
+            return None
+        angle = math.degrees(math.atan2(abs(self.y), abs(self.x)))
+        return "%.2f deg, magnitude %d" % (angle, round(math.hypot(self.x, self.y)))
+
+
+class Spec:
+    def __init__(self, path, base_conditions):
+        self.path = path
+        with open(path) as f:
+            spec = json.load(f)
+
+        self.mode = spec["mode"]
+        self.aliases = spec.get("conditions", {})
+        conditions = dict(base_conditions)
+        for alias, target in self.aliases.items():
+            if target not in base_conditions:
+                raise SpecError("%s: alias %s refers to unknown %r" % (path, alias, target))
+            conditions[alias] = base_conditions[target]
+        self.conditions = conditions
+
+        try:
+            self.rules = [Rule(rule, i, conditions) for i, rule in enumerate(spec["rules"])]
+        except SpecError as e:
+            raise SpecError("%s: %s" % (path, e))
+
+        # A stick that no rule touches doesn't need a lookup table.
+        self.luts = [
+            StickLut(self, stick, base_conditions)
+            for stick, axes in STICKS.items()
+            if any(set(rule.targets.split(" | ")) & set(axes) for rule in self.rules)
+        ]
+
+    @property
+    def namespace(self):
+        return snake_case(self.mode)
+
+    @property
+    def header_name(self):
+        return self.mode + "Rules.hpp"
+
+    def evaluate(self, conditions, signs, neutral=128):
+        """Reference model of ControllerMode::ApplyStickRules(), evaluated from the spec."""
+        outputs = {"LEFT_X": 128, "LEFT_Y": 128, "RIGHT_X": 128, "RIGHT_Y": 128}
+        for rule in self.rules:
+            if conditions & (rule.when_mask | rule.unless_mask) != rule.when_mask:
+                continue
+            x = (neutral + signs[rule.x_sign] * rule.x) & 0xFF
+            y = (neutral + signs[rule.y_sign] * rule.y) & 0xFF
+            for target in rule.targets.split(" | "):
+                outputs[target] = x if target.endswith("_X") else y
+        return outputs
+
+
+# Conditions that ControllerMode::StickConditions() derives from others. A lookup table indexes the
+# conditions they are derived from instead, so that it never has to hold impossible combinations.
+DERIVED_CONDITIONS = {"DIAGONAL": ("HORIZONTAL", "VERTICAL")}
+
+# Conditions that can only ever be set along with another one.
+DEPENDENT_CONDITIONS = {
+    "X_NEGATIVE": "HORIZONTAL",
+    "Y_NEGATIVE": "VERTICAL",
+    "C_Y_NEGATIVE": "C_VERTICAL",
+}
+
+# Axes covered by each stick's lookup table.
+STICKS = {
+    "left": ("LEFT_X", "LEFT_Y"),
+    "right": ("RIGHT_X", "RIGHT_Y"),
+}
+
+# Lookup tables index their rows and outputs with a uint8_t, and their cells with a uint16_t.
+MAX_LUT_ENTRIES = 256
+MAX_LUT_INDEX_BITS = 16
+
+
+class StickLut:
+    """Every rule for one stick, flattened into a two-level lookup table."""
+
+    def __init__(self, spec, stick, base):
+        self.spec = spec
+        self.stick = stick
+        self.axes = STICKS[stick]
+        self.rules = [
+            rule for rule in spec.rules if set(rule.targets.split(" | ")) & set(self.axes)
+        ]
+        self.index_names = self._index_conditions(base)
+        if len(self.index_names) > MAX_LUT_INDEX_BITS:
+            raise SpecError(
+                "%s: %s stick depends on %d conditions, more than a lookup table can index"
+                % (spec.path, stick, len(self.index_names))
+            )
+        self.index_bits = [base[name] for name in self.index_names]
+
+        # Output 0 leaves both axes alone, for when no rule matches.
+        self.outputs = [(0, 0, 0, 0)]
+        output_ids = {self.outputs[0]: 0}
+        table = []
+        for index in range(1 << len(self.index_bits)):
+            canonical = self._canonical_index(index)
+            if canonical != index:
+                table.append(table[canonical])
+                continue
+            output = self._output(self._conditions(index))
+            if output not in output_ids:
+                output_ids[output] = len(self.outputs)
+                self.outputs.append(output)
+            table.append(output_ids[output])
+        if len(self.outputs) > MAX_LUT_ENTRIES:
+            raise SpecError(
+                "%s: %s stick has %d distinct outputs, more than a lookup table can hold"
+                % (spec.path, stick, len(self.outputs))
+            )
+        self._layout(table)
+
+    def _index_conditions(self, base):
+        used = set()
+        for rule in self.rules:
+            used |= set(base_name(self.spec, name) for name in rule.when + rule.unless)
+        for derived, sources in DERIVED_CONDITIONS.items():
+            if derived in used:
+                used.remove(derived)
+                used |= set(sources)
+        # Keep the order of stick_rules::Condition so the table is stable.
+        return [name for name in base if name in used]
+
+    def _conditions(self, index):
+        conditions = 0
+        names = set()
+        for i, name in enumerate(self.index_names):
+            if index & (1 << i):
+                conditions |= self.index_bits[i]
+                names.add(name)
+        bits = self.spec.conditions
+        for derived, sources in DERIVED_CONDITIONS.items():
+            if all(source in names for source in sources):
+                conditions |= bits[derived]
+        return conditions
+
+    def _canonical_index(self, index):
+        # An impossible combination gets the same output as the one with the dependent condition
+        # cleared, which always has a lower index and so has already been filled in.
+        for dependent, parent in DEPENDENT_CONDITIONS.items():
+            if dependent in self.index_names and parent in self.index_names:
+                dependent_bit = 1 << self.index_names.index(dependent)
+                parent_bit = 1 << self.index_names.index(parent)
+                if index & dependent_bit and not index & parent_bit:
+                    return self._canonical_index(index & ~dependent_bit)
+        return index
+
+    def _output(self, conditions):
+        # Same as Spec.evaluate(), but keeps the winning rule's sign and offset for each axis
+        # rather than resolving them.
+        targets = 0
+        x = (0, "X")
+        y = (0, "Y")
+        for rule in self.rules:
+            if conditions & (rule.when_mask | rule.unless_mask) != rule.when_mask:
+                continue
+            for target in rule.targets.split(" | "):
+                targets |= 1 << list(TARGETS).index(target)
+                if target.endswith("_X"):
+                    x = (rule.x, rule.x_sign)
+                else:
+                    y = (rule.y, rule.y_sign)
+        if targets == 0:
+            return self.outputs[0]
+        signs = SIGNS.index(x[1]) | (SIGNS.index(y[1]) << 4)
+        return (targets, signs, x[0], y[0])
+
+    def _layout(self, table):
+        # Greedily move index bits into the low half one at a time, picking whichever makes the
+        # table smallest, and keep the best split seen along the way.
+        best = None
+        low = []
+        remaining = list(range(len(self.index_bits)))
+        while True:
+            rows, cells = self._split(table, low, remaining)
+            size = (1 << len(remaining)) + len(cells)
+            if len(rows) <= MAX_LUT_ENTRIES and (best is None or size < best[0]):
+                best = (size, list(low), list(remaining), rows, cells)
+            if not remaining:
+                break
+            candidates = []
+            for bit in remaining:
+                high = [b for b in remaining if b != bit]
+                rows, cells = self._split(table, low + [bit], high)
+                candidates.append(((1 << len(high)) + len(cells), bit))
+            low.append(min(candidates)[1])
+            remaining.remove(low[-1])
+        if best is None:
+            raise SpecError(
+                "%s: %s stick has too many distinct rows" % (self.spec.path, self.stick)
+            )
+        _, low, high, self.rows, self.cells = best
+        order = low + high
+        self.low_bit_count = len(low)
+        self.high_bit_count = len(high)
+        self.index_names = [self.index_names[i] for i in order]
+        self.index_bits = [self.index_bits[i] for i in order]
+
+    @staticmethod
+    def _split(table, low, high):
+        # Old index for each new index, with the low bits first.
+        permutation = [0]
+        for bit in low + high:
+            permutation += [index | (1 << bit) for index in permutation]
+        values = [table[index] for index in permutation]
+        row_length = 1 << len(low)
+        row_ids = {}
+        rows = []
+        cells = []
+        for start in range(0, len(values), row_length):
+            row = tuple(values[start : start + row_length])
+            if row not in row_ids:
+                row_ids[row] = len(row_ids)
+                cells.extend(row)
+            rows.append(row_ids[row])
+        return rows, cells
+
+    @property
+    def name(self):
+        return "%s_stick_lut" % self.stick
+
+    @property
+    def size(self):
+        return len(self.index_bits) * 4 + len(self.rows) + len(self.cells) + len(self.outputs) * 4
+
+    def evaluate(self, conditions, signs, outputs, neutral=128):
+        """Reference model of ControllerMode::ApplyStickLut()."""
+        index = 0
+        for i, bit in enumerate(self.index_bits):
+            if conditions & bit:
+                index |= 1 << i
+        row = self.rows[index >> self.low_bit_count]
+        low_mask = (1 << self.low_bit_count) - 1
+        cell = self.cells[(row << self.low_bit_count) | (index & low_mask)]
+        targets, sign_ids, x, y = self.outputs[cell]
+        for i, target in enumerate(TARGETS):
+            if targets & (1 << i):
+                if target.endswith("_X"):
+                    outputs[target] = (neutral + signs[SIGNS[sign_ids & 0x0F]] * x) & 0xFF
+                else:
+                    outputs[target] = (neutral + signs[SIGNS[sign_ids >> 4]] * y) & 0xFF
+
+
+def base_name(spec, name):
+    return spec.aliases.get(name, name)
+
+
+def format_call(name, args, indent):
+    line = "%s%s(%s)," % (indent, name, ", ".join(args))
+    if len(line) <= MAX_LINE_LENGTH:
+        return [line]
+    return (
+        ["%s%s(" % (indent, name)]
+        + ["%s%s%s," % (indent, INDENT, arg) for arg in args[:-1]]
+        + ["%s%s%s" % (indent, INDENT, args[-1]), "%s)," % indent]
+    )
+
+
+def generate_header(spec):
+    guard = "_MODES_GENERATED_%s_RULES_HPP" % spec.mode.upper()
+    source = os.path.relpath(spec.path, PROJECT_DIR).replace(os.sep, "/")
+    indent = INDENT * 2
+
+    lines = [
+        "// Generated by builder_scripts/mode_tables.py from %s. Do not edit." % source,
+        "",
+        "#ifndef %s" % guard,
+        "#define %s" % guard,
+        "",
+        '#include "core/stick_rules.hpp"',
+        "",
+        "namespace stick_rules {",
+        "%snamespace %s {" % (INDENT, spec.namespace),
+    ]
+    for alias, target in spec.aliases.items():
+        lines.append("%sconstexpr uint32_t %s = %s;" % (indent, alias, target))
+    if spec.aliases:
+        lines.append("")
+
+    lines.append("%sstatic const StickRule analog_rules[] PROGMEM = {" % indent)
+    for rule in spec.rules:
+        for comment in rule.comment:
+            lines.append("%s%s// %s" % (indent, INDENT, comment))
+        annotation = rule.annotation()
+        if annotation is not None:
+            lines.append("%s%s// %s" % (indent, INDENT, annotation))
+        lines.extend(format_call(*rule.expression(), indent + INDENT))
+    lines.append("%s};" % indent)
+    for lut in spec.luts:
+        lines += [""] + generate_lut(spec, lut, indent)
+    lines += [
+        "%s}" % INDENT,
+        "}",
+        "",
+        "#endif",
+        "",
+    ]
+    return "\n".join(lines)
+
+
+def format_array(declaration, values, indent):
+    lines = ["%s%s = {" % (indent, declaration)]
+    line = indent + INDENT
+    for value in values:
+        item = "%s," % value
+        if line.strip() and len(line) + 1 + len(item) > MAX_LINE_LENGTH:
+            lines.append(line)
+            line = indent + INDENT
+        line += (" " if line.strip() else "") + item
+    if line.strip():
+        lines.append(line)
+    lines.append("%s};" % indent)
+    return lines
+
+
+def generate_lut(spec, lut, indent):
+    # Show mode specific flags by their alias, as the rules do.
+    names = {target: alias for alias, target in spec.aliases.items()}
+    index_names = [names.get(name, name) for name in lut.index_names]
+
+    outputs = []
+    for targets, signs, x, y in lut.outputs:
+        target_names = " | ".join(t for i, t in enumerate(TARGETS) if targets & (1 << i)) or "0"
+        sign_names = "SIGN_%s | (SIGN_%s << 4)" % (SIGNS[signs & 0x0F], SIGNS[signs >> 4])
+        outputs.append("{ %s, %s, %d, %d }" % (target_names, sign_names, x, y))
+
+    lines = [
+        "%s// %s stick lookup table: %d index bits (%d low, %d high), %d of %d rows unique,"
+        % (
+            indent,
+            lut.stick.capitalize(),
+            len(lut.index_bits),
+            lut.low_bit_count,
+            lut.high_bit_count,
+            len(set(lut.rows)),
+            len(lut.rows),
+        ),
+        "%s// %d outputs, %d bytes in total." % (indent, len(lut.outputs), lut.size),
+    ]
+    lines += format_array(
+        "static const uint32_t %s_bits[] PROGMEM" % lut.name, index_names, indent
+    )
+    lines += format_array("static const uint8_t %s_rows[] PROGMEM" % lut.name, lut.rows, indent)
+    lines += format_array("static const uint8_t %s_cells[] PROGMEM" % lut.name, lut.cells, indent)
+    lines.append("%sstatic const StickOutput %s_outputs[] PROGMEM = {" % (indent, lut.name))
+    lines += ["%s%s%s," % (indent, INDENT, output) for output in outputs]
+    lines.append("%s};" % indent)
+    lines += [
+        "%sstatic const StickLut %s PROGMEM = {" % (indent, lut.name),
+        "%s%s%s_bits," % (indent, INDENT, lut.name),
+        "%s%s%d," % (indent, INDENT, lut.low_bit_count),
+        "%s%s%d," % (indent, INDENT, lut.high_bit_count),
+        "%s%s%s_rows," % (indent, INDENT, lut.name),
+        "%s%s%s_cells," % (indent, INDENT, lut.name),
+        "%s%s%s_outputs," % (indent, INDENT, lut.name),
+        "%s};" % indent,
+    ]
+    return lines
+
+
+def write_if_changed(path, contents):
+    if os.path.exists(path):
+        with open(path, newline="") as f:
+            if f.read() == contents:
+                return False
+    with open(path, "w", newline="\n") as f:
+        f.write(contents)
+    return True
+
+
+def load_specs():
+    base_conditions = condition_bits()
+    return [
+        Spec(os.path.join(SPEC_DIR, name), base_conditions)
+        for name in sorted(os.listdir(SPEC_DIR))
+        if name.endswith(".json")
+    ]
+
+
+def generate_all(check_only=False):
+    specs = load_specs()
+    os.makedirs(OUTPUT_DIR, exist_ok=True)
+    stale = []
+    for spec in specs:
+        path = os.path.join(OUTPUT_DIR, spec.header_name)
+        contents = generate_header(spec)
+        if check_only:
+            if not os.path.exists(path) or open(path, newline="").read() != contents:
+                stale.append(path)
+        elif write_if_changed(path, contents):
+            print("Generated %s" % os.path.relpath(path, PROJECT_DIR))
+    return specs, stale
+
+
+def direction_conditions(bits, x, y, cx, cy):
+    """The conditions that ControllerMode::StickConditions() derives from the stick directions."""
+    conditions = 0
+    for name, held in (
+        ("HORIZONTAL", x != 0),
+        ("VERTICAL", y != 0),
+        ("DIAGONAL", x != 0 and y != 0),
+        ("X_NEGATIVE", x == -1),
+        ("Y_NEGATIVE", y == -1),
+        ("C_HORIZONTAL", cx != 0),
+        ("C_VERTICAL", cy != 0),
+        ("C_Y_NEGATIVE", cy == -1),
+    ):
+        if held:
+            conditions |= bits[name]
+    return conditions
+
+
+def test_cases(spec, rng):
+    """Condition words and stick directions to check, with the outputs the spec says to expect."""
+    bits = spec.conditions
+    direction_mask = direction_conditions(bits, -1, -1, 1, -1)
+    other_bits = sorted(bit for bit in set(bits.values()) if not bit & direction_mask)
+    directions = list(itertools.product((-1, 0, 1), repeat=4))
+    cases = []
+
+    def add(conditions):
+        # Only combinations of directions that could really happen, as the lookup tables don't hold
+        # the others.
+        possible = [
+            d
+            for d in directions
+            if direction_conditions(bits, *d) == conditions & direction_mask
+        ]
+        if not possible:
+            return
+        x, y, cx, cy = rng.choice(possible)
+        signs = {"X": x, "Y": y, "CX": cx, "CY": cy, "POSITIVE": 1}
+        outputs = spec.evaluate(conditions, signs)
+        cases.append((conditions, x, y, cx, cy, outputs))
+
+    def add_with_directions(conditions, mask):
+        # Fill in any direction conditions that the rule doesn't care about at random.
+        d = rng.choice(directions)
+        conditions |= direction_conditions(bits, *d) & ~mask
+        for implied, sources in DERIVED_CONDITIONS.items():
+            if conditions & bits[implied]:
+                conditions |= sum(bits[source] for source in sources)
+        for dependent, parent in DEPENDENT_CONDITIONS.items():
+            if conditions & bits[dependent]:
+                conditions |= bits[parent]
+        add(conditions)
+
+    # Every rule on its own, then every rule with one of its exclusions also held.
+    for rule in spec.rules:
+        mask = rule.when_mask | rule.unless_mask
+        for _ in range(4):
+            add_with_directions(rule.when_mask, mask)
+            for name in rule.unless:
+                add_with_directions(rule.when_mask | bits[name], mask)
+    for _ in range(RANDOM_TEST_CASES):
+        conditions = direction_conditions(bits, *rng.choice(directions))
+        for bit in other_bits:
+            if rng.random() < 0.4:
+                conditions |= bit
+        add(conditions)
+    return cases
+
+
+def check_luts(spec, cases):
+    """Checks the lookup tables against the rules before they go anywhere near a compiler."""
+    for conditions, x, y, cx, cy, expected in cases:
+        signs = {"X": x, "Y": y, "CX": cx, "CY": cy, "POSITIVE": 1}
+        outputs = {"LEFT_X": 128, "LEFT_Y": 128, "RIGHT_X": 128, "RIGHT_Y": 128}
+        for lut in spec.luts:
+            lut.evaluate(conditions, signs, outputs)
+        if outputs != expected:
+            raise SpecError(
+                "%s: lookup tables disagree with the rules for conditions 0x%08x"
+                % (spec.path, conditions)
+            )
+
+
+def generate_test(specs):
+    rng = random.Random(0)
+    lines = [
+        "// Generated by builder_scripts/mode_tables.py --test. Checks the generated stick rule",
+        "// tables and lookup tables against the specs they were generated from.",
+        "",
+        '#include "core/ControllerMode.hpp"',
+    ]
+    lines += ['#include "modes/generated/%s"' % spec.header_name for spec in specs]
+    lines += [
+        "",
+        "#include <stdio.h>",
+        "",
+        "typedef struct {",
+        "    uint32_t conditions;",
+        "    int8_t x, y, cx, cy;",
+        "    uint8_t left_x, left_y, right_x, right_y;",
+        "} TestCase;",
+        "",
+        "class RuleTester : public ControllerMode {",
+        "  public:",
+        "    int Run(",
+        "        const char *mode,",
+        "        const stick_rules::StickRule *rules,",
+        "        size_t rule_count,",
+        "        const stick_rules::StickLut *left_lut,",
+        "        const stick_rules::StickLut *right_lut,",
+        "        const TestCase *cases,",
+        "        size_t case_count",
+        "    ) {",
+        "        int failures = 0;",
+        "        for (size_t i = 0; i < case_count; i++) {",
+        "            const TestCase &c = cases[i];",
+        "            directions.x = c.x;",
+        "            directions.y = c.y;",
+        "            directions.cx = c.cx;",
+        "            directions.cy = c.cy;",
+        "",
+        "            OutputState rule_outputs;",
+        "            ApplyStickRules(rules, rule_count, c.conditions, 128, rule_outputs);",
+        "            if (!Matches(c, rule_outputs)) {",
+        '                printf("%s: case %u failed with rules\\n", mode, (unsigned)i);',
+        "                failures++;",
+        "            }",
+        "",
+        "            OutputState lut_outputs;",
+        "            if (left_lut != nullptr) {",
+        "                ApplyStickLut(left_lut, c.conditions, 128, lut_outputs);",
+        "            }",
+        "            if (right_lut != nullptr) {",
+        "                ApplyStickLut(right_lut, c.conditions, 128, lut_outputs);",
+        "            }",
+        "            if (!Matches(c, lut_outputs)) {",
+        '                printf("%s: case %u failed with lookup tables\\n", mode, (unsigned)i);',
+        "                failures++;",
+        "            }",
+        "        }",
+        '        printf("%s: %u cases, %d failures\\n", mode, (unsigned)case_count, failures);',
+        "        return failures;",
+        "    }",
+        "",
+        "  private:",
+        "    bool Matches(const TestCase &c, const OutputState &outputs) {",
+        "        return outputs.leftStickX == c.left_x && outputs.leftStickY == c.left_y &&",
+        "               outputs.rightStickX == c.right_x && outputs.rightStickY == c.right_y;",
+        "    }",
+        "",
+        "    void UpdateDigitalOutputs(InputState &inputs, OutputState &outputs) {}",
+        "    void UpdateAnalogOutputs(InputState &inputs, OutputState &outputs) {}",
+        "};",
+        "",
+    ]
+    for spec in specs:
+        cases = test_cases(spec, rng)
+        check_luts(spec, cases)
+        lines.append("static const TestCase %s_cases[] = {" % spec.namespace)
+        for conditions, x, y, cx, cy, o in cases:
+            lines.append(
+                "    { 0x%08xUL, %d, %d, %d, %d, %d, %d, %d, %d },"
+                % (
+                    conditions,
+                    x,
+                    y,
+                    cx,
+                    cy,
+                    o["LEFT_X"],
+                    o["LEFT_Y"],
+                    o["RIGHT_X"],
+                    o["RIGHT_Y"],
+                )
+            )
+        lines += ["};", ""]
+    lines += ["int main() {", "    RuleTester tester;", "    int failures = 0;"]
+    for spec in specs:
+        namespace = "stick_rules::%s::" % spec.namespace
+        table = namespace + "analog_rules"
+        luts = {lut.stick: "&" + namespace + lut.name for lut in spec.luts}
+        lines += [
+            "    failures += tester.Run(",
+            '        "%s",' % spec.mode,
+            "        %s," % table,
+            "        sizeof(%s) / sizeof(%s[0])," % (table, table),
+            "        %s," % luts.get("left", "nullptr"),
+            "        %s," % luts.get("right", "nullptr"),
+            "        %s_cases," % spec.namespace,
+            "        sizeof(%s_cases) / sizeof(%s_cases[0])" % (spec.namespace, spec.namespace),
+            "    );",
+        ]
+    lines += ["    return failures != 0;", "}", ""]
+    return "\n".join(lines)
+
+
+def run_test(specs):
+    # Only needed when run directly, where builder_scripts is on the path.
+    import host_build
+
+    files = {"test_mode_tables.cpp": generate_test(specs)}
+    sources = [
+        "src/core/ControllerMode.cpp",
+        "src/core/FrameClock.cpp",
+        "src/core/InputMode.cpp",
+        "src/core/socd.cpp",
+    ]
+    return host_build.run("test_mode_tables", files, sources)
+
+
+def main(argv):
+    check_only = "--check" in argv
+    try:
+        specs, stale = generate_all(check_only)
+    except SpecError as e:
+        print("Error: %s" % e)
+        return 1
+    if stale:
+        for path in stale:
+            print("Out of date: %s" % os.path.relpath(path, PROJECT_DIR))
+        return 1
+    if "--test" in argv:
+        if run_test(specs) != 0:
+            return 1
+    return 0
+
+
+if env is None:
+    sys.exit(main(sys.argv[1:]))
+
+try:
+    generate_all()
+except SpecError as e:
+    sys.stderr.write("Error: %s\n" % e)
+    env.Exit(1)
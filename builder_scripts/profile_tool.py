@@ -0,0 +1,455 @@
+"""
+Checks and packs controller profiles (see include/core/Profile.hpp), which let each player have
+their own pin mapping, SOCD pairs, default mode and mode options without a firmware build of their
+own. A profile is written as JSON, like config/pico/profile.json:
+
+    python builder_scripts/profile_tool.py validate my_profile.json
+
+Pack it into a UF2 file, then drag that onto the Pico in bootsel mode the same as a firmware update.
+It only writes to the flash set aside for the profile, so the firmware and saved settings are left
+alone. A .bin output gets the raw profile instead.
+
+    python builder_scripts/profile_tool.py pack my_profile.json my_profile.uf2
+    python builder_scripts/profile_tool.py pack my_profile.json my_profile.uf2 --flash-size 16
+
+Check that the firmware reads packed profiles the same as this tool writes them:
+
+    python builder_scripts/profile_tool.py check
+
+The check builds a small program on the host, so it needs a C++ compiler ($CXX, or c++ by default).
+"""
+
+import argparse
+import json
+import os
+import re
+import struct
+import subprocess
+import sys
+import tempfile
+import zlib
+
+import host_build
+
+PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+PROFILE_MAGIC = b"HBPF"
+PROFILE_VERSION = 1
+PROFILE_HEADER_SIZE = 16
+PROFILE_NAME_SIZE = 16
+PROFILE_NO_MODE = 0xFF
+MAX_SOCD_PAIRS = 4
+
+# Pins that can be used for buttons on an RP2040.
+GPIO_PIN_COUNT = 30
+# Pins that config/pico/config.cpp already uses, which the firmware refuses to put buttons on.
+RESERVED_PINS = {25: "the LED", 28: "the Joybus data pin"}
+
+# What config/mode_selection.hpp uses when there's no profile.
+OPTION_DEFAULTS = {
+    "crouch_walk_os": False,
+    "true_z_press": False,
+    "ledgedash_max_jump_traj": True,
+    "z_press_macro": False,
+}
+
+# The profile sits in the flash sector before the two settings banks (see
+# HAL/pico/include/storage.hpp).
+FLASH_BASE = 0x10000000
+FLASH_SECTOR_SIZE = 4096
+PROFILE_FLASH_OFFSET_FROM_END = 3 * FLASH_SECTOR_SIZE
+
+UF2_MAGIC_START0 = 0x0A324655
+UF2_MAGIC_START1 = 0x9E5D5157
+UF2_MAGIC_END = 0x0AB16F30
+UF2_FLAG_FAMILY_ID_PRESENT = 0x00002000
+UF2_FAMILY_RP2040 = 0xE48BFF56
+UF2_PAYLOAD_SIZE = 256
+
+
+def read_source(*path):
+    with open(os.path.join(PROJECT_DIR, *path)) as f:
+        return f.read()
+
+
+def enum_values(source, pattern):
+    """Names in the body of the enum matched by pattern, in order, including any behind #ifdef."""
+    body = re.search(pattern + r"\s*{([^}]*)}", source).group(1)
+    body = re.sub(r"(//|#)[^\n]*", "", body)
+    return [name.strip() for name in body.split(",") if name.strip()]
+
+
+def buttons():
+    """Rectangle inputs in InputState order, from left to mod_y."""
+    source = read_source("include", "core", "state.hpp")
+    names = re.findall(r"^\s*bool (\w+) = false;", source, re.MULTILINE)
+    return names[names.index("left") : names.index("mod_y") + 1]
+
+
+def modes():
+    source = read_source("config", "mode_selection.hpp")
+    return [name.lower() for name in enum_values(source, r"enum class ModeId : uint16_t")]
+
+
+def socd_types():
+    source = read_source("include", "core", "socd.hpp")
+    names = enum_values(source, r"typedef enum")
+    return [name[len("SOCD_") :].lower() for name in names]
+
+
+def options():
+    """Option bits by name, e.g. crouch_walk_os for PROFILE_OPTION_CROUCH_WALK_OS."""
+    source = read_source("include", "core", "Profile.hpp")
+    return {
+        name.lower(): 1 << int(bit)
+        for name, bit in re.findall(r"#define PROFILE_OPTION_(\w+) \(1 << (\d+)\)", source)
+    }
+
+
+def validate(profile):
+    """Returns a list of everything wrong with the profile, which is empty if it's fine."""
+    errors = []
+    button_names = buttons()
+    known = {"name", "mode", "options", "buttons", "socd_pairs"}
+    errors += ["unknown setting '%s'" % key for key in profile if key not in known]
+
+    name = profile.get("name", "")
+    if not isinstance(name, str) or not name.isascii() or len(name) >= PROFILE_NAME_SIZE:
+        errors.append("name must be ASCII and at most %d characters" % (PROFILE_NAME_SIZE - 1))
+
+    mode = profile.get("mode")
+    if mode is not None and mode not in modes():
+        errors.append("unknown mode '%s' (one of %s)" % (mode, ", ".join(modes())))
+
+    option_bits = options()
+    for option, value in profile.get("options", {}).items():
+        if option not in option_bits:
+            errors.append("unknown option '%s'" % option)
+        elif not isinstance(value, bool):
+            errors.append("option '%s' must be true or false" % option)
+
+    pins = {}
+    for button, pin in profile.get("buttons", {}).items():
+        if button not in button_names:
+            errors.append("unknown button '%s'" % button)
+        if not isinstance(pin, int) or not 0 <= pin < GPIO_PIN_COUNT:
+            errors.append("button '%s' has pin %r, which isn't a GPIO pin" % (button, pin))
+        elif pin in RESERVED_PINS:
+            reserved_for = RESERVED_PINS[pin]
+            errors.append("button '%s' is on pin %d, which is %s" % (button, pin, reserved_for))
+        elif pin in pins:
+            errors.append("buttons '%s' and '%s' are both on pin %d" % (pins[pin], button, pin))
+        else:
+            pins[pin] = button
+    if not profile.get("buttons"):
+        errors.append("no buttons")
+
+    socd_pairs = profile.get("socd_pairs", [])
+    if len(socd_pairs) > MAX_SOCD_PAIRS:
+        errors.append("more than %d SOCD pairs" % MAX_SOCD_PAIRS)
+    for pair in socd_pairs:
+        if not isinstance(pair, list) or len(pair) != 3:
+            errors.append("SOCD pair %r should be [direction 1, direction 2, type]" % (pair,))
+            continue
+        dir1, dir2, socd_type = pair
+        for direction in (dir1, dir2):
+            if direction not in button_names:
+                errors.append("unknown button '%s' in SOCD pair" % direction)
+        if dir1 == dir2:
+            errors.append("SOCD pair has '%s' on both sides" % dir1)
+        if socd_type not in socd_types():
+            errors.append(
+                "unknown SOCD type '%s' (one of %s)" % (socd_type, ", ".join(socd_types()))
+            )
+    return errors
+
+
+def usable_pins():
+    """The pins that buttons can be on, as the bit mask that Profile::Open() takes."""
+    return sum(1 << pin for pin in range(GPIO_PIN_COUNT) if pin not in RESERVED_PINS)
+
+
+def pack(profile):
+    """The profile in the format that the firmware reads."""
+    button_names = buttons()
+    option_bits = options()
+
+    mode = profile.get("mode")
+    option_values = dict(OPTION_DEFAULTS, **profile.get("options", {}))
+    flags = sum(option_bits[name] for name, value in option_values.items() if value)
+
+    body = profile.get("name", "").encode("ascii").ljust(PROFILE_NAME_SIZE, b"\0")
+    for button, pin in profile["buttons"].items():
+        body += bytes([button_names.index(button), pin])
+    for dir1, dir2, socd_type in profile.get("socd_pairs", []):
+        body += bytes(
+            [button_names.index(dir1), button_names.index(dir2), socd_types().index(socd_type), 0]
+        )
+
+    header = PROFILE_MAGIC + bytes(
+        [
+            PROFILE_VERSION,
+            len(profile["buttons"]),
+            len(profile.get("socd_pairs", [])),
+            modes().index(mode) if mode is not None else PROFILE_NO_MODE,
+        ]
+    )
+    header += struct.pack("<HH", PROFILE_HEADER_SIZE + len(body), flags)
+    return header + struct.pack("<I", zlib.crc32(header + body)) + body
+
+
+def to_uf2(data, address):
+    """UF2 blocks that write data to flash at address, padded out with 0xFF to whole pages."""
+    data += b"\xff" * (-len(data) % UF2_PAYLOAD_SIZE)
+    block_count = len(data) // UF2_PAYLOAD_SIZE
+    blocks = b""
+    for i in range(block_count):
+        payload = data[i * UF2_PAYLOAD_SIZE : (i + 1) * UF2_PAYLOAD_SIZE]
+        header = struct.pack(
+            "<8I",
+            UF2_MAGIC_START0,
+            UF2_MAGIC_START1,
+            UF2_FLAG_FAMILY_ID_PRESENT,
+            address + i * UF2_PAYLOAD_SIZE,
+            UF2_PAYLOAD_SIZE,
+            i,
+            block_count,
+            UF2_FAMILY_RP2040,
+        )
+        blocks += header + payload.ljust(476, b"\0") + struct.pack("<I", UF2_MAGIC_END)
+    return blocks
+
+
+def load(path):
+    with open(path) as f:
+        return json.load(f)
+
+
+def validate_files(paths):
+    ok = True
+    for path in paths:
+        errors = validate(load(path))
+        for error in errors:
+            print("%s: %s" % (path, error))
+        if not errors:
+            print("%s: OK" % path)
+        ok &= not errors
+    return 0 if ok else 1
+
+
+def pack_file(path, output, flash_size_mb):
+    profile = load(path)
+    errors = validate(profile)
+    if errors:
+        for error in errors:
+            print("%s: %s" % (path, error))
+        return 1
+
+    data = pack(profile)
+    if output.endswith(".uf2"):
+        flash_size = flash_size_mb * 1024 * 1024
+        data = to_uf2(data, FLASH_BASE + flash_size - PROFILE_FLASH_OFFSET_FROM_END)
+    with open(output, "wb") as f:
+        f.write(data)
+    print("Packed %s into %s" % (path, output))
+    return 0
+
+
+# Prints what the firmware reads from each profile file given, or INVALID.
+CHECK_SOURCE = r"""
+#include "core/Profile.hpp"
+
+#include <stdio.h>
+
+int main(int argc, char **argv) {
+    for (int i = 1; i < argc; i++) {
+        static uint8_t data[4096];
+        FILE *file = fopen(argv[i], "rb");
+        size_t size = fread(data, 1, sizeof(data), file);
+        fclose(file);
+
+        InputState inputs;
+        Profile profile;
+        if (!profile.Open(data, size, USABLE_PINS)) {
+            printf("INVALID\n");
+            continue;
+        }
+        printf("%s|%d|%d|", profile.Name(), profile.DefaultMode(), profile.Option(0xFFFF));
+        for (uint16_t bit = 1; bit != 0; bit <<= 1) {
+            printf("%d", profile.Option(bit));
+        }
+        printf("|");
+        for (size_t j = 0; j < profile.ButtonCount(); j++) {
+            printf("%d:%d,", profile.ButtonInput(j), profile.ButtonPin(j));
+        }
+        printf("|");
+        for (size_t j = 0; j < profile.SocdPairCount(); j++) {
+            socd::SocdPair pair = profile.SocdPair(j);
+            printf(
+                "%d:%d:%d,",
+                (int)button_index(inputs, pair.input_dir1),
+                (int)button_index(inputs, pair.input_dir2),
+                pair.socd_type
+            );
+        }
+        printf("\n");
+    }
+    return 0;
+}
+"""
+
+
+def expected_reading(profile):
+    """What the check program should print for a valid profile."""
+    button_names = buttons()
+    option_bits = options()
+    option_values = dict(OPTION_DEFAULTS, **profile.get("options", {}))
+    flags = sum(option_bits[name] for name, value in option_values.items() if value)
+    mode = profile.get("mode")
+    fields = [
+        profile.get("name", ""),
+        str(modes().index(mode) if mode is not None else PROFILE_NO_MODE),
+        str(int(flags != 0)),
+        "".join(str((flags >> bit) & 1) for bit in range(16)),
+        "".join(
+            "%d:%d," % (button_names.index(button), pin)
+            for button, pin in profile["buttons"].items()
+        ),
+        "".join(
+            "%d:%d:%d,"
+            % (button_names.index(dir1), button_names.index(dir2), socd_types().index(socd_type))
+            for dir1, dir2, socd_type in profile.get("socd_pairs", [])
+        ),
+    ]
+    return "|".join(fields)
+
+
+def check():
+    failures = 0
+    example = load(os.path.join(PROJECT_DIR, "config", "pico", "profile.json"))
+    profiles = {
+        "example": example,
+        "everything": {
+            "name": "Everything set",
+            "mode": modes()[-1],
+            "options": {name: True for name in options()},
+            "buttons": {name: pin for pin, name in enumerate(buttons())},
+            "socd_pairs": [
+                ["left", "right", socd_types()[i % len(socd_types())]]
+                for i in range(MAX_SOCD_PAIRS)
+            ],
+        },
+        "minimal": {"buttons": {"a": 29}},
+    }
+
+    # Things the tool has to refuse.
+    bad_profiles = {
+        "unknown button": {"buttons": {"turbo": 1}},
+        "shared pin": {"buttons": {"a": 1, "b": 1}},
+        "bad pin": {"buttons": {"a": 30}},
+        "LED pin": {"buttons": {"a": 25}},
+        "Joybus pin": {"buttons": {"a": 28}},
+        "long name": {"name": "x" * PROFILE_NAME_SIZE, "buttons": {"a": 1}},
+        "unknown mode": {"mode": "brawl", "buttons": {"a": 1}},
+        "unknown option": {"options": {"turbo": True}, "buttons": {"a": 1}},
+        "too many SOCD pairs": {
+            "buttons": {"a": 1},
+            "socd_pairs": [["left", "right", "2ip"]] * (MAX_SOCD_PAIRS + 1),
+        },
+        "bad SOCD type": {"buttons": {"a": 1}, "socd_pairs": [["left", "right", "first"]]},
+    }
+    for what, profile in bad_profiles.items():
+        if not validate(profile):
+            print("FAILED: %s profile passed validation" % what)
+            failures += 1
+
+    with tempfile.TemporaryDirectory() as build_dir:
+        executable = host_build.build(
+            build_dir,
+            "check_profile",
+            {"check_profile.cpp": CHECK_SOURCE},
+            ["src/core/Profile.cpp"],
+            ["-D", "USABLE_PINS=%dUL" % usable_pins()],
+        )
+
+        files = []
+        expected = []
+        for what, profile in profiles.items():
+            errors = validate(profile)
+            if errors:
+                print("FAILED: %s profile: %s" % (what, "; ".join(errors)))
+                failures += 1
+                continue
+            files.append((what, pack(profile)))
+            expected.append(expected_reading(profile))
+
+        # Damaged profiles that the firmware has to refuse.
+        data = pack(example)
+        files.append(("flipped bit", data[:40] + bytes([data[40] ^ 1]) + data[41:]))
+        expected.append("INVALID")
+        files.append(("cut short", data[:-1]))
+        expected.append("INVALID")
+        files.append(("erased flash", b"\xff" * len(data)))
+        expected.append("INVALID")
+        newer = bytearray(data)
+        newer[4] = PROFILE_VERSION + 1
+        newer[12:16] = struct.pack("<I", zlib.crc32(bytes(newer[:12] + newer[16:])))
+        files.append(("newer version", bytes(newer)))
+        expected.append("INVALID")
+
+        # Pins that the tool refuses, but that could still be uploaded over serial.
+        for pin in [GPIO_PIN_COUNT, 255] + sorted(RESERVED_PINS):
+            files.append(("pin %d" % pin, pack({"buttons": {"a": 1, "b": pin}})))
+            expected.append("INVALID")
+
+        paths = []
+        for i, (what, data) in enumerate(files):
+            paths.append(os.path.join(build_dir, "profile%d.bin" % i))
+            with open(paths[-1], "wb") as f:
+                f.write(data)
+        result = subprocess.run([executable] + paths, capture_output=True, text=True, check=True)
+        readings = result.stdout.splitlines()
+        if len(readings) != len(files):
+            print("FAILED: read %d profiles, expected %d" % (len(readings), len(files)))
+            failures += 1
+        for (what, _), want, got in zip(files, expected, readings):
+            if got != want:
+                print("FAILED: %s profile read as %s, expected %s" % (what, got, want))
+                failures += 1
+
+    # The UF2 file has to land in the profile sector, a page per block.
+    uf2 = to_uf2(pack(profiles["everything"]), 0x101FD000)
+    if len(uf2) % 512 != 0 or struct.unpack_from("<I", uf2, 12)[0] != 0x101FD000:
+        print("FAILED: UF2 layout")
+        failures += 1
+
+    print("Profiles: %s" % ("OK" if failures == 0 else "FAILED"))
+    return failures != 0
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description="Check and pack controller profiles.")
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    validate_parser = commands.add_parser("validate", help="check profiles for mistakes")
+    validate_parser.add_argument("profiles", nargs="+")
+
+    pack_parser = commands.add_parser("pack", help="pack a profile into a .uf2 or .bin file")
+    pack_parser.add_argument("profile")
+    pack_parser.add_argument("output")
+    pack_parser.add_argument(
+        "--flash-size", type=int, default=2, help="flash size of the board in MB (default 2)"
+    )
+
+    commands.add_parser("check", help="check that the firmware reads profiles correctly")
+
+    args = parser.parse_args(argv)
+    if args.command == "validate":
+        return validate_files(args.profiles)
+    if args.command == "pack":
+        return pack_file(args.profile, args.output, args.flash_size)
+    return check()
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
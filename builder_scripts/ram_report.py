@@ -0,0 +1,67 @@
+import os
+import subprocess
+
+Import("env")
+
+# Number of individual symbols to list, largest first.
+TOP_SYMBOLS = 15
+
+# nm symbol types that end up in RAM (initialised data and bss, global or local).
+RAM_SYMBOL_TYPES = ("b", "B", "d", "D")
+
+
+def tool(name):
+    # Derive e.g. avr-size from avr-gcc so this works for any toolchain.
+    cc = env.subst("$CC")
+    return os.path.join(os.path.dirname(cc), os.path.basename(cc).replace("gcc", name))
+
+
+def section_sizes(elf):
+    output = subprocess.run(
+        [tool("size"), "-A", elf], capture_output=True, text=True, check=True
+    ).stdout
+    sizes = {}
+    for line in output.splitlines():
+        fields = line.split()
+        if len(fields) >= 2 and fields[0].startswith(".") and fields[1].isdigit():
+            sizes[fields[0]] = int(fields[1])
+    return sizes
+
+
+def ram_symbols(elf):
+    output = subprocess.run(
+        [tool("nm"), "--size-sort", "--reverse-sort", "--print-size", "-C", elf],
+        capture_output=True,
+        text=True,
+        check=True,
+    ).stdout
+    symbols = []
+    for line in output.splitlines():
+        fields = line.split(maxsplit=3)
+        if len(fields) == 4 and fields[2] in RAM_SYMBOL_TYPES:
+            symbols.append((int(fields[1], 16), fields[3]))
+    return symbols
+
+
+def ram_report(source, target, env):
+    elf = str(target[0])
+    sizes = section_sizes(elf)
+    static_ram = sum(size for name, size in sizes.items() if name.startswith((".data", ".bss")))
+    max_ram = int(env.BoardConfig().get("upload.maximum_ram_size", 0))
+
+    print()
+    if max_ram > 0:
+        print(
+            "Static RAM usage: %d of %d bytes (%.1f%%), leaving %d bytes for the stack"
+            % (static_ram, max_ram, 100.0 * static_ram / max_ram, max_ram - static_ram)
+        )
+    else:
+        print("Static RAM usage: %d bytes" % static_ram)
+
+    print("Largest RAM symbols:")
+    for size, name in ram_symbols(elf)[:TOP_SYMBOLS]:
+        print("  %6d  %s" % (size, name))
+    print()
+
+
+env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", ram_report)
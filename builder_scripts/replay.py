@@ -0,0 +1,421 @@
+"""
+Replays inputs recorded by InputRecorder (src/core/InputRecorder.cpp) through a controller mode on
+the host, so that a misinput can be reproduced exactly or a mode's UpdateOutputs() timed.
+
+Save the inputs from a controller over USB serial (needs pyserial):
+
+    python builder_scripts/replay.py dump /dev/ttyACM0 capture.bin
+
+Print the outputs the mode gives for every report as CSV, or time how long the mode takes:
+
+    python builder_scripts/replay.py run capture.bin melee20button
+    python builder_scripts/replay.py run capture.bin ultimate --socd 2ip_no_reac --bench
+
+Check the recorder and replay every mode with made up inputs:
+
+    python builder_scripts/replay.py check
+
+Builds a small program on the host, so it needs a C++ compiler ($CXX, or c++ by default).
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+
+import host_build
+
+CAPTURE_HEADER_SIZE = 12
+
+# Controller modes that can be replayed, along with the SOCD type that config/mode_selection.hpp
+# uses for them. Keyboard modes are left out as they need the USB HID library.
+MODES = {
+    "melee20button": ("Melee20Button", "modes/Melee20Button.hpp", "SOCD_2IP_NO_REAC"),
+    "melee18button": ("Melee18Button", "modes/Melee18Button.hpp", "SOCD_2IP_NO_REAC"),
+    "projectm": ("ProjectM", "modes/ProjectM.hpp", "SOCD_2IP_NO_REAC"),
+    "ultimate": ("Ultimate", "modes/Ultimate.hpp", "SOCD_2IP"),
+    "ultimater4": ("UltimateR4", "modes/UltimateR4.hpp", "SOCD_2IP"),
+    "ultimate2": ("Ultimate2", "modes/extra/Ultimate2.hpp", "SOCD_2IP"),
+    "fgc": ("FgcMode", "modes/FgcMode.hpp", "SOCD_NEUTRAL"),
+    "rivalsofaether": ("RivalsOfAether", "modes/RivalsOfAether.hpp", "SOCD_2IP"),
+    "rivals2": ("Rivals2", "modes/Rivals2.hpp", "SOCD_2IP"),
+    "darksouls": ("DarkSouls", "modes/extra/DarkSouls.hpp", "SOCD_2IP"),
+    "hollowknight": ("HollowKnight", "modes/extra/HollowKnight.hpp", "SOCD_2IP"),
+    "mkwii": ("MKWii", "modes/extra/MKWii.hpp", "SOCD_2IP"),
+    "multiversus": ("MultiVersus", "modes/extra/MultiVersus.hpp", "SOCD_2IP"),
+    "rocketleague": ("RocketLeague", "modes/extra/RocketLeague.hpp", "SOCD_2IP"),
+    "saltandsanctuary": ("SaltAndSanctuary", "modes/extra/SaltAndSanctuary.hpp", "SOCD_2IP"),
+    "shovelknight": ("ShovelKnight", "modes/extra/ShovelKnight.hpp", "SOCD_2IP"),
+}
+
+SOCD_TYPES = ["neutral", "2ip", "2ip_no_reac", "dir1_priority", "dir2_priority", "none"]
+
+CORE_SOURCES = [
+    "ComboEngine.cpp",
+    "ControllerMode.cpp",
+    "FrameClock.cpp",
+    "InputMode.cpp",
+    "InputRecorder.cpp",
+    "MacroEngine.cpp",
+    "socd.cpp",
+]
+
+REPLAY_SOURCE = r"""
+#include "core/ControllerMode.hpp"
+#include "core/FrameClock.hpp"
+#include "core/InputRecorder.hpp"
+#include "core/socd.hpp"
+#include "core/state.hpp"
+%(includes)s
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+uint32_t host_time_us = 0;
+
+// Time between reports for the last record, which has no next record to go by.
+#define DEFAULT_REPORT_INTERVAL_US 1000
+
+typedef struct {
+    const char *name;
+    ControllerMode *(*create)(socd::SocdType socd_type);
+    socd::SocdType socd_type;
+} ModeEntry;
+
+// Modes can only be constructed in place (see InputMode), like set_mode() does on the controller.
+alignas(16) static uint8_t mode_storage[4096];
+
+template <typename Mode> ControllerMode *create_mode(socd::SocdType socd_type) {
+    static_assert(sizeof(Mode) <= sizeof(mode_storage), "Mode doesn't fit in mode storage");
+    return new (mode_storage) Mode(socd_type);
+}
+
+template <> ControllerMode *create_mode<FgcMode>(socd::SocdType socd_type) {
+    return new (mode_storage) FgcMode(socd_type, socd_type);
+}
+
+static const ModeEntry modes[] = {
+%(modes)s
+};
+
+static const ModeEntry *find_mode(const char *name) {
+    for (size_t i = 0; i < sizeof(modes) / sizeof(modes[0]); i++) {
+        if (strcmp(modes[i].name, name) == 0) {
+            return &modes[i];
+        }
+    }
+    return nullptr;
+}
+
+static uint64_t now_ns() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void print_outputs(FILE *csv, size_t report, uint32_t frame, const OutputState &o) {
+    fprintf(
+        csv,
+        "%%zu,%%lu,%%lu,%%d,%%d,%%d,%%d,%%d,%%d,%%d,%%d,%%d,%%d,%%d,%%d,%%d,%%d,%%d,%%d,%%d,"
+        "%%d,%%d,%%d,%%d,%%d,%%d\n",
+        report,
+        (unsigned long)host_time_us,
+        (unsigned long)frame,
+        o.a,
+        o.b,
+        o.x,
+        o.y,
+        o.buttonL,
+        o.buttonR,
+        o.triggerLDigital,
+        o.triggerRDigital,
+        o.start,
+        o.select,
+        o.home,
+        o.dpadUp,
+        o.dpadDown,
+        o.dpadLeft,
+        o.dpadRight,
+        o.leftStickClick,
+        o.rightStickClick,
+        o.leftStickX,
+        o.leftStickY,
+        o.rightStickX,
+        o.rightStickY,
+        o.triggerLAnalog,
+        o.triggerRAnalog
+    );
+}
+
+/*
+ * Runs every report in the capture through the mode, in the same way that CommunicationBackend
+ * does, and writes the outputs to csv unless it's nullptr. Reports with the same inputs are spread
+ * evenly over the time until the next record.
+ */
+static void replay(
+    const InputRecorder::Record *records,
+    size_t count,
+    ControllerMode *mode,
+    FILE *csv
+) {
+    FrameClock frame_clock;
+    mode->SetFrameClock(&frame_clock);
+
+    InputState raw_inputs;
+    size_t report = 0;
+    uint64_t total_ns = 0;
+    uint64_t max_ns = 0;
+
+    if (csv != nullptr) {
+        fprintf(
+            csv,
+            "report,time_us,frame,a,b,x,y,buttonL,buttonR,triggerLDigital,triggerRDigital,start,"
+            "select,home,dpadUp,dpadDown,dpadLeft,dpadRight,leftStickClick,rightStickClick,"
+            "leftStickX,leftStickY,rightStickX,rightStickY,triggerLAnalog,triggerRAnalog\n"
+        );
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        const InputRecorder::Record &record = records[i];
+        uint32_t interval = DEFAULT_REPORT_INTERVAL_US;
+        if (i + 1 < count) {
+            interval = (records[i + 1].time_us - record.time_us) / record.reports;
+        }
+
+        InputRecorder::Restore(record, raw_inputs);
+        for (uint32_t r = 0; r < record.reports; r++, report++) {
+            host_time_us = record.time_us + r * interval;
+            frame_clock.Update(host_time_us);
+
+            // The mode gets its own copy, like it gets freshly scanned inputs on the controller.
+            InputState inputs = raw_inputs;
+            OutputState outputs;
+
+            uint64_t start = now_ns();
+            mode->UpdateOutputs(inputs, outputs);
+            uint64_t elapsed = now_ns() - start;
+
+            total_ns += elapsed;
+            if (elapsed > max_ns) {
+                max_ns = elapsed;
+            }
+            if (csv != nullptr) {
+                print_outputs(csv, report, frame_clock.Frame(), outputs);
+            }
+        }
+    }
+
+    if (csv == nullptr) {
+        printf(
+            "%%zu reports, %%.1f ns average, %%llu ns max\n",
+            report,
+            report > 0 ? (double)total_ns / report : 0.0,
+            (unsigned long long)max_ns
+        );
+    }
+}
+
+static InputRecorder::Record *load_capture(const char *path, size_t &count) {
+    FILE *file = fopen(path, "rb");
+    if (file == nullptr) {
+        fprintf(stderr, "Can't open %%s\n", path);
+        return nullptr;
+    }
+
+    uint8_t header[INPUT_CAPTURE_HEADER_SIZE];
+    if (fread(header, 1, sizeof(header), file) != sizeof(header) ||
+        memcmp(header, INPUT_CAPTURE_MAGIC, 4) != 0 || header[4] != INPUT_CAPTURE_VERSION ||
+        header[5] != INPUT_CAPTURE_RECORD_SIZE) {
+        fprintf(stderr, "%%s isn't a version %%d input capture\n", path, INPUT_CAPTURE_VERSION);
+        fclose(file);
+        return nullptr;
+    }
+    count = header[8] | (header[9] << 8) | (header[10] << 16) | ((uint32_t)header[11] << 24);
+
+    InputRecorder::Record *records = new InputRecorder::Record[count];
+    uint8_t bytes[INPUT_CAPTURE_RECORD_SIZE];
+    for (size_t i = 0; i < count; i++) {
+        if (fread(bytes, 1, sizeof(bytes), file) != sizeof(bytes)) {
+            fprintf(stderr, "%%s is cut short after %%zu records\n", path, i);
+            count = i;
+            break;
+        }
+        records[i] = InputRecorder::Decode(bytes);
+    }
+    fclose(file);
+    return records;
+}
+
+/* Self check */
+
+static uint8_t dumped[INPUT_CAPTURE_HEADER_SIZE + 64 * INPUT_CAPTURE_RECORD_SIZE];
+static size_t dumped_length = 0;
+
+static void dump_to_memory(uint8_t *bytes, size_t len) {
+    if (dumped_length + len <= sizeof(dumped)) {
+        memcpy(dumped + dumped_length, bytes, len);
+    }
+    dumped_length += len;
+}
+
+static int check() {
+    int failures = 0;
+
+    // More changes than the buffer holds, so that it wraps around.
+    InputRecorder::Record buffer[16];
+    InputRecorder recorder(buffer);
+    InputState inputs;
+    const size_t changes = 40;
+    uint32_t seed = 1;
+    uint32_t expected_buttons[changes];
+    for (size_t i = 0; i < changes; i++) {
+        seed = seed * 1103515245 + 12345;
+        uint32_t buttons = (seed >> 8) & ((1UL << RECTANGLE_INPUT_COUNT) - 1);
+        expected_buttons[i] = buttons;
+        InputRecorder::Record record = { 0, buttons, (int8_t)i, (int8_t)-i, 1 };
+        InputRecorder::Restore(record, inputs);
+        // Three reports with the same inputs each.
+        for (uint32_t r = 0; r < 3; r++) {
+            recorder.Capture(inputs, i * 10000 + r * 1000);
+        }
+    }
+
+    recorder.Dump(dump_to_memory);
+    size_t count = sizeof(buffer) / sizeof(buffer[0]);
+    if (dumped_length != INPUT_CAPTURE_HEADER_SIZE + count * INPUT_CAPTURE_RECORD_SIZE ||
+        memcmp(dumped, INPUT_CAPTURE_MAGIC, 4) != 0 || dumped[8] != count) {
+        printf("FAILED: dump header or length\n");
+        return 1;
+    }
+
+    InputRecorder::Record records[sizeof(buffer) / sizeof(buffer[0])];
+    for (size_t i = 0; i < count; i++) {
+        records[i] = InputRecorder::Decode(
+            dumped + INPUT_CAPTURE_HEADER_SIZE + i * INPUT_CAPTURE_RECORD_SIZE
+        );
+        size_t change = changes - count + i;
+        if (records[i].time_us != change * 10000 || records[i].reports != 3 ||
+            records[i].buttons != expected_buttons[change] ||
+            records[i].nunchuk_x != (int8_t)change || records[i].nunchuk_y != (int8_t)-change) {
+            printf("FAILED: record %%zu\n", i);
+            failures++;
+        }
+    }
+
+    // Every mode should get through the capture.
+    for (size_t i = 0; i < sizeof(modes) / sizeof(modes[0]); i++) {
+        printf("%%s: ", modes[i].name);
+        ControllerMode *mode = modes[i].create(modes[i].socd_type);
+        replay(records, count, mode, nullptr);
+        delete mode;
+    }
+
+    printf("InputRecorder: %%s\n", failures == 0 ? "OK" : "FAILED");
+    return failures != 0;
+}
+
+int main(int argc, char **argv) {
+    if (argc == 2 && strcmp(argv[1], "--check") == 0) {
+        return check();
+    }
+    if (argc < 4) {
+        fprintf(stderr, "Usage: %%s <capture> <mode> <socd type> [--bench]\n", argv[0]);
+        return 2;
+    }
+
+    const ModeEntry *entry = find_mode(argv[2]);
+    if (entry == nullptr) {
+        fprintf(stderr, "Unknown mode %%s\n", argv[2]);
+        return 2;
+    }
+    int socd_type = atoi(argv[3]);
+    bool bench = argc > 4 && strcmp(argv[4], "--bench") == 0;
+
+    size_t count = 0;
+    InputRecorder::Record *records = load_capture(argv[1], count);
+    if (records == nullptr) {
+        return 1;
+    }
+
+    ControllerMode *mode =
+        entry->create(socd_type < 0 ? entry->socd_type : (socd::SocdType)socd_type);
+    replay(records, count, mode, bench ? nullptr : stdout);
+    delete mode;
+    delete[] records;
+    return 0;
+}
+"""
+
+
+def mode_sources():
+    return ["src/" + header[: -len(".hpp")] + ".cpp" for _, header, _ in MODES.values()]
+
+
+def build(build_dir):
+    includes = "\n".join('#include "%s"' % header for _, header, _ in sorted(MODES.values()))
+    modes = "\n".join(
+        '    { "%s", create_mode<%s>, socd::%s },' % (name, cls, socd)
+        for name, (cls, _, socd) in MODES.items()
+    )
+    return host_build.build(
+        build_dir,
+        "replay",
+        {"replay.cpp": REPLAY_SOURCE % {"includes": includes, "modes": modes}},
+        ["src/core/" + name for name in CORE_SOURCES] + mode_sources(),
+    )
+
+
+def dump(port, output):
+    import configurator
+
+    with configurator.open_port(port) as connection:
+        try:
+            data = configurator.dump_inputs(configurator.Connection(connection))
+        except configurator.ProtocolError as e:
+            print("No input capture received from %s: %s" % (port, e))
+            return 1
+
+    with open(output, "wb") as f:
+        f.write(data)
+    count = (len(data) - CAPTURE_HEADER_SIZE) // data[5]
+    print("Saved %d input changes to %s" % (count, output))
+    return 0
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description="Replay recorded inputs through a mode.")
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    dump_parser = commands.add_parser("dump", help="save the inputs recorded by a controller")
+    dump_parser.add_argument("port")
+    dump_parser.add_argument("output")
+
+    run_parser = commands.add_parser("run", help="replay a capture through a mode")
+    run_parser.add_argument("capture")
+    run_parser.add_argument("mode", choices=sorted(MODES))
+    run_parser.add_argument("--socd", choices=SOCD_TYPES, help="defaults to what the mode uses")
+    run_parser.add_argument("--bench", action="store_true", help="time the mode instead")
+
+    commands.add_parser("check", help="check the recorder and replay every mode")
+
+    args = parser.parse_args(argv)
+    if args.command == "dump":
+        return dump(args.port, args.output)
+
+    with tempfile.TemporaryDirectory() as build_dir:
+        executable = build(build_dir)
+        if args.command == "check":
+            return subprocess.run([executable, "--check"]).returncode
+
+        socd_type = SOCD_TYPES.index(args.socd) if args.socd else -1
+        command = [executable, os.path.abspath(args.capture), args.mode, str(socd_type)]
+        if args.bench:
+            command.append("--bench")
+        return subprocess.run(command).returncode
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
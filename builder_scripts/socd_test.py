@@ -0,0 +1,319 @@
+"""
+Checks that the bit-parallel SOCD resolver, socd::resolve(), gives exactly the same results as
+resolving each pair on its own with the per-pair functions in src/core/socd.cpp.
+
+    python builder_scripts/socd_test.py
+
+Builds and runs a small program on the host, so it needs a C++ compiler ($CXX, or c++ by default).
+"""
+
+import sys
+
+import host_build
+
+TEST_SOURCE = r"""
+#include "core/InputMode.hpp"
+#include "core/socd.hpp"
+#include "core/state.hpp"
+
+#include <stdio.h>
+
+using namespace socd;
+
+static const SocdType types[] = {
+    SOCD_NEUTRAL,       SOCD_2IP,           SOCD_2IP_NO_REAC,
+    SOCD_DIR1_PRIORITY, SOCD_DIR2_PRIORITY, SOCD_NONE,
+    SOCD_2IP_TIMESTAMP,
+};
+static const size_t type_count = sizeof(types) / sizeof(types[0]);
+
+static int failures = 0;
+
+static void fail(const char *what) {
+    if (failures < 20) {
+        printf("FAILED: %s\n", what);
+    }
+    failures++;
+}
+
+// Resolves one pair with the per-pair functions, the way InputMode::HandleSocd() used to.
+static void resolve_one(
+    SocdType type,
+    bool &dir1,
+    bool &dir2,
+    uint32_t dir1_time,
+    uint32_t dir2_time,
+    SocdState &state
+) {
+    switch (type) {
+        case SOCD_NEUTRAL:
+            neutral(dir1, dir2);
+            break;
+        case SOCD_2IP:
+            second_input_priority(dir1, dir2, state);
+            break;
+        case SOCD_2IP_NO_REAC:
+            second_input_priority_no_reactivation(dir1, dir2, state);
+            break;
+        case SOCD_DIR1_PRIORITY:
+            dir1_priority(dir1, dir2);
+            break;
+        case SOCD_DIR2_PRIORITY:
+            dir1_priority(dir2, dir1);
+            break;
+        case SOCD_2IP_TIMESTAMP:
+            second_input_priority_timestamp(dir1, dir2, dir1_time, dir2_time, state);
+            break;
+        case SOCD_NONE:
+            break;
+    }
+}
+
+static bool bit(PairMask mask, size_t i) {
+    return mask & (1 << i);
+}
+
+/*
+ * Every combination of SOCD type, state, inputs and press order for two pairs at neighbouring bit
+ * positions, with every other bit set to the given pattern to make sure nothing else is touched.
+ */
+static void check_kernel(PairMask others) {
+    for (size_t a = 0; a < 8; a++) {
+        size_t b = (a + 1) % 8;
+        for (size_t ta = 0; ta < type_count; ta++) {
+            for (size_t tb = 0; tb < type_count; tb++) {
+                PairMasks masks;
+                add_pair(masks, a, types[ta]);
+                add_pair(masks, b, types[tb]);
+                PairMask untouched = ~((1 << a) | (1 << b)) & 0xFF;
+
+                for (uint32_t values = 0; values < (1 << 16); values++) {
+                    // Inputs, state and press order for each pair: dir1, dir2, was1, was2,
+                    // lock1, lock2, dir1 pressed last, dir2 pressed last.
+                    size_t positions[] = { a, b };
+                    PairMask dir1 = others & untouched, dir2 = others & untouched;
+                    PairMask dir1_newer = others, dir2_newer = others;
+                    PairStates states;
+                    states.was_dir1 = states.was_dir2 = others & untouched;
+                    states.lock_dir1 = states.lock_dir2 = others & untouched;
+                    bool expected_dir1[2], expected_dir2[2];
+                    SocdState expected_states[2];
+                    for (size_t p = 0; p < 2; p++) {
+                        uint32_t v = values >> (p * 8);
+                        PairMask m = 1 << positions[p];
+                        expected_dir1[p] = v & 1;
+                        expected_dir2[p] = v & 2;
+                        expected_states[p].was_dir1 = v & 4;
+                        expected_states[p].was_dir2 = v & 8;
+                        expected_states[p].lock_dir1 = v & 16;
+                        expected_states[p].lock_dir2 = v & 32;
+                        dir1 |= expected_dir1[p] ? m : 0;
+                        dir2 |= expected_dir2[p] ? m : 0;
+                        states.was_dir1 |= expected_states[p].was_dir1 ? m : 0;
+                        states.was_dir2 |= expected_states[p].was_dir2 ? m : 0;
+                        states.lock_dir1 |= expected_states[p].lock_dir1 ? m : 0;
+                        states.lock_dir2 |= expected_states[p].lock_dir2 ? m : 0;
+                        uint32_t dir1_time = 1000, dir2_time = 1000;
+                        if (v & 64) {
+                            dir1_time++;
+                        }
+                        if (v & 128) {
+                            dir2_time++;
+                        }
+                        dir1_newer = (dir1_newer & ~m) | (dir1_time > dir2_time ? m : 0);
+                        dir2_newer = (dir2_newer & ~m) | (dir2_time > dir1_time ? m : 0);
+                        resolve_one(
+                            types[p == 0 ? ta : tb],
+                            expected_dir1[p],
+                            expected_dir2[p],
+                            dir1_time,
+                            dir2_time,
+                            expected_states[p]
+                        );
+                    }
+
+                    resolve(dir1, dir2, dir1_newer, dir2_newer, masks, states);
+
+                    for (size_t p = 0; p < 2; p++) {
+                        size_t i = positions[p];
+                        if (bit(dir1, i) != expected_dir1[p] ||
+                            bit(dir2, i) != expected_dir2[p] ||
+                            bit(states.was_dir1, i) != expected_states[p].was_dir1 ||
+                            bit(states.was_dir2, i) != expected_states[p].was_dir2 ||
+                            bit(states.lock_dir1, i) != expected_states[p].lock_dir1 ||
+                            bit(states.lock_dir2, i) != expected_states[p].lock_dir2) {
+                            fail("resolve() differs from the per-pair functions");
+                        }
+                    }
+                    PairMask expected_others = others & untouched;
+                    if ((dir1 & untouched) != expected_others ||
+                        (dir2 & untouched) != expected_others ||
+                        (states.was_dir1 & untouched) != expected_others ||
+                        (states.was_dir2 & untouched) != expected_others ||
+                        (states.lock_dir1 & untouched) != expected_others ||
+                        (states.lock_dir2 & untouched) != expected_others) {
+                        fail("resolve() changed a pair it wasn't given");
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Pair lists used by the modes, including ones where pairs share buttons.
+#define BUTTON(name) &InputState::name
+typedef bool InputState::*Button;
+
+static const Button buttons[] = {
+    BUTTON(left), BUTTON(right), BUTTON(down), BUTTON(up), BUTTON(c_left), BUTTON(c_right),
+    BUTTON(c_down), BUTTON(c_up), BUTTON(l), BUTTON(mod_x), BUTTON(mod_y),
+};
+static const size_t button_count = sizeof(buttons) / sizeof(buttons[0]);
+
+class TestMode : public InputMode {
+  public:
+    template <size_t N> void Configure(const SocdPair (&pairs)[N]) {
+        SetSocdPairs(pairs);
+        for (size_t i = 0; i < N; i++) {
+            _reference_states[i] = SocdState();
+        }
+    }
+
+    void Resolve(InputState &inputs) { HandleSocd(inputs); }
+
+    void Reference(InputState &inputs) {
+        for (size_t i = 0; i < _socd_pair_count; i++) {
+            const SocdPair &pair = _socd_pairs[i];
+            resolve_one(
+                pair.socd_type,
+                inputs.*(pair.input_dir1),
+                inputs.*(pair.input_dir2),
+                inputs.press_times[button_index(inputs, pair.input_dir1)],
+                inputs.press_times[button_index(inputs, pair.input_dir2)],
+                _reference_states[i]
+            );
+        }
+    }
+
+  private:
+    SocdState _reference_states[MAX_SOCD_PAIRS];
+};
+
+static void set_buttons(InputState &inputs, uint32_t pressed, const uint32_t *press_times) {
+    for (size_t i = 0; i < button_count; i++) {
+        inputs.*(buttons[i]) = pressed & (1 << i);
+        inputs.press_times[button_index(inputs, buttons[i])] = press_times[i];
+    }
+}
+
+static bool same(const InputState &a, const InputState &b) {
+    for (size_t i = 0; i < button_count; i++) {
+        if (a.*(buttons[i]) != b.*(buttons[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Runs the same sequence of inputs through HandleSocd() and the per-pair reference.
+template <size_t N> static bool check_mode(const SocdPair (&pairs)[N]) {
+    TestMode mode, reference;
+    mode.Configure(pairs);
+    reference.Configure(pairs);
+
+    uint32_t pressed = 0;
+    uint32_t press_times[button_count] = {};
+    uint32_t seed = 1;
+    for (uint32_t step = 0; step < 200000; step++) {
+        // Press or release one button at a time, so that presses overlap in every order. Every so
+        // often, a second button changes at the same time, so that press times can tie.
+        for (int changes = 0; changes < 2; changes++) {
+            seed = seed * 1103515245 + 12345;
+            size_t button = (seed >> 16) % button_count;
+            pressed ^= 1 << button;
+            press_times[button] = step;
+            if ((seed >> 8) % 4 != 0) {
+                break;
+            }
+        }
+        if (step % 256 == 0) {
+            pressed = 0;
+        }
+        InputState a, b;
+        set_buttons(a, pressed, press_times);
+        set_buttons(b, pressed, press_times);
+        mode.Resolve(a);
+        reference.Reference(b);
+        if (!same(a, b)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Tries the pairs with every SOCD type, both all the same and all different.
+template <size_t N> static void check_pairs(const char *name, SocdPair (&pairs)[N]) {
+    int before = failures;
+    for (size_t t = 0; t < type_count; t++) {
+        for (size_t i = 0; i < N; i++) {
+            pairs[i].socd_type = types[t];
+        }
+        if (!check_mode(pairs)) {
+            fail(name);
+        }
+        for (size_t i = 0; i < N; i++) {
+            pairs[i].socd_type = types[(t + i) % type_count];
+        }
+        if (!check_mode(pairs)) {
+            fail(name);
+        }
+    }
+    printf("%s: %s\n", name, failures == before ? "OK" : "FAILED");
+}
+
+int main() {
+    check_kernel(0x00);
+    check_kernel(0xFF);
+    check_kernel(0xA5);
+    printf("resolve(): %s\n", failures == 0 ? "OK" : "FAILED");
+
+    SocdPair standard[] = {
+        SocdPair{ &InputState::left,   &InputState::right },
+        SocdPair{ &InputState::down,   &InputState::up },
+        SocdPair{ &InputState::c_left, &InputState::c_right },
+        SocdPair{ &InputState::c_down, &InputState::c_up },
+    };
+    check_pairs("Standard pairs", standard);
+
+    SocdPair fgc[] = {
+        SocdPair{ &InputState::left,  &InputState::right },
+        SocdPair{ &InputState::mod_x, &InputState::c_up },
+        SocdPair{ &InputState::down,  &InputState::mod_x },
+        SocdPair{ &InputState::down,  &InputState::c_up },
+    };
+    check_pairs("FgcMode pairs", fgc);
+
+    SocdPair mkwii[] = {
+        SocdPair{ &InputState::left, &InputState::right },
+        SocdPair{ &InputState::l,    &InputState::down },
+        SocdPair{ &InputState::l,    &InputState::mod_x },
+        SocdPair{ &InputState::l,    &InputState::mod_y },
+    };
+    check_pairs("MKWii pairs", mkwii);
+
+    return failures != 0;
+}
+"""
+
+
+def main():
+    return host_build.run(
+        "test_socd",
+        {"test_socd.cpp": TEST_SOURCE},
+        ["src/core/InputMode.cpp", "src/core/socd.cpp"],
+        ["-D", "HAYBOX_PRESS_TIMES"],
+    )
+
+
+if __name__ == "__main__":
+    sys.exit(main())
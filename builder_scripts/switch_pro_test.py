@@ -0,0 +1,225 @@
+"""
+Checks the Switch Pro Controller protocol (src/comms/switch_pro.cpp) against transcripts of the
+reports that the Switch sends when a controller is plugged in, and the replies it expects.
+
+The transcripts that come with HayBox are synthetic: they were written by hand from public reverse
+engineering notes on the protocol, not captured from a Switch, and start with a "# Synthetic" line
+to say so. A real capture can be checked by writing it out in the same format and passing it on the
+command line.
+
+    python builder_scripts/switch_pro_test.py [TRANSCRIPT...]
+
+Checks every transcript in builder_scripts/switch_pro_transcripts by default. In a transcript, each
+line starting with > is a report sent by the Switch and each line starting with < is the next report
+the controller should send, or "none" if it shouldn't send anything. Reports are written as hex
+bytes starting with the report ID. ?? matches any byte, bytes that aren't listed have to be zero,
+and a trailing ... skips checking the rest of the report. Everything after a # is a comment.
+
+Builds and runs a small program on the host, so it needs a C++ compiler ($CXX, or c++ by default).
+"""
+
+import glob
+import os
+import subprocess
+import sys
+import tempfile
+
+import host_build
+
+TRANSCRIPT_DIR = os.path.join(host_build.PROJECT_DIR, "builder_scripts", "switch_pro_transcripts")
+REPORT_SIZE = 64
+
+# Reads "> <hex>" lines to pass to the protocol, and prints the next input report for each "<" line.
+# With --inputs, checks how outputs are packed into input reports instead.
+TEST_SOURCE = r"""
+#include "comms/switch_pro.hpp"
+#include "core/state.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static int failures = 0;
+
+static void check(bool ok, const char *what) {
+    if (!ok) {
+        printf("FAILED: %s\n", what);
+        failures++;
+    }
+}
+
+static void check_inputs(
+    const char *what,
+    const OutputState &outputs,
+    const uint8_t (&expected)[SWITCH_PRO_INPUTS_SIZE]
+) {
+    uint8_t inputs[SWITCH_PRO_INPUTS_SIZE];
+    switch_pro::encode_inputs(outputs, inputs);
+    check(memcmp(inputs, expected, sizeof(inputs)) == 0, what);
+}
+
+static int run_input_checks() {
+    // Sticks are centred on 0x800, packed as 12-bit X and Y pairs.
+    check_inputs("neutral", OutputState(), { 0, 0, 0, 0x00, 0x08, 0x80, 0x00, 0x08, 0x80 });
+
+    OutputState right;
+    right.y = true;
+    right.x = true;
+    right.b = true;
+    right.a = true;
+    right.triggerRDigital = true;
+    right.buttonR = true;
+    check_inputs("right buttons", right, { 0xCF, 0, 0, 0x00, 0x08, 0x80, 0x00, 0x08, 0x80 });
+
+    OutputState shared;
+    shared.select = true;
+    shared.start = true;
+    shared.rightStickClick = true;
+    shared.leftStickClick = true;
+    shared.home = true;
+    check_inputs("shared buttons", shared, { 0, 0x1F, 0, 0x00, 0x08, 0x80, 0x00, 0x08, 0x80 });
+
+    OutputState left;
+    left.dpadDown = true;
+    left.dpadUp = true;
+    left.dpadRight = true;
+    left.dpadLeft = true;
+    left.triggerLDigital = true;
+    left.buttonL = true;
+    check_inputs("left buttons", left, { 0, 0, 0xCF, 0x00, 0x08, 0x80, 0x00, 0x08, 0x80 });
+
+    // Each 8-bit step is 16 12-bit steps.
+    OutputState sticks;
+    sticks.leftStickX = 0;
+    sticks.leftStickY = 255;
+    sticks.rightStickX = 129;
+    sticks.rightStickY = 127;
+    check_inputs("sticks", sticks, { 0, 0, 0, 0x00, 0x00, 0xFF, 0x10, 0x08, 0x7F });
+
+    printf("Switch Pro Controller inputs: %s\n", failures == 0 ? "OK" : "FAILED");
+    return failures != 0;
+}
+
+static int run_transcript() {
+    switch_pro::Protocol protocol;
+    OutputState outputs;
+    char line[512];
+
+    while (fgets(line, sizeof(line), stdin) != nullptr) {
+        if (line[0] == '>') {
+            uint8_t report[SWITCH_PRO_REPORT_SIZE] = {};
+            size_t len = 0;
+            char *p = line + 1;
+            char *end;
+            for (unsigned long value = strtoul(p, &end, 16); end != p && len < sizeof(report);
+                 value = strtoul(p, &end, 16)) {
+                report[len++] = value;
+                p = end;
+            }
+            protocol.HandleOutputReport(report, len);
+        } else if (line[0] == '<') {
+            uint8_t report[SWITCH_PRO_REPORT_SIZE];
+            size_t len = protocol.NextInputReport(outputs, report);
+            if (len == 0) {
+                printf("none");
+            }
+            for (size_t i = 0; i < len; i++) {
+                printf("%s%02X", i == 0 ? "" : " ", report[i]);
+            }
+            printf("\n");
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1 && strcmp(argv[1], "--inputs") == 0) {
+        return run_input_checks();
+    }
+    return run_transcript();
+}
+"""
+
+
+def build(build_dir):
+    return host_build.build(
+        build_dir,
+        "test_switch_pro",
+        {"test_switch_pro.cpp": TEST_SOURCE},
+        ["src/comms/switch_pro.cpp"],
+    )
+
+
+def parse_transcript(path):
+    """Returns the transcript as a list of (line number, direction, bytes) tuples."""
+    steps = []
+    with open(path) as f:
+        for number, line in enumerate(f, 1):
+            line = line.split("#", 1)[0].strip()
+            if not line:
+                continue
+            direction, report = line[0], line[1:].split()
+            if direction not in "<>":
+                raise ValueError(f"{path}:{number}: expected a line starting with < or >")
+            steps.append((number, direction, report))
+    return steps
+
+
+def matches(expected, actual):
+    if expected == ["none"]:
+        return actual == ["none"]
+    if actual == ["none"] or len(actual) != REPORT_SIZE:
+        return False
+    skip_rest = expected[-1:] == ["..."]
+    if skip_rest:
+        expected = expected[:-1]
+    if len(expected) > len(actual):
+        return False
+    for want, got in zip(expected, actual):
+        if want != "??" and int(want, 16) != int(got, 16):
+            return False
+    return skip_rest or all(int(got, 16) == 0 for got in actual[len(expected) :])
+
+
+def is_synthetic(path):
+    with open(path) as f:
+        return any(line.startswith("# Synthetic") for line in f)
+
+
+def check_transcript(executable, path):
+    steps = parse_transcript(path)
+    commands = "".join(
+        f"> {' '.join(report)}\n" if direction == ">" else "<\n" for _, direction, report in steps
+    )
+    result = subprocess.run(
+        [executable], input=commands, capture_output=True, text=True, check=True
+    )
+    replies = iter(result.stdout.splitlines())
+
+    ok = True
+    for number, direction, expected in steps:
+        if direction != "<":
+            continue
+        actual = next(replies).split()
+        if not matches(expected, actual):
+            print(f"{os.path.relpath(path)}:{number}: unexpected report")
+            print(f"  expected: {' '.join(expected)}")
+            print(f"  got:      {' '.join(actual)}")
+            ok = False
+    return ok
+
+
+def main():
+    transcripts = sys.argv[1:] or sorted(glob.glob(os.path.join(TRANSCRIPT_DIR, "*.txt")))
+    with tempfile.TemporaryDirectory() as build_dir:
+        executable = build(build_dir)
+        failed = subprocess.run([executable, "--inputs"]).returncode != 0
+        for path in transcripts:
+            ok = check_transcript(executable, path)
+            label = " (synthetic)" if is_synthetic(path) else ""
+            print(f"{os.path.relpath(path)}{label}: {'OK' if ok else 'FAILED'}")
+            failed = failed or not ok
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
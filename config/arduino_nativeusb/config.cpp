@@ -5,9 +5,11 @@
 #include "config/mode_selection.hpp"
 #include "core/CommunicationBackend.hpp"
 #include "core/InputMode.hpp"
+#include "core/KeyValueStore.hpp"
 #include "core/KeyboardMode.hpp"
 #include "core/pinout.hpp"
 #include "core/socd.hpp"
+#include "core/static_alloc.hpp"
 #include "core/state.hpp"
 #include "input/GpioButtonInput.hpp"
 #include "input/NunchukInput.hpp"
@@ -18,6 +20,9 @@ CommunicationBackend **backends = nullptr;
 size_t backend_count;
 KeyboardMode *current_kb_mode = nullptr;
 
+// Last used mode, kept in EEPROM.
+KeyValueStore settings;
+
 // Customise this to match your controller's pinout.
 GpioButtonMapping button_mappings[] = {
     {&InputState::l,            15},
@@ -59,21 +64,27 @@ Pinout pinout = {
 };
 
 void setup() {
+    // Load saved settings, and make room for more while it doesn't matter how long that takes.
+    settings.Load();
+    settings.Compact();
+    set_mode_store(&settings);
+
     // Create Nunchuk input source - must be done before GPIO input source otherwise it would
     // disable the pullups on the i2c pins.
-    NunchukInput *nunchuk = new NunchukInput();
+    NunchukInput *nunchuk = static_new<NunchukInput>();
 
     // Create GPIO input source and use it to read button states for checking button holds.
-    GpioButtonInput *gpio_input = new GpioButtonInput(button_mappings, button_count);
+    GpioButtonInput *gpio_input = static_new<GpioButtonInput>(button_mappings, button_count);
 
     InputState button_holds;
     gpio_input->UpdateInputs(button_holds);
 
     // Create array of input sources to be used.
     static InputSource *input_sources[] = { gpio_input, nunchuk };
-    size_t input_source_count = sizeof(input_sources) / sizeof(InputSource *);
+    size_t input_source_count = input_source_count_of(input_sources);
 
-    CommunicationBackend *primary_backend = new DInputBackend(input_sources, input_source_count);
+    CommunicationBackend *primary_backend =
+        static_new<DInputBackend>(input_sources, input_source_count);
     delay(500);
     bool usb_connected = UDADDR & _BV(ADDEN);
 
@@ -82,30 +93,40 @@ void setup() {
         // Default to DInput mode if USB is connected.
         // Input viewer only used when connected to PC i.e. when using DInput mode.
         backend_count = 2;
-        backends = new CommunicationBackend *[backend_count] {
-            primary_backend, new B0XXInputViewer(input_sources, input_source_count)
+        static CommunicationBackend *backends_storage[] = {
+            primary_backend, static_new<B0XXInputViewer>(input_sources, input_source_count)
         };
+        backends = backends_storage;
     } else {
-        delete primary_backend;
+        static_delete(primary_backend);
         if (button_holds.a) {
             // Hold A on plugin for GameCube adapter.
-            primary_backend =
-                new GamecubeBackend(input_sources, input_source_count, 0, pinout.joybus_data);
+            primary_backend = static_new<GamecubeBackend>(
+                input_sources,
+                input_source_count,
+                0,
+                pinout.joybus_data
+            );
         } else {
             // Default to GameCube/Wii.
-            primary_backend =
-                new GamecubeBackend(input_sources, input_source_count, 125, pinout.joybus_data);
+            primary_backend = static_new<GamecubeBackend>(
+                input_sources,
+                input_source_count,
+                125,
+                pinout.joybus_data
+            );
         }
 
         // If not DInput then only using 1 backend (no input viewer).
         backend_count = 1;
-        backends = new CommunicationBackend *[backend_count] { primary_backend };
+        static CommunicationBackend *backends_storage[] = { primary_backend };
+        backends = backends_storage;
     }
 
-    // Default to Melee mode.
-    primary_backend->SetGameMode(
-        new Melee20Button(socd::SOCD_2IP_NO_REAC, { .crouch_walk_os = false })
-    );
+    // Select the mode that was used last, or default to Melee mode.
+    if (!restore_mode(primary_backend)) {
+        select_melee(primary_backend);
+    }
 }
 
 void loop() {
@@ -115,6 +136,12 @@ void loop() {
         backends[i]->SendReport();
     }
 
+    // Save any settings that changed. Console backends never have time for it, so this only
+    // happens over USB.
+    if (settings.Pending() && backends[0]->CanStall(settings.CommitTimeUs())) {
+        settings.Commit();
+    }
+
     if (current_kb_mode != nullptr) {
         current_kb_mode->SendReport(backends[0]->GetInputs());
     }
@@ -7,6 +7,7 @@
 #include "core/InputMode.hpp"
 #include "core/pinout.hpp"
 #include "core/socd.hpp"
+#include "core/static_alloc.hpp"
 #include "core/state.hpp"
 #include "input/GpioButtonInput.hpp"
 #include "input/NunchukInput.hpp"
@@ -55,19 +56,20 @@ Pinout pinout = {
 void setup() {
     // Create Nunchuk input source - must be done before GPIO input source otherwise it would
     // disable the pullups on the i2c pins.
-    NunchukInput *nunchuk = new NunchukInput();
+    NunchukInput *nunchuk = static_new<NunchukInput>();
 
     // Create GPIO input source and use it to read button states for checking button holds.
-    GpioButtonInput *gpio_input = new GpioButtonInput(button_mappings, button_count);
+    GpioButtonInput *gpio_input = static_new<GpioButtonInput>(button_mappings, button_count);
 
     InputState button_holds;
     gpio_input->UpdateInputs(button_holds);
 
     // Create array of input sources to be used.
     static InputSource *input_sources[] = { gpio_input, nunchuk };
-    size_t input_source_count = sizeof(input_sources) / sizeof(InputSource *);
+    size_t input_source_count = input_source_count_of(input_sources);
 
-    CommunicationBackend *primary_backend = new DInputBackend(input_sources, input_source_count);
+    CommunicationBackend *primary_backend =
+        static_new<DInputBackend>(input_sources, input_source_count);
     delay(500);
     bool usb_connected = UDADDR & _BV(ADDEN);
 
@@ -76,33 +78,45 @@ void setup() {
         // Default to DInput mode if USB is connected.
         // Input viewer only used when connected to PC i.e. when using DInput mode.
         backend_count = 2;
-        backends = new CommunicationBackend *[backend_count] {
-            primary_backend, new B0XXInputViewer(input_sources, input_source_count)
+        static CommunicationBackend *backends_storage[] = {
+            primary_backend, static_new<B0XXInputViewer>(input_sources, input_source_count)
         };
+        backends = backends_storage;
     } else {
-        delete primary_backend;
+        static_delete(primary_backend);
         if (button_holds.c_left) {
             // Hold C-Left on plugin for N64.
             primary_backend =
-                new N64Backend(input_sources, input_source_count, 60, pinout.joybus_data);
+                static_new<N64Backend>(input_sources, input_source_count, 60, pinout.joybus_data);
         } else if (button_holds.a) {
             // Hold A on plugin for GameCube adapter.
-            primary_backend =
-                new GamecubeBackend(input_sources, input_source_count, 0, pinout.joybus_data);
+            primary_backend = static_new<GamecubeBackend>(
+                input_sources,
+                input_source_count,
+                0,
+                pinout.joybus_data
+            );
         } else {
             // Default to GameCube/Wii.
-            primary_backend =
-                new GamecubeBackend(input_sources, input_source_count, 125, pinout.joybus_data);
+            primary_backend = static_new<GamecubeBackend>(
+                input_sources,
+                input_source_count,
+                125,
+                pinout.joybus_data
+            );
         }
 
         // If not DInput then only using 1 backend (no input viewer).
         backend_count = 1;
-        backends = new CommunicationBackend *[backend_count] { primary_backend };
+        static CommunicationBackend *backends_storage[] = { primary_backend };
+        backends = backends_storage;
     }
 
     // Default to Melee mode.
-    primary_backend->SetGameMode(
-        new Melee20Button(socd::SOCD_2IP_NO_REAC, { .crouch_walk_os = false })
+    set_mode<Melee20Button>(
+        primary_backend,
+        socd::SOCD_2IP_NO_REAC,
+        Melee20ButtonOptions{ .crouch_walk_os = false }
     );
 }
 
@@ -9,6 +9,7 @@
 #include "core/KeyboardMode.hpp"
 #include "core/pinout.hpp"
 #include "core/socd.hpp"
+#include "core/static_alloc.hpp"
 #include "core/state.hpp"
 #include "input/GpioButtonInput.hpp"
 #include "input/NunchukInput.hpp"
@@ -62,7 +63,7 @@ Pinout pinout = {
 
 void setup() {
   // Create GPIO input source and use it to read button states for checking button holds.
-  GpioButtonInput *gpio_input = new GpioButtonInput(button_mappings, button_count);
+  GpioButtonInput *gpio_input = static_new<GpioButtonInput>(button_mappings, button_count);
 
   InputState button_holds;
   gpio_input->UpdateInputs(button_holds);
@@ -79,7 +80,7 @@ void setup() {
 
   // Create array of input sources to be used.
   static InputSource *input_sources[] = { gpio_input };
-  size_t input_source_count = sizeof(input_sources) / sizeof(InputSource *);
+  size_t input_source_count = input_source_count_of(input_sources);
 
   ConnectedConsole console = detect_console(pinout.joybus_data);
 
@@ -89,51 +90,66 @@ void setup() {
     if (button_holds.x) {
       // Hold X for XInput
       backend_count = 2;
-      primary_backend = new XInputBackend(input_sources, input_source_count);
-      backends = new CommunicationBackend *[backend_count] {
-          primary_backend, new B0XXInputViewer(input_sources, input_source_count)
+      primary_backend = static_new<XInputBackend>(input_sources, input_source_count);
+      static CommunicationBackend *backends_storage[] = {
+          primary_backend, static_new<B0XXInputViewer>(input_sources, input_source_count)
       };
-      primary_backend->SetGameMode(new UltimateR4(socd::SOCD_2IP));
+      backends = backends_storage;
+      set_mode<UltimateR4>(primary_backend, socd::SOCD_2IP);
     } else if (button_holds.b) {
       // Hold B for Melee (slippi)
       backend_count = 1;
-      primary_backend = new XInputBackend(input_sources, input_source_count);
-      backends = new CommunicationBackend *[backend_count] { primary_backend };
+      primary_backend = static_new<XInputBackend>(input_sources, input_source_count);
+      static CommunicationBackend *backends_storage[] = { primary_backend };
+      backends = backends_storage;
       socd::SocdType socdType = (button_holds.r && button_holds.y) ? socd::SOCD_2IP_NO_REAC : socd::SOCD_2IP;
-      primary_backend->SetGameMode(new Melee20Button(socdType, { .crouch_walk_os = false }));
+      set_mode<Melee20Button>(
+          primary_backend,
+          socdType,
+          Melee20ButtonOptions{ .crouch_walk_os = false }
+      );
     } else if (button_holds.y) {
       // Hold Y for FGC Mode
       backend_count = 2;
-      primary_backend = new XInputBackend(input_sources, input_source_count);
-      backends = new CommunicationBackend *[backend_count] {
-          primary_backend, new B0XXInputViewer(input_sources, input_source_count)
+      primary_backend = static_new<XInputBackend>(input_sources, input_source_count);
+      static CommunicationBackend *backends_storage[] = {
+          primary_backend, static_new<B0XXInputViewer>(input_sources, input_source_count)
       };
-      primary_backend->SetGameMode(new FgcMode(socd::SOCD_NEUTRAL, socd::SOCD_NEUTRAL));
+      backends = backends_storage;
+      set_mode<FgcMode>(primary_backend, socd::SOCD_NEUTRAL, socd::SOCD_NEUTRAL);
     } else {
       // Default to Switch (detect_console returns NONE for the Switch!)
       NintendoSwitchBackend::RegisterDescriptor();
       backend_count = 1;
-      primary_backend = new NintendoSwitchBackend(input_sources, input_source_count);
-      backends = new CommunicationBackend *[backend_count] { primary_backend };
-      primary_backend->SetGameMode(new UltimateR4(socd::SOCD_2IP));
+      primary_backend = static_new<NintendoSwitchBackend>(input_sources, input_source_count);
+      static CommunicationBackend *backends_storage[] = { primary_backend };
+      backends = backends_storage;
+      set_mode<UltimateR4>(primary_backend, socd::SOCD_2IP);
     }
   } else {
     if (console == ConnectedConsole::GAMECUBE) {
       // NOTE: This is called when using a gcc adapter with the switch!
-      primary_backend = new GamecubeBackend(input_sources, input_source_count, pinout.joybus_data);
+      primary_backend =
+          static_new<GamecubeBackend>(input_sources, input_source_count, pinout.joybus_data);
       if (button_holds.b) {
-        primary_backend->SetGameMode(new UltimateR4(socd::SOCD_2IP));
+        set_mode<UltimateR4>(primary_backend, socd::SOCD_2IP);
       } else {
         socd::SocdType socdType = (button_holds.r && button_holds.y) ? socd::SOCD_2IP_NO_REAC : socd::SOCD_2IP;
-        primary_backend->SetGameMode(new Melee20Button(socdType, { .crouch_walk_os = false }));
+        set_mode<Melee20Button>(
+            primary_backend,
+            socdType,
+            Melee20ButtonOptions{ .crouch_walk_os = false }
+        );
       }
     } else if (console == ConnectedConsole::N64) {
-      primary_backend = new N64Backend(input_sources, input_source_count, pinout.joybus_data);
-      primary_backend->SetGameMode(new UltimateR4(socd::SOCD_2IP));
+      primary_backend =
+          static_new<N64Backend>(input_sources, input_source_count, pinout.joybus_data);
+      set_mode<UltimateR4>(primary_backend, socd::SOCD_2IP);
     }
     // If console then only using 1 backend (no input viewer).
     backend_count = 1;
-    backends = new CommunicationBackend *[backend_count] { primary_backend };
+    static CommunicationBackend *backends_storage[] = { primary_backend };
+    backends = backends_storage;
   }
 }
 
@@ -10,6 +10,7 @@
 #include "core/KeyboardMode.hpp"
 #include "core/pinout.hpp"
 #include "core/socd.hpp"
+#include "core/static_alloc.hpp"
 #include "core/state.hpp"
 #include "input/SwitchMatrixInput.hpp"
 #include "joybus_utils.hpp"
@@ -48,7 +49,12 @@ const Pinout pinout = {
 void setup() {
     // Create switch matrix input source and use it to read button states for checking button holds.
     SwitchMatrixInput<num_rows, num_cols> *matrix_input =
-        new SwitchMatrixInput<num_rows, num_cols>(row_pins, col_pins, matrix, diode_direction);
+        static_new<SwitchMatrixInput<num_rows, num_cols>>(
+            row_pins,
+            col_pins,
+            matrix,
+            diode_direction
+        );
 
     InputState button_holds;
     matrix_input->UpdateInputs(button_holds);
@@ -65,7 +71,7 @@ void setup() {
 
     // Create array of input sources to be used.
     static InputSource *input_sources[] = { matrix_input };
-    size_t input_source_count = sizeof(input_sources) / sizeof(InputSource *);
+    size_t input_source_count = input_source_count_of(input_sources);
 
     ConnectedConsole console = detect_console(pinout.joybus_data);
 
@@ -76,45 +82,51 @@ void setup() {
             // If no console detected and X is held on plugin then use Switch USB backend.
             NintendoSwitchBackend::RegisterDescriptor();
             backend_count = 1;
-            primary_backend = new NintendoSwitchBackend(input_sources, input_source_count);
-            backends = new CommunicationBackend *[backend_count] { primary_backend };
+            primary_backend = static_new<NintendoSwitchBackend>(input_sources, input_source_count);
+            static CommunicationBackend *backends_storage[] = { primary_backend };
+            backends = backends_storage;
 
             // Default to Ultimate mode on Switch.
-            primary_backend->SetGameMode(new Ultimate(socd::SOCD_2IP));
+            set_mode<Ultimate>(primary_backend, socd::SOCD_2IP);
             return;
         } else if (button_holds.z) {
             // If no console detected and Z is held on plugin then use DInput backend.
-            TUGamepad::registerDescriptor();
-            TUKeyboard::registerDescriptor();
+            TUCompositeHID::registerDescriptors<TUGamepad, TUKeyboard>();
             backend_count = 2;
-            primary_backend = new DInputBackend(input_sources, input_source_count);
-            backends = new CommunicationBackend *[backend_count] {
-                primary_backend, new B0XXInputViewer(input_sources, input_source_count)
+            primary_backend = static_new<DInputBackend>(input_sources, input_source_count);
+            static CommunicationBackend *backends_storage[] = {
+                primary_backend, static_new<B0XXInputViewer>(input_sources, input_source_count)
             };
+            backends = backends_storage;
         } else {
             // Default to XInput mode if no console detected and no other mode forced.
             backend_count = 2;
-            primary_backend = new XInputBackend(input_sources, input_source_count);
-            backends = new CommunicationBackend *[backend_count] {
-                primary_backend, new B0XXInputViewer(input_sources, input_source_count)
+            primary_backend = static_new<XInputBackend>(input_sources, input_source_count);
+            static CommunicationBackend *backends_storage[] = {
+                primary_backend, static_new<B0XXInputViewer>(input_sources, input_source_count)
             };
+            backends = backends_storage;
         }
     } else {
         if (console == ConnectedConsole::GAMECUBE) {
             primary_backend =
-                new GamecubeBackend(input_sources, input_source_count, pinout.joybus_data);
+                static_new<GamecubeBackend>(input_sources, input_source_count, pinout.joybus_data);
         } else if (console == ConnectedConsole::N64) {
-            primary_backend = new N64Backend(input_sources, input_source_count, pinout.joybus_data);
+            primary_backend =
+                static_new<N64Backend>(input_sources, input_source_count, pinout.joybus_data);
         }
 
         // If console then only using 1 backend (no input viewer).
         backend_count = 1;
-        backends = new CommunicationBackend *[backend_count] { primary_backend };
+        static CommunicationBackend *backends_storage[] = { primary_backend };
+        backends = backends_storage;
     }
 
     // Default to Melee mode.
-    primary_backend->SetGameMode(
-        new Melee20Button(socd::SOCD_2IP_NO_REAC, { .crouch_walk_os = false })
+    set_mode<Melee20Button>(
+        primary_backend,
+        socd::SOCD_2IP_NO_REAC,
+        Melee20ButtonOptions{ .crouch_walk_os = false }
     );
 }
 
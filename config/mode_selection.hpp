@@ -1,8 +1,12 @@
 #ifndef _CONFIG_MODE_SELECTION_HPP
 #define _CONFIG_MODE_SELECTION_HPP
 
+#include "core/ComboEngine.hpp"
+#include "core/KeyValueStore.hpp"
+#include "core/Profile.hpp"
 #include "core/state.hpp"
 #include "modes/DefaultKeyboardMode.hpp"
+#include "modes/FgcHotkeys.hpp"
 #include "modes/FgcMode.hpp"
 #include "modes/Melee20Button.hpp"
 #include "modes/ProjectM.hpp"
@@ -13,12 +17,87 @@
 
 extern KeyboardMode *current_kb_mode;
 
+template <typename... Modes> constexpr size_t largest_size() {
+    size_t sizes[] = { sizeof(Modes)... };
+    size_t largest = 0;
+    for (size_t size : sizes) {
+        largest = size > largest ? size : largest;
+    }
+    return largest;
+}
+
+template <typename... Modes> constexpr size_t largest_alignment() {
+    size_t alignments[] = { alignof(Modes)... };
+    size_t largest = 0;
+    for (size_t alignment : alignments) {
+        largest = alignment > largest ? alignment : largest;
+    }
+    return largest;
+}
+
+// Storage big enough for any one of the given modes.
+template <typename... Modes> struct ModeStorage {
+    static constexpr size_t alignment = largest_alignment<Modes...>();
+    static constexpr size_t size =
+        (largest_size<Modes...>() + alignment - 1) / alignment * alignment;
+};
+
+// Every mode that can be set must fit in the mode storage, so add any custom modes to this list.
+typedef ModeStorage<
+    Melee20Button,
+    ProjectM,
+    Ultimate,
+    UltimateR4,
+    FgcMode,
+    RivalsOfAether,
+    Rivals2,
+    DefaultKeyboardMode>
+    SelectableModes;
+
+// Two slots, because a new mode is always constructed before the old one gets destroyed.
+alignas(SelectableModes::alignment) static uint8_t mode_storage[2][SelectableModes::size];
+static uint8_t next_mode_slot = 0;
+
+// Keyboard modes that can be run alongside a controller mode with set_hotkeys(). Add any custom
+// hotkey modes to this list.
+typedef ModeStorage<DefaultKeyboardMode, FgcHotkeys> SelectableHotkeys;
+
+// Only one slot, because set_hotkeys() destroys the old keyboard mode first.
+alignas(SelectableHotkeys::alignment) static uint8_t hotkey_storage[SelectableHotkeys::size];
+
+// Profile whose SOCD pairs and mode options are used instead of the modes' own, if any. See
+// set_mode_profile().
+static Profile *mode_profile = nullptr;
+
+// Uses the SOCD pairs and mode options from the given profile for every mode selected from now on.
+void set_mode_profile(Profile *profile) {
+    mode_profile = profile;
+}
+
+bool profile_option(uint16_t option, bool default_value) {
+    return mode_profile != nullptr ? mode_profile->Option(option) : default_value;
+}
+
+void apply_profile_socd_pairs(InputMode *mode) {
+    if (mode_profile == nullptr || mode_profile->SocdPairCount() == 0) {
+        return;
+    }
+    socd::SocdPair socd_pairs[MAX_SOCD_PAIRS];
+    size_t count = mode_profile->SocdPairCount();
+    for (size_t i = 0; i < count; i++) {
+        socd_pairs[i] = mode_profile->SocdPair(i);
+    }
+    mode->SetSocdPairs(socd_pairs, count);
+}
+
 void set_mode(CommunicationBackend *backend, ControllerMode *mode) {
     // Delete keyboard mode in case one is set, so we don't end up getting both controller and
     // keyboard inputs.
     delete current_kb_mode;
     current_kb_mode = nullptr;
 
+    apply_profile_socd_pairs(mode);
+
     // Set new controller mode.
     backend->SetGameMode(mode);
 }
@@ -27,42 +106,168 @@ void set_mode(CommunicationBackend *backend, KeyboardMode *mode) {
     // Delete and reassign current keyboard mode.
     delete current_kb_mode;
     current_kb_mode = mode;
+    apply_profile_socd_pairs(mode);
 
     // Unset the current controller mode so backend only gives neutral inputs.
     backend->SetGameMode(nullptr);
 }
 
-void select_mode(CommunicationBackend *backend) {
-    InputState &inputs = backend->GetInputs();
-    if (inputs.mod_x && !inputs.mod_y && inputs.start) {
-        if (inputs.l) {
-            set_mode(
-                backend,
-                new Melee20Button(socd::SOCD_2IP_NO_REAC, { .crouch_walk_os = false })
-            );
-        } else if (inputs.left) {
-            set_mode(
-                backend,
-                new ProjectM(
-                    socd::SOCD_2IP_NO_REAC,
-                    { .true_z_press = false, .ledgedash_max_jump_traj = true }
-                )
-            );
-        } else if (inputs.down) {
-            // TODO: Should I make this switch to UltimateR4?
-            set_mode(backend, new Ultimate(socd::SOCD_2IP));
-        } else if (inputs.right) {
-            set_mode(backend, new FgcMode(socd::SOCD_NEUTRAL, socd::SOCD_NEUTRAL));
-        } else if (inputs.b) {
-            set_mode(backend, new RivalsOfAether(socd::SOCD_2IP));
-        } else if (inputs.r) {
-            set_mode(backend, new Rivals2(socd::SOCD_2IP));
+template <typename Mode, typename... Args>
+void set_mode(CommunicationBackend *backend, Args &&...args) {
+    static_assert(sizeof(Mode) <= SelectableModes::size, "Mode doesn't fit in mode storage");
+    static_assert(alignof(Mode) <= SelectableModes::alignment, "Mode doesn't fit in mode storage");
+
+    void *storage = mode_storage[next_mode_slot];
+    next_mode_slot = !next_mode_slot;
+    set_mode(backend, new (storage) Mode(static_cast<Args &&>(args)...));
+}
+
+/*
+ * Runs a keyboard mode alongside the current controller mode, for games that need a few keys as
+ * well as the controller. Has to be called after set_mode(), which removes any keyboard mode. The
+ * keyboard mode gets the inputs after the controller mode has done its SOCD cleaning.
+ */
+template <typename Mode, typename... Args> void set_hotkeys(Args &&...args) {
+    static_assert(sizeof(Mode) <= SelectableHotkeys::size, "Mode doesn't fit in hotkey storage");
+    static_assert(
+        alignof(Mode) <= SelectableHotkeys::alignment,
+        "Mode doesn't fit in hotkey storage"
+    );
+
+    delete current_kb_mode;
+    current_kb_mode = new (hotkey_storage) Mode(static_cast<Args &&>(args)...);
+}
+
+// Modes that the select_* functions below save under kv::LAST_MODE. Only ever add to the end of
+// this list, so that saved modes still mean the same thing after an update.
+enum class ModeId : uint16_t {
+    MELEE,
+    PROJECT_M,
+    ULTIMATE,
+    FGC,
+    RIVALS_OF_AETHER,
+    RIVALS_2,
+};
+
+// Where the selected mode gets saved, if anywhere. See set_mode_store().
+static KeyValueStore *mode_store = nullptr;
+
+// Saves every mode selected from now on, so that restore_mode() can select it again on the next
+// boot. The config has to Commit() the store itself.
+void set_mode_store(KeyValueStore *store) {
+    mode_store = store;
+}
+
+void remember_mode(ModeId mode) {
+    if (mode_store != nullptr) {
+        mode_store->Set(kv::LAST_MODE, (uint16_t)mode);
+    }
+}
+
+void select_melee(CommunicationBackend *backend) {
+    remember_mode(ModeId::MELEE);
+    set_mode<Melee20Button>(
+        backend,
+        socd::SOCD_2IP_NO_REAC,
+        Melee20ButtonOptions{
+            .crouch_walk_os = profile_option(PROFILE_OPTION_CROUCH_WALK_OS, false),
         }
-    } else if (inputs.mod_y && !inputs.mod_x && inputs.start) {
-        if (inputs.l) {
-            set_mode(backend, new DefaultKeyboardMode(socd::SOCD_2IP));
+    );
+}
+
+void select_project_m(CommunicationBackend *backend) {
+    remember_mode(ModeId::PROJECT_M);
+    set_mode<ProjectM>(
+        backend,
+        socd::SOCD_2IP_NO_REAC,
+        ProjectMOptions{
+            .true_z_press = profile_option(PROFILE_OPTION_TRUE_Z_PRESS, false),
+            .ledgedash_max_jump_traj = profile_option(PROFILE_OPTION_LEDGEDASH_MAX_JUMP_TRAJ, true),
+            .z_press_macro = profile_option(PROFILE_OPTION_Z_PRESS_MACRO, false),
         }
+    );
+}
+
+void select_ultimate(CommunicationBackend *backend) {
+    remember_mode(ModeId::ULTIMATE);
+    // TODO: Should I make this switch to UltimateR4?
+    set_mode<Ultimate>(backend, socd::SOCD_2IP);
+}
+
+void select_fgc(CommunicationBackend *backend) {
+    remember_mode(ModeId::FGC);
+    set_mode<FgcMode>(backend, socd::SOCD_NEUTRAL, socd::SOCD_NEUTRAL);
+}
+
+void select_rivals_of_aether(CommunicationBackend *backend) {
+    remember_mode(ModeId::RIVALS_OF_AETHER);
+    set_mode<RivalsOfAether>(backend, socd::SOCD_2IP);
+}
+
+void select_rivals_2(CommunicationBackend *backend) {
+    remember_mode(ModeId::RIVALS_2);
+    set_mode<Rivals2>(backend, socd::SOCD_2IP);
+}
+
+// Not saved, because a keyboard mode only works with the DInput backend.
+void select_keyboard(CommunicationBackend *backend) {
+    set_mode<DefaultKeyboardMode>(backend, socd::SOCD_2IP);
+}
+
+// FGC mode with menu keys on the side. Not saved, for the same reason as select_keyboard().
+void select_fgc_with_hotkeys(CommunicationBackend *backend) {
+    set_mode<FgcMode>(backend, socd::SOCD_NEUTRAL, socd::SOCD_NEUTRAL);
+    set_hotkeys<FgcHotkeys>();
+}
+
+// Indexed by ModeId.
+static void (*const mode_selectors[])(CommunicationBackend *) = {
+    select_melee, select_project_m, select_ultimate, select_fgc, select_rivals_of_aether,
+    select_rivals_2,
+};
+
+// How many ModeIds there are.
+const uint16_t mode_id_count = sizeof(mode_selectors) / sizeof(mode_selectors[0]);
+
+// Selects a mode by its ModeId. Returns false if there's no such mode.
+bool select_mode_by_id(CommunicationBackend *backend, uint16_t mode) {
+    if (mode >= mode_id_count) {
+        return false;
     }
+    mode_selectors[mode](backend);
+    return true;
+}
+
+// Selects the mode that was saved last, or failing that the profile's default mode. Returns false
+// if there's neither, so the config can fall back to its own default mode.
+bool restore_mode(CommunicationBackend *backend) {
+    uint16_t mode;
+    if (mode_store != nullptr && mode_store->Get(kv::LAST_MODE, mode) &&
+        select_mode_by_id(backend, mode)) {
+        return true;
+    }
+    return mode_profile != nullptr && select_mode_by_id(backend, mode_profile->DefaultMode());
+}
+
+#define MOD_X_START (BUTTON_BIT(mod_x) | BUTTON_BIT(start))
+#define MOD_Y_START (BUTTON_BIT(mod_y) | BUTTON_BIT(start))
+
+// Mode selection bindings. Listed in order of priority in case more than one is pressed at once.
+static const combo::Combo mode_combos[] PROGMEM = {
+    combo::chord(MOD_X_START | BUTTON_BIT(l), BUTTON_BIT(mod_y), select_melee),
+    combo::chord(MOD_X_START | BUTTON_BIT(left), BUTTON_BIT(mod_y), select_project_m),
+    combo::chord(MOD_X_START | BUTTON_BIT(down), BUTTON_BIT(mod_y), select_ultimate),
+    combo::chord(MOD_X_START | BUTTON_BIT(right), BUTTON_BIT(mod_y), select_fgc),
+    combo::chord(MOD_X_START | BUTTON_BIT(b), BUTTON_BIT(mod_y), select_rivals_of_aether),
+    combo::chord(MOD_X_START | BUTTON_BIT(r), BUTTON_BIT(mod_y), select_rivals_2),
+    combo::chord(MOD_Y_START | BUTTON_BIT(l), BUTTON_BIT(mod_x), select_keyboard),
+    combo::chord(MOD_Y_START | BUTTON_BIT(right), BUTTON_BIT(mod_x), select_fgc_with_hotkeys),
+};
+
+static ComboEngine mode_combo_engine(mode_combos);
+
+void select_mode(CommunicationBackend *backend) {
+    mode_combo_engine.Update(backend->GetInputs(), backend);
 }
 
 #endif
@@ -1,21 +1,31 @@
 #include "comms/B0XXInputViewer.hpp"
 #include "comms/DInputBackend.hpp"
+#include "comms/GamecubeAdapterBackend.hpp"
 #include "comms/GamecubeBackend.hpp"
 #include "comms/N64Backend.hpp"
 #include "comms/NintendoSwitchBackend.hpp"
+#include "comms/SwitchProBackend.hpp"
 #include "comms/XInputBackend.hpp"
 #include "config/mode_selection.hpp"
 #include "core/CommunicationBackend.hpp"
+#include "core/ConfigCommands.hpp"
+#include "core/ConfigProtocol.hpp"
 #include "core/InputMode.hpp"
+#include "core/InputRecorder.hpp"
+#include "core/KeyValueStore.hpp"
 #include "core/KeyboardMode.hpp"
+#include "core/Profile.hpp"
 #include "core/pinout.hpp"
 #include "core/socd.hpp"
+#include "core/static_alloc.hpp"
 #include "core/state.hpp"
 #include "input/GpioButtonInput.hpp"
 #include "input/NunchukInput.hpp"
+#include "input/ProfileButtonInput.hpp"
 #include "joybus_utils.hpp"
 #include "modes/Melee20Button.hpp"
 #include "stdlib.hpp"
+#include "storage.hpp"
 
 #include <pico/bootrom.h>
 
@@ -23,6 +33,36 @@ CommunicationBackend **backends = nullptr;
 size_t backend_count;
 KeyboardMode *current_kb_mode = nullptr;
 
+// Keeps the last 4096 input changes (48KB), which builder_scripts/configurator.py can dump over
+// USB serial for builder_scripts/replay.py.
+InputRecorder::Record input_records[4096];
+InputRecorder input_recorder(input_records);
+
+// Last used USB backend and mode, kept in flash.
+KeyValueStore settings;
+
+// Flashed separately from the firmware with builder_scripts/profile_tool.py. If there is one, it
+// takes the place of the button mappings below.
+Profile profile;
+ProfileButtonInput *profile_input = nullptr;
+GpioButtonInput *gpio_input = nullptr;
+
+// Whichever of profile_input and gpio_input is in use. write_profile() can swap them over.
+InputSource *input_sources[] = { nullptr };
+
+// Commands from builder_scripts/configurator.py over USB serial, for the primary backend.
+ConfigCommands *config_commands = nullptr;
+ConfigProtocol *config_serial = nullptr;
+
+// USB backends, as saved under kv::LAST_BACKEND. Only ever add to the end of this list.
+enum class UsbBackend : uint16_t {
+    XINPUT,
+    DINPUT,
+    SWITCH,
+    SWITCH_PRO,
+    GC_ADAPTER,
+};
+
 GpioButtonMapping button_mappings[] = {
     {&InputState::l,            5 },
     { &InputState::left,        4 },
@@ -62,12 +102,99 @@ const Pinout pinout = {
     .nunchuk_scl = -1,
 };
 
+// Pins that a profile can put buttons on: every GPIO apart from the Joybus data pin and the LED.
+// builder_scripts/profile_tool.py refuses the same ones.
+const uint32_t profile_pins =
+    ((1UL << NUM_BANK0_GPIOS) - 1) & ~(1UL << pinout.joybus_data) & ~(1UL << PICO_DEFAULT_LED_PIN);
+
+UsbBackend select_usb_backend(const InputState &button_holds) {
+    // If no console is detected, holding a button on plugin picks a USB backend, which is then
+    // used from then on until another one is picked.
+    UsbBackend backend;
+    if (button_holds.x) {
+        backend = UsbBackend::SWITCH;
+    } else if (button_holds.a) {
+        backend = UsbBackend::GC_ADAPTER;
+    } else if (button_holds.y) {
+        backend = UsbBackend::SWITCH_PRO;
+    } else if (button_holds.z) {
+        backend = UsbBackend::DINPUT;
+    } else if (button_holds.mod_x) {
+        backend = UsbBackend::XINPUT;
+    } else {
+        // Default to XInput mode if nothing has been picked yet.
+        uint16_t saved;
+        if (settings.Get(kv::LAST_BACKEND, saved) && saved <= (uint16_t)UsbBackend::GC_ADAPTER) {
+            return (UsbBackend)saved;
+        }
+        return UsbBackend::XINPUT;
+    }
+
+    // No backend is running yet, so it's fine to save this straight away.
+    settings.Set(kv::LAST_BACKEND, (uint16_t)backend);
+    settings.Commit();
+    return backend;
+}
+
+// The profile is read in place, so its button mappings change straight away, and the rest of it
+// from the next mode switch. Without a profile on boot, it's only used from the next boot.
+void write_profile(const uint8_t *data, size_t len) {
+    storage::write_profile(data, len);
+    if (profile_input == nullptr) {
+        return;
+    }
+
+    // Check what actually made it into flash before reading buttons from it. If that's no good,
+    // go back to the button mappings above.
+    if (profile.Open(storage::profile_region(), PROFILE_REGION_SIZE, profile_pins)) {
+        profile_input->InitPins();
+        input_sources[0] = profile_input;
+        set_mode_profile(&profile);
+    } else {
+        static_delete(gpio_input);
+        gpio_input = static_new<GpioButtonInput>(button_mappings, button_count);
+        input_sources[0] = gpio_input;
+        set_mode_profile(nullptr);
+    }
+
+    // Let go of any buttons that the new mapping doesn't have.
+    for (size_t i = 0; i < backend_count; i++) {
+        backends[i]->GetInputs() = InputState();
+    }
+}
+
+void setup_config_protocol(CommunicationBackend *backend) {
+    config_commands =
+        static_new<ConfigCommands>(backend, &input_recorder, select_mode_by_id, mode_id_count);
+    config_commands->SetProfileStorage(
+        storage::profile_region(),
+        PROFILE_REGION_SIZE,
+        profile_pins,
+        write_profile,
+        PROFILE_WRITE_TIME_US
+    );
+    const ConsoleDetection &detection = last_console_detection();
+    config_commands->SetConsoleDetection(
+        detection.first_reply_us,
+        detection.finished_us,
+        detection.remembered
+    );
+    config_serial = static_new<ConfigProtocol>(*config_commands);
+}
+
 void setup() {
     // Create GPIO input source and use it to read button states for checking button holds.
-    GpioButtonInput *gpio_input = new GpioButtonInput(button_mappings, button_count);
+    if (profile.Open(storage::profile_region(), PROFILE_REGION_SIZE, profile_pins)) {
+        profile_input = static_new<ProfileButtonInput>(profile);
+        input_sources[0] = profile_input;
+        set_mode_profile(&profile);
+    } else {
+        gpio_input = static_new<GpioButtonInput>(button_mappings, button_count);
+        input_sources[0] = gpio_input;
+    }
 
     InputState button_holds;
-    gpio_input->UpdateInputs(button_holds);
+    input_sources[0]->UpdateInputs(button_holds);
 
     // Bootsel button hold as early as possible for safety.
     if (button_holds.start) {
@@ -79,59 +206,104 @@ void setup() {
     gpio_set_dir(PICO_DEFAULT_LED_PIN, GPIO_OUT);
     gpio_put(PICO_DEFAULT_LED_PIN, 1);
 
-    // Create array of input sources to be used.
-    static InputSource *input_sources[] = { gpio_input };
-    size_t input_source_count = sizeof(input_sources) / sizeof(InputSource *);
+    // Load saved settings, and make room for more while it doesn't matter how long that takes.
+    settings.Load();
+    settings.Compact();
+    set_mode_store(&settings);
+
+    size_t input_source_count = input_source_count_of(input_sources);
 
     ConnectedConsole console = detect_console(pinout.joybus_data);
 
     /* Select communication backend. */
     CommunicationBackend *primary_backend;
+    bool has_serial = true;
     if (console == ConnectedConsole::NONE) {
-        if (button_holds.x) {
-            // If no console detected and X is held on plugin then use Switch USB backend.
-            NintendoSwitchBackend::RegisterDescriptor();
-            backend_count = 1;
-            primary_backend = new NintendoSwitchBackend(input_sources, input_source_count);
-            backends = new CommunicationBackend *[backend_count] { primary_backend };
-
-            // Default to Ultimate mode on Switch.
-            primary_backend->SetGameMode(new Ultimate(socd::SOCD_2IP));
-            return;
-        } else if (button_holds.z) {
-            // If no console detected and Z is held on plugin then use DInput backend.
-            TUGamepad::registerDescriptor();
-            TUKeyboard::registerDescriptor();
-            backend_count = 2;
-            primary_backend = new DInputBackend(input_sources, input_source_count);
-            backends = new CommunicationBackend *[backend_count] {
-                primary_backend, new B0XXInputViewer(input_sources, input_source_count)
-            };
-        } else {
-            // Default to XInput mode if no console detected and no other mode forced.
-            backend_count = 2;
-            primary_backend = new XInputBackend(input_sources, input_source_count);
-            backends = new CommunicationBackend *[backend_count] {
-                primary_backend, new B0XXInputViewer(input_sources, input_source_count)
-            };
+        switch (select_usb_backend(button_holds)) {
+            case UsbBackend::SWITCH: {
+                NintendoSwitchBackend::RegisterDescriptor();
+                backend_count = 1;
+                primary_backend =
+                    static_new<NintendoSwitchBackend>(input_sources, input_source_count);
+                static CommunicationBackend *backends_storage[] = { primary_backend };
+                backends = backends_storage;
+                primary_backend->SetInputRecorder(&input_recorder);
+
+                // Default to Ultimate mode on Switch.
+                set_mode<Ultimate>(primary_backend, socd::SOCD_2IP);
+                setup_config_protocol(primary_backend);
+                return;
+            }
+            case UsbBackend::GC_ADAPTER: {
+                // Act as a GameCube controller adapter for Dolphin.
+                backend_count = 1;
+                primary_backend =
+                    static_new<GamecubeAdapterBackend>(input_sources, input_source_count);
+                static CommunicationBackend *backends_storage[] = { primary_backend };
+                backends = backends_storage;
+                // The adapter has to be the only USB interface, so there's no serial port to be
+                // configured over.
+                has_serial = false;
+                break;
+            }
+            case UsbBackend::SWITCH_PRO: {
+                backend_count = 1;
+                primary_backend = static_new<SwitchProBackend>(input_sources, input_source_count);
+                static CommunicationBackend *backends_storage[] = { primary_backend };
+                backends = backends_storage;
+                primary_backend->SetInputRecorder(&input_recorder);
+
+                // Default to Ultimate mode on Switch.
+                set_mode<Ultimate>(primary_backend, socd::SOCD_2IP);
+                setup_config_protocol(primary_backend);
+                return;
+            }
+            case UsbBackend::DINPUT: {
+                TUCompositeHID::registerDescriptors<TUGamepad, TUKeyboard>();
+                backend_count = 2;
+                primary_backend = static_new<DInputBackend>(input_sources, input_source_count);
+                static CommunicationBackend *backends_storage[] = {
+                    primary_backend, static_new<B0XXInputViewer>(input_sources, input_source_count)
+                };
+                backends = backends_storage;
+                break;
+            }
+            default: {
+                backend_count = 2;
+                primary_backend = static_new<XInputBackend>(input_sources, input_source_count);
+                static CommunicationBackend *backends_storage[] = {
+                    primary_backend, static_new<B0XXInputViewer>(input_sources, input_source_count)
+                };
+                backends = backends_storage;
+                break;
+            }
         }
     } else {
         if (console == ConnectedConsole::GAMECUBE) {
             primary_backend =
-                new GamecubeBackend(input_sources, input_source_count, pinout.joybus_data);
+                static_new<GamecubeBackend>(input_sources, input_source_count, pinout.joybus_data);
         } else if (console == ConnectedConsole::N64) {
-            primary_backend = new N64Backend(input_sources, input_source_count, pinout.joybus_data);
+            primary_backend =
+                static_new<N64Backend>(input_sources, input_source_count, pinout.joybus_data);
         }
 
         // If console then only using 1 backend (no input viewer).
         backend_count = 1;
-        backends = new CommunicationBackend *[backend_count] { primary_backend };
+        static CommunicationBackend *backends_storage[] = { primary_backend };
+        backends = backends_storage;
     }
 
-    // Default to Melee mode.
-    primary_backend->SetGameMode(
-        new Melee20Button(socd::SOCD_2IP_NO_REAC, { .crouch_walk_os = false })
-    );
+    primary_backend->SetInputRecorder(&input_recorder);
+
+    // Go back to the mode that was used last, or the profile's default mode, or default to Melee
+    // mode.
+    if (!restore_mode(primary_backend)) {
+        select_melee(primary_backend);
+    }
+
+    if (has_serial) {
+        setup_config_protocol(primary_backend);
+    }
 }
 
 void loop() {
@@ -141,9 +313,20 @@ void loop() {
         backends[i]->SendReport();
     }
 
+    // Save any settings that changed, but only once the backend has time for it.
+    if (settings.Pending() && backends[0]->CanStall(settings.CommitTimeUs())) {
+        settings.Commit();
+    }
+
     if (current_kb_mode != nullptr) {
         current_kb_mode->SendReport(backends[0]->GetInputs());
     }
+
+    // A little of any configuration request at a time, so the next report is never held up.
+    if (config_serial != nullptr) {
+        config_serial->Service();
+        config_commands->Update();
+    }
 }
 
 /* Nunchuk code runs on the second core */
@@ -155,12 +338,16 @@ void setup1() {
     }
 
     // Create Nunchuk input source.
-    nunchuk = new NunchukInput(Wire, pinout.nunchuk_detect, pinout.nunchuk_sda, pinout.nunchuk_scl);
+    nunchuk = static_new<NunchukInput>(
+        i2c0,
+        pinout.nunchuk_detect,
+        pinout.nunchuk_sda,
+        pinout.nunchuk_scl
+    );
 }
 
 void loop1() {
     if (backends != nullptr) {
         nunchuk->UpdateInputs(backends[0]->GetInputs());
-        busy_wait_us(50);
     }
 }
@@ -0,0 +1,68 @@
+#ifndef _COMMS_GC_ADAPTER_HPP
+#define _COMMS_GC_ADAPTER_HPP
+
+#include "core/state.hpp"
+#include "stdlib.hpp"
+
+#define GC_ADAPTER_VID 0x057E
+#define GC_ADAPTER_PID 0x0337
+
+#define GC_ADAPTER_PORT_COUNT 4
+#define GC_ADAPTER_PORT_SIZE 9
+// Report ID followed by the state of each port.
+#define GC_ADAPTER_REPORT_SIZE (1 + GC_ADAPTER_PORT_COUNT * GC_ADAPTER_PORT_SIZE)
+// Rumble command ID followed by one byte for each port.
+#define GC_ADAPTER_RUMBLE_SIZE (1 + GC_ADAPTER_PORT_COUNT)
+
+/*
+ * Protocol of the official GameCube controller adapter for Wii U/Switch (WUP-028), as used by
+ * Dolphin. The host sends INIT once and then reads a report with the state of all four ports every
+ * interval, and sends RUMBLE whenever the rumble state of a port changes.
+ */
+namespace gc_adapter {
+    enum Command : uint8_t {
+        RUMBLE = 0x11,
+        INIT = 0x13,
+    };
+
+    enum ReportId : uint8_t {
+        INPUT_REPORT = 0x21,
+    };
+
+    // The type of controller is in the high nibble of the port status.
+    enum PortStatus : uint8_t {
+        PORT_EMPTY = 0x00,
+        PORT_WIRED = 0x10,
+        PORT_WIRELESS = 0x20,
+        // Set when the adapter's second USB cable is plugged in to power rumble.
+        PORT_POWERED = 0x04,
+    };
+
+    enum Buttons1 : uint8_t {
+        BUTTON_A = 1 << 0,
+        BUTTON_B = 1 << 1,
+        BUTTON_X = 1 << 2,
+        BUTTON_Y = 1 << 3,
+        DPAD_LEFT = 1 << 4,
+        DPAD_RIGHT = 1 << 5,
+        DPAD_DOWN = 1 << 6,
+        DPAD_UP = 1 << 7,
+    };
+
+    enum Buttons2 : uint8_t {
+        BUTTON_START = 1 << 0,
+        BUTTON_Z = 1 << 1,
+        BUTTON_R = 1 << 2,
+        BUTTON_L = 1 << 3,
+    };
+
+    // Writes a report with the outputs in the given port (0-3) and the other ports empty. Buttons
+    // are mapped the same way as by GamecubeBackend, and the analog values are passed through as
+    // they are.
+    void encode_report(const OutputState &outputs, uint8_t port, uint8_t *report);
+
+    // Gets whether the host wants the given port to rumble, if the command is a rumble command.
+    bool decode_rumble(const uint8_t *command, size_t len, uint8_t port, bool &rumble);
+}
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef _COMMS_SWITCH_PRO_HPP
+#define _COMMS_SWITCH_PRO_HPP
+
+#include "core/state.hpp"
+#include "stdlib.hpp"
+
+#define SWITCH_PRO_VID 0x057E
+#define SWITCH_PRO_PID 0x2009
+
+// Every report is this long, including the report ID.
+#define SWITCH_PRO_REPORT_SIZE 64
+// Buttons, then the left and right sticks.
+#define SWITCH_PRO_INPUTS_SIZE 9
+
+/*
+ * USB protocol of the Nintendo Switch Pro Controller.
+ *
+ * When it's plugged in, the Switch goes through a handshake of USB commands (report 0x80) and then
+ * tells the controller to stop talking over Bluetooth and send full input reports (0x30) over USB.
+ * After that it sends subcommands (report 0x01) to read the controller's SPI flash for its colours
+ * and stick calibration, set the player lights and so on, each of which gets a reply (0x21).
+ * Protocol keeps track of all of this so that the backend only has to pass reports back and forth.
+ */
+namespace switch_pro {
+    enum ReportId : uint8_t {
+        // Host to controller.
+        RUMBLE_AND_SUBCOMMAND = 0x01,
+        RUMBLE_ONLY = 0x10,
+        USB_COMMAND = 0x80,
+
+        // Controller to host.
+        SUBCOMMAND_REPLY = 0x21,
+        FULL_INPUT = 0x30,
+        USB_REPLY = 0x81,
+    };
+
+    enum UsbCommand : uint8_t {
+        USB_STATUS = 0x01,
+        USB_HANDSHAKE = 0x02,
+        USB_BAUDRATE = 0x03,
+        USB_HID_ONLY = 0x04,
+        USB_ENABLE_TIMEOUT = 0x05,
+    };
+
+    enum Subcommand : uint8_t {
+        BLUETOOTH_PAIRING = 0x01,
+        DEVICE_INFO = 0x02,
+        SET_REPORT_MODE = 0x03,
+        TRIGGER_ELAPSED_TIME = 0x04,
+        SPI_READ = 0x10,
+        SET_MCU_CONFIG = 0x21,
+    };
+
+    // Packs the outputs into the button and stick bytes of an input report. Buttons are mapped the
+    // same way as by NintendoSwitchBackend. The sticks are sent as 12-bit values, and the stick
+    // calibration in SPI flash does the scaling so that the Switch gets more precise positions.
+    void encode_inputs(const OutputState &outputs, uint8_t *inputs);
+
+    // A byte of the controller's SPI flash. Anything we don't emulate reads as erased (0xFF).
+    uint8_t spi_read(uint32_t address);
+
+    class Protocol {
+      public:
+        // Handles a report sent by the host, starting with its report ID.
+        void HandleOutputReport(const uint8_t *report, size_t len);
+
+        // Writes the next report to send to the host, starting with its report ID, and returns its
+        // length. A reply to the last command takes priority over full input reports, which are
+        // only sent once the host has asked for them. Returns 0 if there's nothing to send.
+        size_t NextInputReport(const OutputState &outputs, uint8_t *report);
+
+        // Whether the host has finished the handshake and wants full input reports.
+        bool Streaming();
+
+      private:
+        bool _streaming = false;
+        uint8_t _timer = 0;
+
+        // Everything after the report ID and, for subcommand replies, the input state.
+        uint8_t _reply[SWITCH_PRO_REPORT_SIZE];
+        uint8_t _reply_id = 0;
+        volatile bool _reply_pending = false;
+
+        void HandleUsbCommand(const uint8_t *report, size_t len);
+        void HandleSubcommand(const uint8_t *report, size_t len);
+        uint8_t *StartSubcommandReply(uint8_t ack, uint8_t subcommand);
+        void SendReply(uint8_t report_id);
+    };
+}
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef _CORE_COMBOENGINE_HPP
+#define _CORE_COMBOENGINE_HPP
+
+#include "core/state.hpp"
+#include "stdlib.hpp"
+
+#ifndef MAX_COMBOS
+#define MAX_COMBOS 16
+#endif
+
+class CommunicationBackend;
+
+namespace combo {
+    typedef void (*Action)(CommunicationBackend *backend);
+
+    typedef struct {
+        // Buttons (from BUTTON_BIT()) that are checked, and which of those must be held.
+        uint32_t mask;
+        uint32_t match;
+        // How long the combo must be held before it fires.
+        uint16_t hold_ms;
+        // Can be nullptr if the caller only needs to know when the combo fires from Update().
+        Action action;
+    } Combo;
+
+    // A combo that fires when all of the held buttons and none of the unless buttons are pressed.
+    constexpr Combo chord(uint32_t held, uint32_t unless, Action action, uint16_t hold_ms = 0) {
+        return Combo{ held | unless, held, hold_ms, action };
+    }
+}
+
+/*
+ * Matches button combos such as the mode selection bindings against the current inputs.
+ *
+ * Every combo is checked with one mask comparison against the packed buttons, and a combo only
+ * fires once each time it is pressed rather than on every update while it is held. A combo with a
+ * hold time fires once it has been held that long. If more than one combo is ready in the same
+ * update, the one listed first wins, and the others are treated as having fired too so that they
+ * don't go off afterwards.
+ */
+class ComboEngine {
+  public:
+    // The combo table is expected to be declared PROGMEM.
+    template <size_t N>
+    ComboEngine(const combo::Combo (&combos)[N]) : _combos(combos), _combo_count(N) {
+        static_assert(N <= MAX_COMBOS, "Too many combos, increase MAX_COMBOS");
+    }
+
+    // Runs the action of the combo that fired, if any, and returns whether one did.
+    bool Update(const InputState &inputs, CommunicationBackend *backend);
+
+  private:
+    static_assert(MAX_COMBOS <= 32, "MAX_COMBOS is more than fits in a combo mask");
+
+    const combo::Combo *_combos;
+    size_t _combo_count;
+
+    // Combos that were held on the last update.
+    uint32_t _held = 0;
+    // Held combos that have already fired.
+    uint32_t _fired = 0;
+    // Low bits of millis() when each held combo was pressed.
+    uint16_t _held_since[MAX_COMBOS];
+};
+
+#endif
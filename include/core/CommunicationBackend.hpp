@@ -2,8 +2,24 @@
 #define _CORE_COMMUNICATIONBACKEND_HPP
 
 #include "core/ControllerMode.hpp"
+#include "core/FrameClock.hpp"
+#include "core/InputRecorder.hpp"
 #include "core/InputSource.hpp"
 #include "state.hpp"
+#include "stdlib.hpp"
+
+#ifndef MAX_INPUT_SOURCES
+#define MAX_INPUT_SOURCES 8
+#endif
+
+#define INPUT_SCAN_SPEED_COUNT 3
+
+// Number of input sources in a config's input_sources array, checked against MAX_INPUT_SOURCES
+// when the config is built rather than when the board boots.
+template <size_t count> constexpr size_t input_source_count_of(InputSource *(&)[count]) {
+    static_assert(count <= MAX_INPUT_SOURCES, "More input sources than MAX_INPUT_SOURCES");
+    return count;
+}
 
 class CommunicationBackend {
   public:
@@ -14,9 +30,42 @@ class CommunicationBackend {
     void ScanInputs();
     void ScanInputs(InputScanSpeed input_source_filter);
 
+    // Only scan slow input sources once every interval_ms instead of on every report. 0 scans them
+    // every time.
+    void SetSlowScanInterval(uint32_t interval_ms);
+
+    // Any fast input source that takes longer than budget_us to scan gets demoted to medium, so
+    // that it's no longer scanned while we're responding to a poll. 0 disables this.
+    void SetFastScanBudget(uint32_t budget_us);
+
+    // Typical time in microseconds that the given fast input source takes to scan, averaged over
+    // its recent scans. Only measured while a fast scan budget is set.
+    uint32_t GetScanCost(size_t input_source_index);
+
+    // Waits for duration_us. With HAYBOX_PRESS_TIMES, fast input sources are scanned over and over
+    // in the meantime so that they can tell more precisely when each button was pressed (see
+    // InputState::press_times).
+    void SampleInputs(uint32_t duration_us);
+
     void UpdateOutputs();
     virtual void SetGameMode(ControllerMode *gamemode);
 
+    // Estimates the game frame for the current mode. Console backends feed it their polls, and
+    // for USB it runs at the frame rate set here (60 Hz by default).
+    FrameClock &GetFrameClock();
+
+    // Captures the inputs of every report, as they were before the mode handled them. nullptr
+    // stops recording.
+    void SetInputRecorder(InputRecorder *recorder);
+
+    // Microseconds from power-on until the host got the first report, or 0 if it hasn't yet.
+    uint32_t TimeToFirstReport();
+
+    // Whether everything can stop for duration_us right now (e.g. to write to flash) without
+    // missing a poll. A USB host just gets the next report late, but console backends have to
+    // know that the next poll is far enough away.
+    virtual bool CanStall(uint32_t duration_us);
+
     virtual void SendReport() = 0;
 
   protected:
@@ -26,9 +75,36 @@ class CommunicationBackend {
 
     OutputState _outputs;
     ControllerMode *_gamemode;
+    FrameClock _frame_clock;
+    InputRecorder *_input_recorder = nullptr;
+
+    // Backends call this when a report has been sent to the host.
+    void ReportSent();
+
+    // For backends that wait for the host before each report. Until the host is ready there's
+    // nothing to wait for, so this finishes the report without sending it and returns true, which
+    // lets the rest of the loop carry on. The host gets whatever the current state is once it's
+    // ready.
+    bool SkipUnlessReady(bool ready);
 
   private:
+    // Indices into _input_sources, grouped by scan speed once at construction so we don't have to
+    // ask every input source for its scan speed on every scan.
+    uint8_t _scan_lists[INPUT_SCAN_SPEED_COUNT][MAX_INPUT_SOURCES];
+    uint8_t _scan_list_lengths[INPUT_SCAN_SPEED_COUNT] = {};
+    // Running average of each source's scan time, in eighths of a microsecond.
+    uint16_t _scan_costs_x8[MAX_INPUT_SOURCES] = {};
+    // Same for a whole fast scan, for SampleInputs().
+    uint16_t _fast_scan_cost_x8 = 0;
+
+    uint32_t _slow_scan_interval_ms = 0;
+    uint32_t _last_slow_scan = 0;
+    bool _slow_scanned = false;
+    uint32_t _fast_scan_budget_us = 0;
+    uint32_t _first_report_us = 0;
+
     void ResetOutputs();
+    void DemoteOverBudgetSources();
 };
 
 #endif
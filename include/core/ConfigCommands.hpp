@@ -0,0 +1,108 @@
+#ifndef _CORE_CONFIGCOMMANDS_HPP
+#define _CORE_CONFIGCOMMANDS_HPP
+
+#include "core/CommunicationBackend.hpp"
+#include "core/ConfigProtocol.hpp"
+#include "core/InputRecorder.hpp"
+#include "stdlib.hpp"
+
+// Largest profile that can be written over serial.
+#define CONFIG_PROFILE_BUFFER_SIZE 256
+// Records per DUMP_INPUTS reply.
+#define CONFIG_DUMP_RECORDS_PER_REPLY (CONFIG_MAX_PAYLOAD / INPUT_CAPTURE_RECORD_SIZE)
+
+/*
+ * The commands in config_protocol, for the primary backend.
+ *
+ * GET_STATS: time to first report, console's first reply and end of console detection as 4 bytes
+ * each, flags (CONFIG_STATS_*), then the frame clock's boundary count as 4 bytes, and its average
+ * and max error as 2 bytes each.
+ *
+ * SET_MODE: ModeId as 2 bytes. INVALID if there's no such mode. Otherwise the mode is selected by
+ * the next Update(), so that building it doesn't count towards the protocol's slice.
+ *
+ * READ_PROFILE: offset as 2 bytes and length, which replies with that part of the stored profile.
+ * WRITE_PROFILE: offset as 2 bytes followed by data, which is written to a buffer in RAM.
+ * SAVE_PROFILE: length as 2 bytes. Checks the profile in the buffer and replies INVALID if it's no
+ * good. Otherwise it's written to storage once the backend can spare the time.
+ *
+ * DUMP_INPUTS: replies with the capture header, then the recorded inputs a few at a time in the
+ * same format as InputRecorder::Dump(), and finally an empty reply. Recording is paused until
+ * it's done.
+ */
+#define CONFIG_STATS_CONSOLE_REMEMBERED (1 << 0)
+#define CONFIG_STATS_FRAME_CLOCK_LOCKED (1 << 1)
+#define CONFIG_STATS_PROFILE_SAVE_PENDING (1 << 2)
+// Built with HAYBOX_PRESS_TIMES, without which profiles using SOCD_2IP_TIMESTAMP are refused.
+#define CONFIG_STATS_PRESS_TIMES (1 << 3)
+
+class ConfigCommands : public ConfigHandler {
+  public:
+    // select_mode takes a ModeId below mode_count.
+    ConfigCommands(
+        CommunicationBackend *backend,
+        InputRecorder *recorder,
+        bool (*select_mode)(CommunicationBackend *backend, uint16_t mode),
+        uint16_t mode_count
+    );
+
+    // Where the profile is kept, which pins it can use (see Profile::Open()), how to replace it, and
+    // the longest that replacing it can take. The profile commands reply UNSUPPORTED without this.
+    void SetProfileStorage(
+        const uint8_t *profile,
+        size_t max_size,
+        uint32_t usable_pins,
+        void (*write_profile)(const uint8_t *data, size_t len),
+        uint32_t write_time_us
+    );
+    void SetConsoleDetection(uint32_t first_reply_us, uint32_t finished_us, bool remembered);
+
+    // Selects a mode from SET_MODE, and writes a saved profile to storage once the backend can
+    // spare the time. Call once per loop, after ConfigProtocol::Service().
+    void Update();
+
+    uint8_t Handle(
+        uint8_t command,
+        const uint8_t *payload,
+        uint8_t length,
+        uint8_t *reply,
+        uint8_t &reply_length
+    );
+    uint8_t Continue(uint8_t command, uint8_t *reply, uint8_t &reply_length);
+    void Abort(uint8_t command);
+
+  private:
+    CommunicationBackend *_backend;
+    InputRecorder *_recorder;
+    bool (*_select_mode)(CommunicationBackend *backend, uint16_t mode);
+    uint16_t _mode_count;
+    bool _mode_pending = false;
+    uint16_t _pending_mode = 0;
+
+    const uint8_t *_profile = nullptr;
+    size_t _profile_max_size = 0;
+    uint32_t _profile_pins = 0;
+    void (*_write_profile)(const uint8_t *data, size_t len) = nullptr;
+    uint32_t _profile_write_time_us = 0;
+    uint8_t _profile_buffer[CONFIG_PROFILE_BUFFER_SIZE];
+    size_t _profile_save_length = 0;
+
+    uint32_t _console_first_reply_us = 0;
+    uint32_t _console_finished_us = 0;
+    bool _console_remembered = false;
+
+    size_t _dump_next = 0;
+
+    uint8_t GetStats(uint8_t *reply, uint8_t &reply_length);
+    uint8_t ReadProfile(
+        const uint8_t *payload,
+        uint8_t length,
+        uint8_t *reply,
+        uint8_t &reply_length
+    );
+    uint8_t WriteProfile(const uint8_t *payload, uint8_t length);
+    uint8_t SaveProfile(const uint8_t *payload, uint8_t length);
+    uint8_t StartDump(uint8_t *reply, uint8_t &reply_length);
+};
+
+#endif
@@ -0,0 +1,131 @@
+#ifndef _CORE_CONFIGPROTOCOL_HPP
+#define _CORE_CONFIGPROTOCOL_HPP
+
+#include "stdlib.hpp"
+
+#define CONFIG_PROTOCOL_VERSION 1
+
+/*
+ * Framing, as used by builder_scripts/configurator.py.
+ *
+ * Request: CONFIG_REQUEST_SYNC, command, payload length, payload, then a CRC-8 of everything after
+ * the sync byte.
+ * Reply: CONFIG_REPLY_SYNC, command, status, payload length, payload, then a CRC-8 the same way.
+ *
+ * Replies can be mixed in with other output on the same port, e.g. from the input viewer, but are
+ * never split up by it.
+ */
+#define CONFIG_REQUEST_SYNC 0xA5
+#define CONFIG_REPLY_SYNC 0x5A
+#define CONFIG_MAX_PAYLOAD 64
+#define CONFIG_REQUEST_OVERHEAD 4
+#define CONFIG_REPLY_OVERHEAD 5
+
+#define CONFIG_TX_BUFFER_SIZE 256
+// Most bytes that one call to ConfigProtocol::Service() reads and writes. This only bounds the
+// serial side of a slice. Handlers have to keep their own part short as well, and leave anything
+// slow, like building a mode or writing to flash, for later (see ConfigCommands::Update()).
+// LongestSliceUs() is what a slice actually took.
+#define CONFIG_RX_BYTES_PER_SLICE 16
+#define CONFIG_TX_BYTES_PER_SLICE 128
+// A request that stops partway through for this long gets dropped.
+#define CONFIG_REQUEST_TIMEOUT_US 100000
+// A request with more replies to come gets dropped if none of them can be sent for this long,
+// e.g. because the configurator went away in the middle of a dump.
+#define CONFIG_CONTINUE_TIMEOUT_US 500000
+
+namespace config_protocol {
+    enum Command : uint8_t {
+        // Handled by ConfigProtocol itself: version, biggest payload, and the longest time that a
+        // Service() call has taken so far in microseconds as 2 bytes.
+        INFO = 0x01,
+        // The rest are handled by a ConfigHandler such as ConfigCommands.
+        GET_STATS = 0x02,
+        SET_MODE = 0x03,
+        READ_PROFILE = 0x04,
+        WRITE_PROFILE = 0x05,
+        SAVE_PROFILE = 0x06,
+        DUMP_INPUTS = 0x07,
+    };
+
+    enum Status : uint8_t {
+        OK = 0x00,
+        // More replies to the same request follow this one.
+        MORE = 0x01,
+        UNKNOWN_COMMAND = 0x02,
+        BAD_REQUEST = 0x03,
+        BAD_CHECKSUM = 0x04,
+        UNSUPPORTED = 0x05,
+        INVALID = 0x06,
+    };
+}
+
+class ConfigHandler {
+  public:
+    virtual ~ConfigHandler(){};
+
+    // Handles a request, writing up to CONFIG_MAX_PAYLOAD bytes of reply payload. Returning
+    // config_protocol::MORE sends this reply, then calls Continue() for the next one once there's
+    // room for it, until that returns anything else.
+    virtual uint8_t Handle(
+        uint8_t command,
+        const uint8_t *payload,
+        uint8_t length,
+        uint8_t *reply,
+        uint8_t &reply_length
+    ) = 0;
+    virtual uint8_t Continue(uint8_t command, uint8_t *reply, uint8_t &reply_length) = 0;
+    // Called instead of Continue() when the rest of the replies are given up on, to undo anything
+    // that Handle() left in place until the last one.
+    virtual void Abort(uint8_t command) = 0;
+};
+
+/*
+ * A binary command protocol over the serial port, for configuring the controller while it's in
+ * use.
+ *
+ * Everything happens in Service(), which the config calls once per loop after sending reports. Each
+ * call reads and writes a bounded number of bytes, handles at most one request or reply, and never
+ * waits on the serial port. Replies go into a ring buffer first and are only written out as whole
+ * frames, once the serial port has room for them.
+ *
+ * A request with more replies to come is dropped when a new request starts, as the configurator
+ * must have given up on it, or when the replies stop going out for CONFIG_CONTINUE_TIMEOUT_US.
+ */
+class ConfigProtocol {
+  public:
+    ConfigProtocol(ConfigHandler &handler);
+
+    void Service();
+
+    // Longest that Service() has taken so far, in microseconds.
+    uint32_t LongestSliceUs();
+
+  private:
+    ConfigHandler &_handler;
+
+    uint8_t _request[CONFIG_REQUEST_OVERHEAD + CONFIG_MAX_PAYLOAD];
+    size_t _request_length = 0;
+    uint32_t _last_receive_us = 0;
+
+    uint8_t _tx[CONFIG_TX_BUFFER_SIZE];
+    size_t _tx_start = 0;
+    size_t _tx_count = 0;
+
+    bool _continuing = false;
+    uint8_t _continue_command = 0;
+    uint32_t _last_reply_us = 0;
+    uint32_t _longest_slice_us = 0;
+
+    void Flush();
+    void Continue(uint32_t now_us);
+    void Abort();
+    void Receive(uint32_t now_us);
+    void HandleRequest(uint32_t now_us);
+    bool RoomForReply();
+    void Reply(uint8_t command, uint8_t status, const uint8_t *payload, uint8_t length);
+    void PushByte(uint8_t byte);
+    uint8_t TxByte(size_t index);
+};
+
+#endif
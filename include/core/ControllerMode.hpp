@@ -1,14 +1,17 @@
 #ifndef _CORE_CONTROLLERMODE_HPP
 #define _CORE_CONTROLLERMODE_HPP
 
+#include "core/FrameClock.hpp"
 #include "core/InputMode.hpp"
 #include "core/socd.hpp"
+#include "core/stages.hpp"
 #include "core/state.hpp"
+#include "core/stick_rules.hpp"
 
 class ControllerMode : public InputMode {
   public:
     ControllerMode();
-    void UpdateOutputs(InputState &inputs, OutputState &outputs);
+    virtual void UpdateOutputs(InputState &inputs, OutputState &outputs);
     void ResetDirections();
     virtual void UpdateDirections(
         bool lsLeft,
@@ -24,13 +27,122 @@ class ControllerMode : public InputMode {
         uint8_t analogStickMax,
         OutputState &outputs
     );
+    void SetFrameClock(const FrameClock *frame_clock);
 
   protected:
     StickDirections directions;
 
+    // Current game frame as estimated by the backend's frame clock (always 0 without one), and the
+    // number of frames that have gone by since an earlier Frame().
+    uint32_t Frame();
+    uint32_t FramesSince(uint32_t frame);
+
+    // Called once for each frame boundary since the last report, before the outputs are updated.
+    virtual void OnFrameBoundary(uint32_t frame) {}
+
+    // Moves frame on to the next boundary that OnFrameBoundary() hasn't been called for yet, if
+    // there is one.
+    bool NextFrameBoundary(uint32_t &frame);
+
+    // The order in which every mode updates its outputs. Steps has the same OnFrameBoundary(),
+    // HandleSocd(), UpdateDigitalOutputs() and UpdateAnalogOutputs() as a mode: this class passes
+    // itself, so they go through the vtable, and StaticControllerMode passes something that calls
+    // the derived mode's own directly.
+    template <typename Steps>
+    void UpdateOutputsWith(Steps &steps, InputState &inputs, OutputState &outputs) {
+        uint32_t frame;
+        while (NextFrameBoundary(frame)) {
+            steps.OnFrameBoundary(frame);
+        }
+        steps.HandleSocd(inputs);
+        steps.UpdateDigitalOutputs(inputs, outputs);
+        steps.UpdateAnalogOutputs(inputs, outputs);
+    }
+
+    uint32_t StickConditions(const InputState &inputs);
+    void ApplyStickRules(
+        const stick_rules::StickRule *rules,
+        size_t rule_count,
+        uint32_t conditions,
+        uint8_t analogStickNeutral,
+        OutputState &outputs
+    );
+
+    // Rule tables are expected to be declared PROGMEM.
+    template <size_t N>
+    void ApplyStickRules(
+        const stick_rules::StickRule (&rules)[N],
+        uint32_t conditions,
+        uint8_t analogStickNeutral,
+        OutputState &outputs
+    ) {
+        ApplyStickRules(rules, N, conditions, analogStickNeutral, outputs);
+    }
+
+    // The lookup table is expected to be declared PROGMEM.
+    void ApplyStickLut(
+        const stick_rules::StickLut *lut,
+        uint32_t conditions,
+        uint8_t analogStickNeutral,
+        OutputState &outputs
+    );
+
   private:
+    const FrameClock *_frame_clock = nullptr;
+    uint32_t _last_frame_boundary = 0;
+
+    void ApplyStickOutput(
+        const stick_rules::StickOutput &output,
+        uint8_t analogStickNeutral,
+        OutputState &outputs
+    );
+
     virtual void UpdateDigitalOutputs(InputState &inputs, OutputState &outputs) = 0;
     virtual void UpdateAnalogOutputs(InputState &inputs, OutputState &outputs) = 0;
 };
 
+/*
+ * Modes deriving from StaticControllerMode<Mode> have their SOCD handling and output updates called
+ * directly instead of through the vtable, which lets the compiler inline the whole of
+ * UpdateOutputs() for that mode. That leaves just one virtual call per report. The mode must
+ * declare StaticControllerMode<Mode> as a friend if those functions are private.
+ *
+ * The optional Stages pipeline (see core/stages.hpp) is run after each of the mode's own updates,
+ * and is passed in through the constructor by the mode.
+ */
+template <typename Derived, typename Stages = stages::Pipeline<>>
+class StaticControllerMode : public ControllerMode {
+  public:
+    StaticControllerMode(const Stages &stages = Stages()) : _stages(stages) {}
+
+    void UpdateOutputs(InputState &inputs, OutputState &outputs) final {
+        DirectSteps steps{ static_cast<Derived &>(*this), _stages };
+        UpdateOutputsWith(steps, inputs, outputs);
+    }
+
+  private:
+    Stages _stages;
+
+    // Steps for UpdateOutputsWith() that call the mode's own functions directly, each followed by
+    // the stages.
+    struct DirectSteps {
+        Derived &mode;
+        Stages &stages;
+
+        void OnFrameBoundary(uint32_t frame) { mode.Derived::OnFrameBoundary(frame); }
+
+        void HandleSocd(InputState &inputs) { mode.Derived::HandleSocd(inputs); }
+
+        void UpdateDigitalOutputs(InputState &inputs, OutputState &outputs) {
+            mode.Derived::UpdateDigitalOutputs(inputs, outputs);
+            stages.UpdateDigitalOutputs(inputs, outputs);
+        }
+
+        void UpdateAnalogOutputs(InputState &inputs, OutputState &outputs) {
+            mode.Derived::UpdateAnalogOutputs(inputs, outputs);
+            stages.UpdateAnalogOutputs(inputs, outputs);
+        }
+    };
+};
+
 #endif
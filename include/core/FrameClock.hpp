@@ -0,0 +1,66 @@
+#ifndef _CORE_FRAMECLOCK_HPP
+#define _CORE_FRAMECLOCK_HPP
+
+#include "stdlib.hpp"
+
+// Frame period in microseconds for a 60 Hz PC game and for a (59.94 Hz) NTSC console.
+#define FRAME_PERIOD_60HZ_US 16667
+#define FRAME_PERIOD_NTSC_US 16683
+
+/*
+ * Estimates which game frame we're in, so that modes can time things in frames rather than in
+ * reports, whose rate depends on the backend.
+ *
+ * Without anything to go on, frames just tick over at the configured rate. Console backends also
+ * report each poll, and since games poll once per frame (or in a burst of polls once per frame), the
+ * first poll after a gap of at least half a frame marks a frame boundary. Each of those nudges the
+ * estimated phase and period towards where the boundaries actually are. The estimate counts as
+ * locked once enough boundaries in a row land close to where it predicted.
+ */
+class FrameClock {
+  public:
+    typedef struct {
+        bool locked;
+        // Number of frame boundaries seen in polls since the estimate was last reset.
+        uint32_t boundaries;
+        // Difference between where the boundaries were predicted and where the polls said they
+        // were, in microseconds. Only covers boundaries seen while locked.
+        uint16_t average_error_us;
+        uint16_t max_error_us;
+    } Stats;
+
+    FrameClock(uint32_t frame_period_us = FRAME_PERIOD_60HZ_US);
+
+    // Nominal frame period, e.g. for a USB host running at a known rate.
+    void SetFramePeriod(uint32_t frame_period_us);
+
+    // Called by console backends at the start of every poll.
+    void Poll(uint32_t now_us);
+
+    // Brings the frame count up to date. Called before every report.
+    void Update(uint32_t now_us);
+
+    uint32_t Frame() const;
+    uint32_t FramesSince(uint32_t frame) const;
+    uint32_t FramePeriodUs() const;
+    Stats GetStats() const;
+
+  private:
+    uint32_t _nominal_period_us;
+    uint32_t _period_us;
+    uint32_t _frame = 0;
+    uint32_t _next_boundary_us = 0;
+    bool _started = false;
+
+    uint32_t _last_poll_us = 0;
+    bool _polled = false;
+    uint8_t _consistent_boundaries = 0;
+    uint32_t _boundaries = 0;
+    // Exponential moving average of the error, times 16.
+    uint32_t _average_error_x16 = 0;
+    uint16_t _max_error_us = 0;
+
+    void Restart(uint32_t boundary_us);
+};
+
+#endif
@@ -4,19 +4,57 @@
 #include "socd.hpp"
 #include "state.hpp"
 
+#ifndef MAX_SOCD_PAIRS
+#define MAX_SOCD_PAIRS 4
+#endif
+
 class InputMode {
   public:
     InputMode();
     virtual ~InputMode();
 
+    // Modes only ever live in static storage (see set_mode() in config/mode_selection.hpp), so they
+    // can only be constructed with placement new, and deleting one just runs its destructor.
+    static void *operator new(size_t size, void *ptr) { return ptr; }
+
+    static void operator delete(void *ptr) {}
+
+    // Replaces the mode's own SOCD pairs, e.g. with the ones from a profile. Any past
+    // MAX_SOCD_PAIRS are left out.
+    void SetSocdPairs(const socd::SocdPair *socd_pairs, size_t count);
+
   protected:
-    socd::SocdPair *_socd_pairs = nullptr;
+    socd::SocdPair _socd_pairs[MAX_SOCD_PAIRS];
     size_t _socd_pair_count = 0;
 
+    template <size_t N> void SetSocdPairs(const socd::SocdPair (&socd_pairs)[N]) {
+        static_assert(N <= MAX_SOCD_PAIRS, "Too many SOCD pairs, increase MAX_SOCD_PAIRS");
+        SetSocdPairs(socd_pairs, N);
+    }
+
     virtual void HandleSocd(InputState &inputs);
 
   private:
-    socd::SocdState *_socd_states = nullptr;
+    static_assert(
+        MAX_SOCD_PAIRS <= sizeof(socd::PairMask) * 8,
+        "MAX_SOCD_PAIRS is more than fits in socd::PairMask"
+    );
+
+    /*
+     * Pairs are resolved all at once by socd::resolve(), except that a pair which shares a button
+     * with an earlier one has to see that pair's result, so it goes in a later stage. Most modes
+     * only need one stage.
+     */
+    socd::PairMasks _socd_stages[MAX_SOCD_PAIRS];
+    size_t _socd_stage_count = 0;
+    socd::PairStates _socd_states;
+
+    // Bit of each pair's buttons in the word returned by pack_buttons(), so that HandleSocd() can
+    // work on that word alone.
+    uint8_t _socd_dir1_bits[MAX_SOCD_PAIRS];
+    uint8_t _socd_dir2_bits[MAX_SOCD_PAIRS];
+
+    void UpdateSocdStages();
 };
 
 #endif
@@ -0,0 +1,66 @@
+#ifndef _CORE_INPUTRECORDER_HPP
+#define _CORE_INPUTRECORDER_HPP
+
+#include "core/state.hpp"
+#include "stdlib.hpp"
+
+// Capture format written by InputRecorder::Dump(). All numbers are little-endian.
+#define INPUT_CAPTURE_MAGIC "HBIR"
+#define INPUT_CAPTURE_VERSION 1
+// Magic, version, record size, 2 reserved bytes, then the record count as 4 bytes.
+#define INPUT_CAPTURE_HEADER_SIZE 12
+#define INPUT_CAPTURE_RECORD_SIZE 12
+
+// Nunchuk buttons, stored in InputRecorder::Record::buttons after the rectangle inputs.
+#define CAPTURE_NUNCHUK_CONNECTED (1UL << RECTANGLE_INPUT_COUNT)
+#define CAPTURE_NUNCHUK_C (1UL << (RECTANGLE_INPUT_COUNT + 1))
+#define CAPTURE_NUNCHUK_Z (1UL << (RECTANGLE_INPUT_COUNT + 2))
+
+/*
+ * Records the raw inputs that a backend reports, before the mode does anything with them, so that a
+ * session can be dumped over USB serial with the configurator's DUMP_INPUTS request and replayed
+ * through a mode on the host by builder_scripts/replay.py.
+ *
+ * A new record is only added when the inputs change, and counts how many reports in a row had the
+ * same inputs. Once the buffer is full, the oldest records get overwritten.
+ */
+class InputRecorder {
+  public:
+    typedef struct {
+        // micros() at the first report with these inputs.
+        uint32_t time_us;
+        // pack_buttons(), plus the CAPTURE_NUNCHUK_* bits.
+        uint32_t buttons;
+        int8_t nunchuk_x;
+        int8_t nunchuk_y;
+        uint16_t reports;
+    } Record;
+
+    template <size_t N> InputRecorder(Record (&buffer)[N]) : _buffer(buffer), _capacity(N) {}
+
+    void Capture(const InputState &inputs, uint32_t now_us);
+    void Clear();
+    size_t Count();
+    // Records in the order they were captured, starting from the oldest one still in the buffer.
+    const Record &Get(size_t index);
+
+    // Writes out the header followed by every record, oldest first.
+    void Dump(void (*write)(uint8_t *bytes, size_t len));
+    // Just the header, for writing out the records some other way.
+    void EncodeHeader(uint8_t *bytes);
+
+    static void Encode(const Record &record, uint8_t *bytes);
+    static Record Decode(const uint8_t *bytes);
+
+    // Sets the inputs to those in the record. Buttons that weren't pressed before get the record's
+    // time as their press time.
+    static void Restore(const Record &record, InputState &inputs);
+
+  private:
+    Record *_buffer;
+    size_t _capacity;
+    size_t _next = 0;
+    size_t _count = 0;
+};
+
+#endif
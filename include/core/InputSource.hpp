@@ -15,6 +15,47 @@ class InputSource {
     virtual ~InputSource(){};
     virtual InputScanSpeed ScanSpeed() = 0;
     virtual void UpdateInputs(InputState &inputs) = 0;
+
+  protected:
+    /*
+     * Press times are only tracked when building with HAYBOX_PRESS_TIMES, as only
+     * SOCD_2IP_TIMESTAMP uses them. Otherwise these do nothing and compile away.
+     *
+     * Presses are detected by each input source on its own, so if more than one backend scans
+     * the same source (e.g. the input viewer alongside the main backend), only whichever one
+     * scans first after a press sees it. The others never get a press time for it.
+     */
+#ifdef HAYBOX_PRESS_TIMES
+    // Time to pass to UpdatePressTime(), taken once at the start of a scan.
+    uint32_t ScanTime() { return micros(); }
+
+    // Call for each button on every scan to keep inputs.press_times up to date.
+    void UpdatePressTime(InputState &inputs, bool InputState::*button, bool pressed, uint32_t now) {
+        UpdatePressTime(inputs, button_index(inputs, button), pressed, now);
+    }
+
+    // The same, for the input at the given position in InputState.
+    void UpdatePressTime(InputState &inputs, size_t index, bool pressed, uint32_t now) {
+        if (index >= RECTANGLE_INPUT_COUNT) {
+            return;
+        }
+        if (pressed && !_pressed[index]) {
+            inputs.press_times[index] = now;
+        }
+        _pressed[index] = pressed;
+    }
+
+  private:
+    // Kept separately from InputState because SOCD resolution overwrites the buttons there.
+    bool _pressed[RECTANGLE_INPUT_COUNT] = {};
+#else
+    uint32_t ScanTime() { return 0; }
+
+    void UpdatePressTime(InputState &inputs, bool InputState::*button, bool pressed, uint32_t now) {
+    }
+
+    void UpdatePressTime(InputState &inputs, size_t index, bool pressed, uint32_t now) {}
+#endif
 };
 
 #endif
\ No newline at end of file
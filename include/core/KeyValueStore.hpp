@@ -0,0 +1,70 @@
+#ifndef _CORE_KEYVALUESTORE_HPP
+#define _CORE_KEYVALUESTORE_HPP
+
+#include "stdlib.hpp"
+
+// Keys can be anything from 0 up to this.
+#define KV_MAX_KEYS 8
+// 2 magic bytes followed by a 2 byte sequence number.
+#define KV_HEADER_SIZE 4
+// Key, 2 byte value, then a check byte.
+#define KV_RECORD_SIZE 4
+
+// Settings that HayBox keeps between boots. Only ever add to the end of this list, so that older
+// saved settings still mean the same thing.
+namespace kv {
+    enum Key : uint8_t {
+        LAST_BACKEND,
+        LAST_MODE,
+    };
+}
+
+/*
+ * A few small values that are kept between boots, in the two banks of storage that the HAL gives us
+ * (flash on Pico, EEPROM on AVR).
+ *
+ * Values are appended to the active bank as records, so the latest record for a key wins and flash
+ * doesn't have to be erased for every change. Once the active bank is getting full, the latest
+ * values are copied into the other bank, which spreads the wear over both.
+ *
+ * Set() never touches storage, because a write stalls everything including the response to a
+ * console poll. Instead, the config calls Commit() whenever the backend says that it can spare
+ * CommitTimeUs().
+ */
+class KeyValueStore {
+  public:
+    // Finds the latest values. Call once on boot.
+    void Load();
+
+    // Moves the values into the other bank if the active one is getting full, so that Commit()
+    // rarely has to. This erases storage, so call it on boot before any backend is started.
+    void Compact();
+
+    bool Get(uint8_t key, uint16_t &value);
+    // Only changes the value in RAM. It is saved by a later Commit().
+    void Set(uint8_t key, uint16_t value);
+
+    // Whether there are changes that haven't been saved yet.
+    bool Pending();
+    // Longest that the next Commit() can stall for. That's one write normally, but a lot longer if
+    // the active bank is full and the other one has to be erased first.
+    uint32_t CommitTimeUs();
+    // Saves at most one changed value, or all of them if it has to move to the other bank.
+    void Commit();
+
+  private:
+    uint16_t _values[KV_MAX_KEYS];
+    uint8_t _stored = 0;
+    uint8_t _dirty = 0;
+
+    int8_t _bank = -1;
+    uint16_t _sequence = 0;
+    size_t _end = 0;
+
+    bool Full();
+    size_t StoredCount();
+    void MoveToOtherBank();
+    void WriteRecord(uint8_t bank, size_t offset, uint8_t key);
+};
+
+#endif
@@ -0,0 +1,104 @@
+#ifndef _CORE_MACROENGINE_HPP
+#define _CORE_MACROENGINE_HPP
+
+#include "core/state.hpp"
+#include "stdlib.hpp"
+
+// Digital outputs run from a to rightStickClick in OutputState, and analog ones from leftStickX to
+// triggerLAnalog.
+#define OUTPUT_BUTTON_COUNT 17
+#define OUTPUT_AXIS_COUNT 6
+
+// Bit for a digital output in a macro::Patch, e.g. OUTPUT_BIT(dpadDown).
+#define OUTPUT_BIT(field) (1UL << (offsetof(OutputState, field) - offsetof(OutputState, a)))
+
+namespace macro {
+    enum Unit : uint8_t {
+        MICROSECONDS,
+        FRAMES,
+    };
+
+    // Analog outputs, in OutputState order.
+    enum Axis : uint8_t {
+        LEFT_STICK_X,
+        LEFT_STICK_Y,
+        RIGHT_STICK_X,
+        RIGHT_STICK_Y,
+        TRIGGER_R,
+        TRIGGER_L,
+    };
+
+    // Changes made to the outputs on top of whatever the mode set.
+    typedef struct {
+        // Digital outputs (from OUTPUT_BIT()) to press, and to release.
+        uint32_t press;
+        uint32_t release;
+        // Analog outputs to set (one bit per Axis), and the values to set them to.
+        uint8_t axes;
+        uint8_t axis_values[OUTPUT_AXIS_COUNT];
+    } Patch;
+
+    typedef struct {
+        // When the step starts, counted from when the macro started. Each step lasts until the next
+        // one starts.
+        uint32_t offset;
+        Patch patch;
+    } Step;
+
+    typedef struct {
+        // Steps in order of offset.
+        const Step *steps;
+        uint8_t step_count;
+        Unit unit;
+        // When the macro ends, in the same unit as the step offsets.
+        uint32_t duration;
+    } Macro;
+
+    constexpr Patch press(uint32_t buttons) {
+        return Patch{ buttons, 0, 0, {} };
+    }
+
+    constexpr Patch release(uint32_t buttons) {
+        return Patch{ 0, buttons, 0, {} };
+    }
+
+    // Adds an analog output to a patch, e.g. with_axis(press(OUTPUT_BIT(x)), TRIGGER_R, 140).
+    constexpr Patch with_axis(Patch patch, Axis axis, uint8_t value) {
+        patch.axes |= 1 << axis;
+        patch.axis_values[axis] = value;
+        return patch;
+    }
+}
+
+/*
+ * Plays a short scripted sequence of output changes, such as a shield drop, on top of the outputs
+ * of a mode.
+ *
+ * Steps are timed in microseconds or in game frames (see FrameClock) from when the macro started,
+ * rather than in reports, so a macro plays out the same whatever the report rate. Only one macro
+ * plays at a time, and starting another one replaces it. Each step is read once when it starts, so
+ * applying the macro to a report costs the same whichever step it's on.
+ *
+ * A mode that uses macros keeps its own MacroEngine, so that other modes don't pay for it. It
+ * starts macros with Play(macro, micros(), Frame()), and calls Apply() with the same arguments at
+ * the end of its UpdateAnalogOutputs() if Playing().
+ */
+class MacroEngine {
+  public:
+    // The macro and its steps are expected to be declared PROGMEM.
+    void Play(const macro::Macro *macro, uint32_t now_us, uint32_t frame);
+    void Stop();
+    bool Playing();
+
+    // Applies the current step of the macro, if one is playing, to the outputs.
+    void Apply(uint32_t now_us, uint32_t frame, OutputState &outputs);
+
+  private:
+    macro::Macro _macro;
+    bool _playing = false;
+    uint32_t _start;
+    uint8_t _next_step;
+    macro::Patch _patch;
+};
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef _CORE_PROFILE_HPP
+#define _CORE_PROFILE_HPP
+
+#include "core/socd.hpp"
+#include "core/state.hpp"
+#include "stdlib.hpp"
+
+/*
+ * Profile format, as packed by builder_scripts/profile_tool.py. All numbers are little-endian.
+ *
+ * Header: magic, version, button count, SOCD pair count, default mode (a ModeId from
+ * config/mode_selection.hpp, or PROFILE_NO_MODE), total size as 2 bytes, PROFILE_OPTION_* bits as
+ * 2 bytes, then a CRC-32 of every byte of the profile apart from the CRC itself. After that comes
+ * the name, padded out with zeros, which always ends in at least one zero.
+ *
+ * Then the buttons, each of which is the input's position in InputState (counting from left)
+ * followed by its GPIO pin, and the SOCD pairs, each of which is two inputs, a socd::SocdType and
+ * a zero byte.
+ */
+#define PROFILE_MAGIC "HBPF"
+#define PROFILE_VERSION 1
+#define PROFILE_HEADER_SIZE 16
+#define PROFILE_NAME_SIZE 16
+#define PROFILE_BUTTON_SIZE 2
+#define PROFILE_SOCD_PAIR_SIZE 4
+
+#define PROFILE_NO_MODE 0xFF
+
+// Mode options. Each one is named after the field it sets in the mode's options.
+#define PROFILE_OPTION_CROUCH_WALK_OS (1 << 0)
+#define PROFILE_OPTION_TRUE_Z_PRESS (1 << 1)
+#define PROFILE_OPTION_LEDGEDASH_MAX_JUMP_TRAJ (1 << 2)
+#define PROFILE_OPTION_Z_PRESS_MACRO (1 << 3)
+
+/*
+ * A controller profile (pin mapping, SOCD pairs, default mode and mode options) that is read in
+ * place, e.g. straight out of flash, so that a player can have their own settings without
+ * building their own firmware.
+ */
+class Profile {
+  public:
+    // Checks that data holds a valid profile no longer than max_size, with every button on one of
+    // usable_pins (bit n for GPIO n) and only SOCD types that this build has. Everything is read
+    // from data from then on, so it has to stay where it is.
+    bool Open(const uint8_t *data, size_t max_size, uint32_t usable_pins);
+    bool Valid();
+
+    const char *Name();
+    // PROFILE_NO_MODE if the profile doesn't pick one.
+    uint8_t DefaultMode();
+    bool Option(uint16_t option);
+
+    size_t ButtonCount();
+    // Position in InputState, counting from left.
+    uint8_t ButtonInput(size_t index);
+    uint8_t ButtonPin(size_t index);
+
+    size_t SocdPairCount();
+    socd::SocdPair SocdPair(size_t index);
+
+  private:
+    const uint8_t *_data = nullptr;
+
+    const uint8_t *Buttons();
+    const uint8_t *SocdPairs();
+};
+
+#endif
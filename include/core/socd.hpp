@@ -12,8 +12,20 @@ namespace socd {
         SOCD_DIR1_PRIORITY,
         SOCD_DIR2_PRIORITY,
         SOCD_NONE,
+        // Only there in builds that track press times, so that any other build fails to compile
+        // rather than quietly resolving it like SOCD_2IP.
+#ifdef HAYBOX_PRESS_TIMES
+        SOCD_2IP_TIMESTAMP,
+#endif
     } SocdType;
 
+    // The highest SocdType that this build knows, e.g. for checking the ones in a profile.
+#ifdef HAYBOX_PRESS_TIMES
+    constexpr SocdType LAST_SOCD_TYPE = SOCD_2IP_TIMESTAMP;
+#else
+    constexpr SocdType LAST_SOCD_TYPE = SOCD_NONE;
+#endif
+
     typedef struct {
         bool InputState::*input_dir1;
         bool InputState::*input_dir2;
@@ -27,6 +39,46 @@ namespace socd {
         bool lock_dir2 = false;
     } SocdState;
 
+    // One bit per SOCD pair, so that every pair can be resolved at once.
+    typedef uint8_t PairMask;
+
+    // Which pairs use each SOCD type. Pairs using SOCD_NONE are left out altogether.
+    typedef struct {
+        PairMask neutral = 0;
+        PairMask second_input_priority = 0;
+        PairMask second_input_priority_no_reactivation = 0;
+        PairMask dir1_priority = 0;
+        PairMask dir2_priority = 0;
+        PairMask second_input_priority_timestamp = 0;
+    } PairMasks;
+
+    // The same as SocdState, but for every pair at once.
+    typedef struct {
+        PairMask was_dir1 = 0;
+        PairMask was_dir2 = 0;
+        PairMask lock_dir1 = 0;
+        PairMask lock_dir2 = 0;
+    } PairStates;
+
+    void add_pair(PairMasks &masks, size_t pair_index, SocdType socd_type);
+
+    PairMask pairs(const PairMasks &masks);
+
+    /*
+     * Resolves all of the pairs in masks at once, with the same results as calling the functions
+     * below on each pair one at a time. Bits for pairs that aren't in masks are left as they are.
+     * dir1_newer and dir2_newer say which direction of each SOCD_2IP_TIMESTAMP pair was pressed
+     * more recently, and are ignored for the other types.
+     */
+    void resolve(
+        PairMask &input_dir1,
+        PairMask &input_dir2,
+        PairMask dir1_newer,
+        PairMask dir2_newer,
+        const PairMasks &masks,
+        PairStates &states
+    );
+
     void second_input_priority_no_reactivation(
         bool &input_dir1,
         bool &input_dir2,
@@ -35,6 +87,19 @@ namespace socd {
 
     void second_input_priority(bool &input_dir1, bool &input_dir2, SocdState &socd_state);
 
+    /*
+     * Second input priority going by when each direction was actually pressed, so the order isn't
+     * lost when both presses land between the same two scans. Presses at the same time fall back
+     * to second_input_priority().
+     */
+    void second_input_priority_timestamp(
+        bool &input_dir1,
+        bool &input_dir2,
+        uint32_t press_time_dir1,
+        uint32_t press_time_dir2,
+        SocdState &socd_state
+    );
+
     void neutral(bool &input_dir1, bool &input_dir2);
 
     void dir1_priority(bool &input_dir1, bool &input_dir2);
@@ -0,0 +1,144 @@
+#ifndef _CORE_STAGES_HPP
+#define _CORE_STAGES_HPP
+
+#include "core/state.hpp"
+#include "stdlib.hpp"
+
+/*
+ * Post-processing stages shared between controller modes.
+ *
+ * A stage touches up the outputs after the mode itself has filled them in, e.g. to turn the C-stick
+ * into a D-pad or to let a nunchuk take over the left stick. A mode lists the stages it wants in a
+ * Pipeline, which StaticControllerMode runs after the mode's own digital and analog updates. Stages
+ * are stored by value and called directly, so a pipeline costs no more than writing the same code
+ * out by hand in the mode.
+ */
+namespace stages {
+    // Ways of turning on the D-pad layer. These can be combined.
+    enum DpadLayerTrigger : uint8_t {
+        MOD_X_AND_MOD_Y = 1 << 0,
+        NUNCHUK_C = 1 << 1,
+    };
+
+    inline bool dpad_layer_active(uint8_t triggers, const InputState &inputs) {
+        return ((triggers & MOD_X_AND_MOD_Y) && inputs.mod_x && inputs.mod_y) ||
+               ((triggers & NUNCHUK_C) && inputs.nunchuk_c);
+    }
+
+    // Stages only need to define the update(s) they actually use.
+    class Stage {
+      public:
+        void UpdateDigitalOutputs(const InputState &inputs, OutputState &outputs) {}
+        void UpdateAnalogOutputs(const InputState &inputs, OutputState &outputs) {}
+    };
+
+    // Presses the D-pad using the C-stick buttons while the layer is active.
+    class DpadLayer : public Stage {
+      public:
+        DpadLayer(uint8_t triggers) : _triggers(triggers) {}
+
+        void UpdateDigitalOutputs(const InputState &inputs, OutputState &outputs) {
+            if (dpad_layer_active(_triggers, inputs)) {
+                // Added to, rather than replacing, D-pad presses made by the mode.
+                outputs.dpadUp = outputs.dpadUp || inputs.c_up;
+                outputs.dpadDown = outputs.dpadDown || inputs.c_down;
+                outputs.dpadLeft = outputs.dpadLeft || inputs.c_left;
+                outputs.dpadRight = outputs.dpadRight || inputs.c_right;
+            }
+        }
+
+      private:
+        uint8_t _triggers;
+    };
+
+    // Centres the C-stick while the D-pad layer is active.
+    class CStickShutoff : public Stage {
+      public:
+        CStickShutoff(uint8_t triggers, uint8_t analog_stick_neutral)
+            : _triggers(triggers),
+              _neutral(analog_stick_neutral) {}
+
+        void UpdateAnalogOutputs(const InputState &inputs, OutputState &outputs) {
+            if (dpad_layer_active(_triggers, inputs)) {
+                outputs.rightStickX = _neutral;
+                outputs.rightStickY = _neutral;
+            }
+        }
+
+      private:
+        uint8_t _triggers;
+        uint8_t _neutral;
+    };
+
+    // Sets the analog trigger values for shielding. A value of 0 leaves that button alone.
+    class ShieldAnalog : public Stage {
+      public:
+        ShieldAnalog(uint8_t full_press, uint8_t lightshield = 0, uint8_t midshield = 0)
+            : _full_press(full_press),
+              _lightshield(lightshield),
+              _midshield(midshield) {}
+
+        void UpdateAnalogOutputs(const InputState &inputs, OutputState &outputs) {
+            if (_lightshield && inputs.lightshield) {
+                outputs.triggerRAnalog = _lightshield;
+            }
+            if (_midshield && inputs.midshield) {
+                outputs.triggerRAnalog = _midshield;
+            }
+
+            // Driven by the digital triggers, so this follows whatever buttons the mode put there.
+            if (outputs.triggerLDigital) {
+                outputs.triggerLAnalog = _full_press;
+            }
+            if (outputs.triggerRDigital) {
+                outputs.triggerRAnalog = _full_press;
+            }
+        }
+
+      private:
+        uint8_t _full_press;
+        uint8_t _lightshield;
+        uint8_t _midshield;
+    };
+
+    // Nunchuk overrides left stick.
+    class NunchukLeftStick : public Stage {
+      public:
+        void UpdateAnalogOutputs(const InputState &inputs, OutputState &outputs) {
+            if (inputs.nunchuk_connected) {
+                outputs.leftStickX = inputs.nunchuk_x;
+                outputs.leftStickY = inputs.nunchuk_y;
+            }
+        }
+    };
+
+    // Runs each stage in the order listed.
+    template <typename... Stages> class Pipeline;
+
+    template <> class Pipeline<> {
+      public:
+        void UpdateDigitalOutputs(const InputState &inputs, OutputState &outputs) {}
+        void UpdateAnalogOutputs(const InputState &inputs, OutputState &outputs) {}
+    };
+
+    template <typename First, typename... Rest> class Pipeline<First, Rest...> {
+      public:
+        Pipeline(const First &first, const Rest &...rest) : _first(first), _rest(rest...) {}
+
+        void UpdateDigitalOutputs(const InputState &inputs, OutputState &outputs) {
+            _first.UpdateDigitalOutputs(inputs, outputs);
+            _rest.UpdateDigitalOutputs(inputs, outputs);
+        }
+
+        void UpdateAnalogOutputs(const InputState &inputs, OutputState &outputs) {
+            _first.UpdateAnalogOutputs(inputs, outputs);
+            _rest.UpdateAnalogOutputs(inputs, outputs);
+        }
+
+      private:
+        First _first;
+        Pipeline<Rest...> _rest;
+    };
+}
+
+#endif
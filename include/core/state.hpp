@@ -3,6 +3,9 @@
 
 #include "stdlib.hpp"
 
+// Number of rectangle inputs at the start of InputState.
+#define RECTANGLE_INPUT_COUNT 22
+
 // Button state.
 typedef struct inputstate {
     // Rectangle inputs.
@@ -35,8 +38,37 @@ typedef struct inputstate {
     int8_t nunchuk_y = 0;
     bool nunchuk_c = false;
     bool nunchuk_z = false;
+
+#ifdef HAYBOX_PRESS_TIMES
+    // micros() at which each rectangle input was last pressed, indexed by button_index(). Only
+    // filled in by input sources that track presses, and used by SOCD_2IP_TIMESTAMP.
+    uint32_t press_times[RECTANGLE_INPUT_COUNT] = {};
+#endif
 } InputState;
 
+static_assert(
+    offsetof(InputState, mod_y) - offsetof(InputState, left) + 1 == RECTANGLE_INPUT_COUNT,
+    "RECTANGLE_INPUT_COUNT doesn't match InputState"
+);
+
+// Position of a rectangle input within InputState, counting from left.
+inline size_t button_index(const InputState &inputs, bool InputState::*button) {
+    return &(inputs.*button) - &inputs.left;
+}
+
+// Bit for a rectangle input in the word returned by pack_buttons(), e.g. BUTTON_BIT(mod_x).
+#define BUTTON_BIT(field) (1UL << (offsetof(InputState, field) - offsetof(InputState, left)))
+
+// Packs the rectangle inputs into one word, one bit each in InputState order.
+inline uint32_t pack_buttons(const InputState &inputs) {
+    const bool *buttons = &inputs.left;
+    uint32_t packed = 0;
+    for (size_t i = 0; i < RECTANGLE_INPUT_COUNT; i++) {
+        packed |= (uint32_t)buttons[i] << i;
+    }
+    return packed;
+}
+
 // State describing stick direction at the quadrant level.
 typedef struct {
     bool horizontal;
@@ -0,0 +1,31 @@
+#ifndef _CORE_STATIC_ALLOC_HPP
+#define _CORE_STATIC_ALLOC_HPP
+
+#include "stdlib.hpp"
+
+// Tag for the placement new overload below, so that we don't depend on the standard library's
+// placement new, which isn't available on every platform.
+struct static_storage_t {};
+
+inline void *operator new(size_t size, static_storage_t, void *ptr) noexcept {
+    return ptr;
+}
+
+/*
+ * Constructs a T in static storage that is reserved for it at link time, for use in place of
+ * new T(...). There is only one object's worth of storage per type, so if a config needs more than
+ * one live object of the same type, each call site must pass its own slot number.
+ */
+template <typename T, int slot = 0, typename... Args> T *static_new(Args &&...args) {
+    alignas(T) static uint8_t storage[sizeof(T)];
+    return new (static_storage_t{}, storage) T(static_cast<Args &&>(args)...);
+}
+
+// Counterpart to delete for objects created with static_new(). Only runs the destructor.
+template <typename T> void static_delete(T *ptr) {
+    if (ptr != nullptr) {
+        ptr->~T();
+    }
+}
+
+#endif
@@ -0,0 +1,141 @@
+#ifndef _CORE_STICK_RULES_HPP
+#define _CORE_STICK_RULES_HPP
+
+#include "stdlib.hpp"
+
+/*
+ * Table-driven stick coordinates for controller modes.
+ *
+ * Each rule says "when these conditions are set and those are clear, put the stick at these
+ * coordinates". ControllerMode::ApplyStickRules() checks every rule in a mode's table in order, and
+ * a later rule overrides whatever an earlier matching rule wrote to the same axis. This is the same
+ * as a chain of if statements that keep overwriting the outputs, except every rule is a single mask
+ * comparison, so the cost is the same no matter which inputs are held.
+ *
+ * Modes with a generated table can use ControllerMode::ApplyStickLut() instead, which gets the same
+ * result from a couple of table lookups per stick rather than checking every rule.
+ */
+namespace stick_rules {
+    // Conditions a rule can test, packed into one 32-bit word.
+    enum Condition : uint32_t {
+        // Filled in by ControllerMode::StickConditions() from the stick directions and inputs.
+        HORIZONTAL = 1UL << 0,
+        VERTICAL = 1UL << 1,
+        DIAGONAL = 1UL << 2,
+        X_NEGATIVE = 1UL << 3,
+        Y_NEGATIVE = 1UL << 4,
+        C_HORIZONTAL = 1UL << 5,
+        C_VERTICAL = 1UL << 6,
+        C_Y_NEGATIVE = 1UL << 7,
+        MOD_X = 1UL << 8,
+        MOD_Y = 1UL << 9,
+        A = 1UL << 10,
+        B = 1UL << 11,
+        Z = 1UL << 12,
+        R = 1UL << 13,
+        DOWN = 1UL << 14,
+        C_LEFT = 1UL << 15,
+        C_RIGHT = 1UL << 16,
+        C_DOWN = 1UL << 17,
+        C_UP = 1UL << 18,
+
+        // Set by each mode, as they mean slightly different things from mode to mode.
+        SHIELD = 1UL << 24,
+        HORIZONTAL_SOCD = 1UL << 25,
+        MODE_FLAG_0 = 1UL << 26,
+        MODE_FLAG_1 = 1UL << 27,
+    };
+
+    // Axes written by a rule.
+    enum Target : uint8_t {
+        LEFT_X = 1 << 0,
+        LEFT_Y = 1 << 1,
+        RIGHT_X = 1 << 2,
+        RIGHT_Y = 1 << 3,
+    };
+
+    // Direction that a rule's offset from neutral is multiplied by.
+    enum Sign : uint8_t {
+        SIGN_X,
+        SIGN_Y,
+        SIGN_CX,
+        SIGN_CY,
+        SIGN_POSITIVE,
+    };
+
+    // Coordinates to put the stick(s) at, as offsets from neutral.
+    typedef struct {
+        uint8_t targets;
+        // Sign for the X offset in the low nibble, and for the Y offset in the high nibble.
+        uint8_t signs;
+        int8_t x;
+        int8_t y;
+    } StickOutput;
+
+    typedef struct {
+        uint32_t mask;
+        uint32_t match;
+        StickOutput output;
+    } StickRule;
+
+    /*
+     * The same rules flattened into a lookup table for one stick, as generated by
+     * builder_scripts/mode_tables.py. The conditions that the stick depends on are gathered into an
+     * index, whose high bits select a row and whose low bits select a cell within that row. Rows
+     * are deduplicated, and each cell holds the index of the output that the rules would have
+     * ended up with.
+     */
+    typedef struct {
+        // Condition for each index bit, low bits first.
+        const uint32_t *index_bits;
+        uint8_t low_bit_count;
+        uint8_t high_bit_count;
+        // Row for each value of the high bits.
+        const uint8_t *rows;
+        // Output for each value of the low bits, one row after another.
+        const uint8_t *cells;
+        const StickOutput *outputs;
+    } StickLut;
+
+    constexpr StickRule rule(
+        uint32_t when,
+        uint32_t unless,
+        uint8_t targets,
+        Sign x_sign,
+        int8_t x,
+        Sign y_sign,
+        int8_t y
+    ) {
+        return StickRule{
+            when | unless,
+            when,
+            { targets, (uint8_t)(x_sign | (y_sign << 4)), x, y },
+        };
+    }
+
+    // Sets both axes of the left stick.
+    constexpr StickRule left_stick(uint32_t when, uint32_t unless, int8_t x, int8_t y) {
+        return rule(when, unless, LEFT_X | LEFT_Y, SIGN_X, x, SIGN_Y, y);
+    }
+
+    constexpr StickRule left_x(uint32_t when, uint32_t unless, int8_t x) {
+        return rule(when, unless, LEFT_X, SIGN_X, x, SIGN_Y, 0);
+    }
+
+    constexpr StickRule left_y(uint32_t when, uint32_t unless, int8_t y) {
+        return rule(when, unless, LEFT_Y, SIGN_X, 0, SIGN_Y, y);
+    }
+
+    // Sets both axes of the right stick. The Y offset can follow either stick's vertical direction.
+    constexpr StickRule right_stick(
+        uint32_t when,
+        uint32_t unless,
+        int8_t x,
+        Sign y_sign,
+        int8_t y
+    ) {
+        return rule(when, unless, RIGHT_X | RIGHT_Y, SIGN_CX, x, y_sign, y);
+    }
+}
+
+#endif
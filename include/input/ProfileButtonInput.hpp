@@ -0,0 +1,23 @@
+#ifndef _INPUT_PROFILEBUTTONINPUT_HPP
+#define _INPUT_PROFILEBUTTONINPUT_HPP
+
+#include "core/InputSource.hpp"
+#include "core/Profile.hpp"
+#include "core/state.hpp"
+#include "stdlib.hpp"
+
+// The same as GpioButtonInput, but going by the buttons in a profile, which are read in place.
+class ProfileButtonInput : public InputSource {
+  public:
+    ProfileButtonInput(Profile &profile);
+    InputScanSpeed ScanSpeed();
+    void UpdateInputs(InputState &inputs);
+
+    // Sets up the profile's pins again, for after it has been replaced.
+    void InitPins();
+
+  protected:
+    Profile &_profile;
+};
+
+#endif
\ No newline at end of file
@@ -59,6 +59,7 @@ template <size_t num_rows, size_t num_cols> class SwitchMatrixInput : public Inp
     InputScanSpeed ScanSpeed() { return InputScanSpeed::FAST; }
 
     void UpdateInputs(InputState &inputs) {
+        uint32_t now = ScanTime();
         for (size_t i = 0; i < _num_outputs; i++) {
             // Activate the column/row.
             gpio::init_pin(_output_pins[i], gpio::GpioMode::GPIO_OUTPUT);
@@ -69,7 +70,9 @@ template <size_t num_rows, size_t num_cols> class SwitchMatrixInput : public Inp
                 SwitchMatrixElement button =
                     _direction == DiodeDirection::ROW2COL ? _matrix[j][i] : _matrix[i][j];
                 if (button != nullptr) {
-                    inputs.*button = !gpio::read_digital(_input_pins[j]);
+                    bool pressed = !gpio::read_digital(_input_pins[j]);
+                    inputs.*button = pressed;
+                    UpdatePressTime(inputs, button, pressed, now);
                 }
             }
 
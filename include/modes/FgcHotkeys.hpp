@@ -0,0 +1,19 @@
+#ifndef _MODES_FGCHOTKEYS_HPP
+#define _MODES_FGCHOTKEYS_HPP
+
+#include "core/KeyboardMode.hpp"
+#include "core/state.hpp"
+
+/*
+ * Menu keys for PC fighting games, run alongside FgcMode with set_hotkeys(). Only uses buttons that
+ * FgcMode leaves free, none of which are directions, so it has no SOCD pairs to resolve.
+ */
+class FgcHotkeys : public KeyboardMode {
+  public:
+    FgcHotkeys();
+
+  private:
+    void UpdateKeys(InputState &inputs);
+};
+
+#endif
@@ -5,7 +5,9 @@
 #include "core/socd.hpp"
 #include "core/state.hpp"
 
-class FgcMode : public ControllerMode {
+class FgcMode final : public StaticControllerMode<FgcMode> {
+    friend class StaticControllerMode<FgcMode>;
+
   public:
     FgcMode(socd::SocdType horizontal_socd, socd::SocdType vertical_socd);
 
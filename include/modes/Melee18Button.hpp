@@ -9,7 +9,15 @@ typedef struct {
     bool crouch_walk_os = false;
 } Melee18ButtonOptions;
 
-class Melee18Button : public ControllerMode {
+typedef stages::Pipeline<
+    stages::DpadLayer,
+    stages::CStickShutoff,
+    stages::NunchukLeftStick>
+    Melee18ButtonStages;
+
+class Melee18Button final : public StaticControllerMode<Melee18Button, Melee18ButtonStages> {
+    friend class StaticControllerMode<Melee18Button, Melee18ButtonStages>;
+
   public:
     Melee18Button(socd::SocdType socd_type, Melee18ButtonOptions options = {});
 
@@ -9,7 +9,16 @@ typedef struct {
     bool crouch_walk_os = false;
 } Melee20ButtonOptions;
 
-class Melee20Button : public ControllerMode {
+typedef stages::Pipeline<
+    stages::DpadLayer,
+    stages::ShieldAnalog,
+    stages::CStickShutoff,
+    stages::NunchukLeftStick>
+    Melee20ButtonStages;
+
+class Melee20Button final : public StaticControllerMode<Melee20Button, Melee20ButtonStages> {
+    friend class StaticControllerMode<Melee20Button, Melee20ButtonStages>;
+
   public:
     Melee20Button(socd::SocdType socd_type, Melee20ButtonOptions options = {});
 
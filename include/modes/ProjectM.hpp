@@ -1,22 +1,38 @@
 #ifndef _MODES_PROJECTM_HPP
 #define _MODES_PROJECTM_HPP
 
+#include "core/ComboEngine.hpp"
 #include "core/ControllerMode.hpp"
+#include "core/MacroEngine.hpp"
 #include "core/socd.hpp"
 #include "core/state.hpp"
 
 typedef struct {
     bool true_z_press = false;
     bool ledgedash_max_jump_traj = true;
+    // Pressing Z taps lightshield + A for a couple of frames, rather than holding them for as long
+    // as Z is held. Does nothing with true_z_press.
+    bool z_press_macro = false;
 } ProjectMOptions;
 
-class ProjectM : public ControllerMode {
+typedef stages::Pipeline<
+    stages::DpadLayer,
+    stages::ShieldAnalog,
+    stages::CStickShutoff,
+    stages::NunchukLeftStick>
+    ProjectMStages;
+
+class ProjectM final : public StaticControllerMode<ProjectM, ProjectMStages> {
+    friend class StaticControllerMode<ProjectM, ProjectMStages>;
+
   public:
     ProjectM(socd::SocdType socd_type, ProjectMOptions options = {});
 
   private:
     ProjectMOptions _options;
     bool _horizontal_socd;
+    ComboEngine _z_press;
+    MacroEngine _macros;
 
     void HandleSocd(InputState &inputs);
     void UpdateDigitalOutputs(InputState &inputs, OutputState &outputs);
@@ -5,7 +5,15 @@
 #include "core/socd.hpp"
 #include "core/state.hpp"
 
-class Rivals2 : public ControllerMode {
+typedef stages::Pipeline<
+    stages::DpadLayer,
+    stages::CStickShutoff,
+    stages::NunchukLeftStick>
+    Rivals2Stages;
+
+class Rivals2 final : public StaticControllerMode<Rivals2, Rivals2Stages> {
+    friend class StaticControllerMode<Rivals2, Rivals2Stages>;
+
   public:
     Rivals2(socd::SocdType socd_type);
 
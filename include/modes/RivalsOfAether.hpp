@@ -5,7 +5,15 @@
 #include "core/socd.hpp"
 #include "core/state.hpp"
 
-class RivalsOfAether : public ControllerMode {
+typedef stages::Pipeline<
+    stages::DpadLayer,
+    stages::CStickShutoff,
+    stages::NunchukLeftStick>
+    RivalsOfAetherStages;
+
+class RivalsOfAether final : public StaticControllerMode<RivalsOfAether, RivalsOfAetherStages> {
+    friend class StaticControllerMode<RivalsOfAether, RivalsOfAetherStages>;
+
   public:
     RivalsOfAether(socd::SocdType socd_type);
 
@@ -5,7 +5,16 @@
 #include "core/socd.hpp"
 #include "core/state.hpp"
 
-class Ultimate : public ControllerMode {
+typedef stages::Pipeline<
+    stages::DpadLayer,
+    stages::ShieldAnalog,
+    stages::CStickShutoff,
+    stages::NunchukLeftStick>
+    UltimateStages;
+
+class Ultimate final : public StaticControllerMode<Ultimate, UltimateStages> {
+    friend class StaticControllerMode<Ultimate, UltimateStages>;
+
   public:
     Ultimate(socd::SocdType socd_type);
 
@@ -5,7 +5,11 @@
 #include "core/socd.hpp"
 #include "core/state.hpp"
 
-class UltimateR4 : public ControllerMode {
+typedef stages::Pipeline<stages::DpadLayer, stages::CStickShutoff> UltimateR4Stages;
+
+class UltimateR4 final : public StaticControllerMode<UltimateR4, UltimateR4Stages> {
+    friend class StaticControllerMode<UltimateR4, UltimateR4Stages>;
+
   public:
     UltimateR4(socd::SocdType socd_type);
 
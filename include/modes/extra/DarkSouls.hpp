@@ -5,7 +5,11 @@
 #include "core/socd.hpp"
 #include "core/state.hpp"
 
-class DarkSouls : public ControllerMode {
+typedef stages::Pipeline<stages::NunchukLeftStick> DarkSoulsStages;
+
+class DarkSouls final : public StaticControllerMode<DarkSouls, DarkSoulsStages> {
+    friend class StaticControllerMode<DarkSouls, DarkSoulsStages>;
+
   public:
     DarkSouls(socd::SocdType socd_type);
 
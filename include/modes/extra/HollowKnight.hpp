@@ -6,7 +6,9 @@
 #include "core/socd.hpp"
 #include "core/state.hpp"
 
-class HollowKnight : public ControllerMode {
+class HollowKnight final : public StaticControllerMode<HollowKnight> {
+    friend class StaticControllerMode<HollowKnight>;
+
   public:
     HollowKnight(socd::SocdType socd_type);
 
@@ -5,7 +5,11 @@
 #include "core/socd.hpp"
 #include "core/state.hpp"
 
-class MKWii : public ControllerMode {
+typedef stages::Pipeline<stages::ShieldAnalog, stages::NunchukLeftStick> MKWiiStages;
+
+class MKWii final : public StaticControllerMode<MKWii, MKWiiStages> {
+    friend class StaticControllerMode<MKWii, MKWiiStages>;
+
   public:
     MKWii(socd::SocdType socd_type);
 
@@ -5,7 +5,11 @@
 #include "core/socd.hpp"
 #include "core/state.hpp"
 
-class MultiVersus : public ControllerMode {
+typedef stages::Pipeline<stages::ShieldAnalog, stages::NunchukLeftStick> MultiVersusStages;
+
+class MultiVersus final : public StaticControllerMode<MultiVersus, MultiVersusStages> {
+    friend class StaticControllerMode<MultiVersus, MultiVersusStages>;
+
   public:
     MultiVersus(socd::SocdType socd_type);
 
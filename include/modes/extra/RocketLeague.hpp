@@ -5,12 +5,19 @@
 #include "core/socd.hpp"
 #include "core/state.hpp"
 
-class RocketLeague : public ControllerMode {
+typedef stages::Pipeline<
+    stages::DpadLayer,
+    stages::CStickShutoff,
+    stages::NunchukLeftStick>
+    RocketLeagueStages;
+
+class RocketLeague final : public StaticControllerMode<RocketLeague, RocketLeagueStages> {
+    friend class StaticControllerMode<RocketLeague, RocketLeagueStages>;
+
   public:
     RocketLeague(socd::SocdType socd_type);
 
   private:
-    void HandleSocd(InputState &inputs);
     void UpdateDigitalOutputs(InputState &inputs, OutputState &outputs);
     void UpdateAnalogOutputs(InputState &inputs, OutputState &outputs);
 };
@@ -5,7 +5,9 @@
 #include "core/socd.hpp"
 #include "core/state.hpp"
 
-class SaltAndSanctuary : public ControllerMode {
+class SaltAndSanctuary final : public StaticControllerMode<SaltAndSanctuary> {
+    friend class StaticControllerMode<SaltAndSanctuary>;
+
   public:
     SaltAndSanctuary(socd::SocdType socd_type);
 
@@ -5,7 +5,9 @@
 #include "core/socd.hpp"
 #include "core/state.hpp"
 
-class ShovelKnight : public ControllerMode {
+class ShovelKnight final : public StaticControllerMode<ShovelKnight> {
+    friend class StaticControllerMode<ShovelKnight>;
+
   public:
     ShovelKnight(socd::SocdType socd_type);
 
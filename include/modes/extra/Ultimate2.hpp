@@ -1,11 +1,20 @@
-#ifndef _MODES_ULTIMATE_HPP
-#define _MODES_ULTIMATE_HPP
+#ifndef _MODES_ULTIMATE2_HPP
+#define _MODES_ULTIMATE2_HPP
 
 #include "core/ControllerMode.hpp"
 #include "core/socd.hpp"
 #include "core/state.hpp"
 
-class Ultimate2 : public ControllerMode {
+typedef stages::Pipeline<
+    stages::DpadLayer,
+    stages::ShieldAnalog,
+    stages::CStickShutoff,
+    stages::NunchukLeftStick>
+    Ultimate2Stages;
+
+class Ultimate2 final : public StaticControllerMode<Ultimate2, Ultimate2Stages> {
+    friend class StaticControllerMode<Ultimate2, Ultimate2Stages>;
+
   public:
     Ultimate2(socd::SocdType socd_type);
 
@@ -0,0 +1,225 @@
+// Generated by builder_scripts/mode_tables.py from src/modes/specs/Melee20Button.json. Do not edit.
+
+#ifndef _MODES_GENERATED_MELEE20BUTTON_RULES_HPP
+#define _MODES_GENERATED_MELEE20BUTTON_RULES_HPP
+
+#include "core/stick_rules.hpp"
+
+namespace stick_rules {
+    namespace melee20_button {
+        constexpr uint32_t CROUCH_WALK_OS = MODE_FLAG_0;
+
+        static const StickRule analog_rules[] PROGMEM = {
+            // q1/2 = 7000 7000
+            // 45.00 deg, magnitude 79
+            left_stick(DIAGONAL, 0, 56, 56),
+            // L, R, LS, and MS + q3/4 = 7000 6875 (For vanilla shield drop. Gives 44.5 degree wavedash).
+            // Also used as default q3/4 diagonal if crouch walk option select is enabled.
+            // 44.48 deg, magnitude 78
+            left_stick(DIAGONAL | Y_NEGATIVE | SHIELD, 0, 56, 55),
+            // 44.48 deg, magnitude 78
+            left_stick(DIAGONAL | Y_NEGATIVE | CROUCH_WALK_OS, 0, 56, 55),
+            // MX + Horizontal (even if shield is held) = 6625 = 53
+            left_x(MOD_X | HORIZONTAL, 0, 53),
+            // MX + Vertical (even if shield is held) = 5375 = 43
+            left_y(MOD_X | VERTICAL, 0, 43),
+            // MX + L, R, LS, and MS + q1/2/3/4 = 6375 3750 = 51 30
+            // 30.47 deg, magnitude 59
+            left_stick(MOD_X | DIAGONAL | SHIELD, 0, 51, 30),
+            // MX Up B angles
+            // 22.9638 - 7375 3125 = 59 25
+            // 22.96 deg, magnitude 64
+            left_stick(MOD_X | DIAGONAL, SHIELD, 59, 25),
+            // 27.37104 - 7000 3625 (27.38) = 56 29
+            // 27.38 deg, magnitude 63
+            left_stick(MOD_X | DIAGONAL | C_DOWN, SHIELD, 56, 29),
+            // 31.77828 - 7875 4875 (31.76) = 63 39
+            // 31.76 deg, magnitude 74
+            left_stick(MOD_X | DIAGONAL | C_LEFT, SHIELD, 63, 39),
+            // 36.18552 - 7000 5125 (36.21) = 56 41
+            // 36.21 deg, magnitude 69
+            left_stick(MOD_X | DIAGONAL | C_UP, SHIELD, 56, 41),
+            // 40.59276 - 6125 5250 (40.6) = 49 42
+            // 40.60 deg, magnitude 65
+            left_stick(MOD_X | DIAGONAL | C_RIGHT, SHIELD, 49, 42),
+            // MX Extended Up B Angles
+            // 22.9638 - 9125 3875 (23.0) = 73 31
+            // 23.01 deg, magnitude 79
+            left_stick(MOD_X | DIAGONAL | B, SHIELD, 73, 31),
+            // 27.37104 - 8750 4500 (27.2) = 70 36
+            // 27.22 deg, magnitude 79
+            left_stick(MOD_X | DIAGONAL | B | C_DOWN, SHIELD, 70, 36),
+            // 31.77828 - 8500 5250 (31.7) = 68 42
+            // 31.70 deg, magnitude 80
+            left_stick(MOD_X | DIAGONAL | B | C_LEFT, SHIELD, 68, 42),
+            // 36.18552 - 7375 5375 (36.1) = 59 43
+            // 36.09 deg, magnitude 73
+            left_stick(MOD_X | DIAGONAL | B | C_UP, SHIELD, 59, 43),
+            // 40.59276 - 6375 5375 (40.1) = 51 43
+            // 40.14 deg, magnitude 67
+            left_stick(MOD_X | DIAGONAL | B | C_RIGHT, SHIELD, 51, 43),
+            // Angled fsmash = 8500 5250 = 68 42
+            // 31.70 deg, magnitude 80
+            right_stick(MOD_X | C_HORIZONTAL, 0, 68, SIGN_Y, 42),
+            // MY + Horizontal (even if shield is held) = 3375 = 27
+            left_x(MOD_Y | HORIZONTAL, 0, 27),
+            // MY + Vertical (even if shield is held) = 7375 = 59
+            left_y(MOD_Y | VERTICAL, 0, 59),
+            // MY + L, R, LS, and MS + q1/2 = 4750 8750 = 38 70
+            // 61.50 deg, magnitude 80
+            left_stick(MOD_Y | DIAGONAL | SHIELD, 0, 38, 70),
+            // MY + L, R, LS, and MS + q3/4 = 5000 8500 = 40 68
+            // 59.53 deg, magnitude 79
+            left_stick(MOD_Y | DIAGONAL | SHIELD | Y_NEGATIVE, 0, 40, 68),
+            // Turnaround neutral B nerf
+            left_x(MOD_Y | B, 0, 80),
+            // MY Up B angles
+            // 67.0362 - 3125 7375 = 25 59
+            // 67.04 deg, magnitude 64
+            left_stick(MOD_Y | DIAGONAL, SHIELD, 25, 59),
+            // 62.62896 - 3625 7000 (62.62) = 29 56
+            // 62.62 deg, magnitude 63
+            left_stick(MOD_Y | DIAGONAL | C_DOWN, SHIELD, 29, 56),
+            // 58.22172 - 4875 7875 (58.24) = 39 63
+            // 58.24 deg, magnitude 74
+            left_stick(MOD_Y | DIAGONAL | C_LEFT, SHIELD, 39, 63),
+            // 53.81448 - 5125 7000 (53.79) = 41 56
+            // 53.79 deg, magnitude 69
+            left_stick(MOD_Y | DIAGONAL | C_UP, SHIELD, 41, 56),
+            // 49.40724 - 6375 7625 (50.10) = 51 61
+            // 50.10 deg, magnitude 80
+            left_stick(MOD_Y | DIAGONAL | C_RIGHT, SHIELD, 51, 61),
+            // MY Extended Up B Angles
+            // 67.0362 - 3875 9125 = 31 73
+            // 66.99 deg, magnitude 79
+            left_stick(MOD_Y | DIAGONAL | B, SHIELD, 31, 73),
+            // 62.62896 - 4500 8750 (62.8) = 36 70
+            // 62.78 deg, magnitude 79
+            left_stick(MOD_Y | DIAGONAL | B | C_DOWN, SHIELD, 36, 70),
+            // 58.22172 - 5250 8500 (58.3) = 42 68
+            // 58.30 deg, magnitude 80
+            left_stick(MOD_Y | DIAGONAL | B | C_LEFT, SHIELD, 42, 68),
+            // 53.81448 - 5875 8000 (53.7) = 47 64
+            // 53.71 deg, magnitude 79
+            left_stick(MOD_Y | DIAGONAL | B | C_UP, SHIELD, 47, 64),
+            // 49.40724 - 5875 7125 (50.49) = 47 57
+            // 50.49 deg, magnitude 74
+            left_stick(MOD_Y | DIAGONAL | B | C_RIGHT, SHIELD, 47, 57),
+            // C-stick ASDI Slideoff angle overrides any other C-stick modifiers (such as angled fsmash).
+            // 5250 8500 = 42 68
+            // 58.30 deg, magnitude 80
+            right_stick(C_HORIZONTAL | C_VERTICAL, 0, 42, SIGN_CY, 68),
+            // Horizontal SOCD overrides X-axis modifiers (for ledgedash maximum jump trajectory).
+            left_x(HORIZONTAL_SOCD, VERTICAL, 80),
+        };
+
+        // Left stick lookup table: 13 index bits (5 low, 8 high), 13 of 256 rows unique,
+        // 34 outputs, 860 bytes in total.
+        static const uint32_t left_stick_lut_bits[] PROGMEM = {
+            B, HORIZONTAL, C_LEFT, C_RIGHT, C_DOWN, VERTICAL, Y_NEGATIVE, MOD_X, MOD_Y, C_UP,
+            SHIELD, HORIZONTAL_SOCD, CROUCH_WALK_OS,
+        };
+        static const uint8_t left_stick_lut_rows[] PROGMEM = {
+            0, 1, 0, 1, 2, 3, 2, 3, 4, 5, 4, 5, 4, 5, 4, 5, 0, 1, 0, 1, 2, 6, 2, 6, 4, 7, 4, 7, 4,
+            7, 4, 7, 0, 1, 0, 8, 2, 9, 2, 9, 4, 10, 4, 11, 4, 10, 4, 11, 0, 1, 0, 8, 2, 9, 2, 9, 4,
+            10, 4, 11, 4, 10, 4, 11, 12, 1, 12, 1, 12, 3, 12, 3, 12, 5, 12, 5, 12, 5, 12, 5, 12, 1,
+            12, 1, 12, 6, 12, 6, 12, 7, 12, 7, 12, 7, 12, 7, 12, 1, 12, 8, 12, 9, 12, 9, 12, 10, 12,
+            11, 12, 10, 12, 11, 12, 1, 12, 8, 12, 9, 12, 9, 12, 10, 12, 11, 12, 10, 12, 11, 0, 1, 0,
+            8, 2, 3, 2, 3, 4, 5, 4, 5, 4, 5, 4, 5, 0, 1, 0, 8, 2, 6, 2, 6, 4, 7, 4, 7, 4, 7, 4, 7,
+            0, 1, 0, 8, 2, 9, 2, 9, 4, 10, 4, 11, 4, 10, 4, 11, 0, 1, 0, 8, 2, 9, 2, 9, 4, 10, 4,
+            11, 4, 10, 4, 11, 12, 1, 12, 8, 12, 3, 12, 3, 12, 5, 12, 5, 12, 5, 12, 5, 12, 1, 12, 8,
+            12, 6, 12, 6, 12, 7, 12, 7, 12, 7, 12, 7, 12, 1, 12, 8, 12, 9, 12, 9, 12, 10, 12, 11,
+            12, 10, 12, 11, 12, 1, 12, 8, 12, 9, 12, 9, 12, 10, 12, 11, 12, 10, 12, 11,
+        };
+        static const uint8_t left_stick_lut_cells[] PROGMEM = {
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0,
+            1, 1, 0, 0, 1, 1, 0, 0, 2, 2, 0, 0, 2, 2, 0, 0, 2, 2, 0, 0, 2, 2, 0, 0, 2, 2, 0, 0, 2,
+            2, 0, 0, 2, 2, 0, 0, 2, 2, 3, 3, 4, 8, 3, 3, 12, 14, 3, 3, 16, 18, 3, 3, 16, 18, 3, 3,
+            20, 22, 3, 3, 12, 14, 3, 3, 16, 18, 3, 3, 16, 18, 0, 9, 5, 9, 0, 9, 5, 9, 0, 9, 5, 9, 0,
+            9, 5, 9, 0, 9, 5, 9, 0, 9, 5, 9, 0, 9, 5, 9, 0, 9, 5, 9, 6, 10, 7, 11, 6, 10, 13, 15, 6,
+            10, 17, 19, 6, 10, 17, 19, 6, 10, 21, 23, 6, 10, 13, 15, 6, 10, 17, 19, 6, 10, 17, 19,
+            3, 3, 24, 26, 3, 3, 24, 26, 3, 3, 16, 18, 3, 3, 16, 18, 3, 3, 24, 26, 3, 3, 24, 26, 3,
+            3, 16, 18, 3, 3, 16, 18, 6, 10, 25, 27, 6, 10, 25, 27, 6, 10, 17, 19, 6, 10, 17, 19, 6,
+            10, 25, 27, 6, 10, 25, 27, 6, 10, 17, 19, 6, 10, 17, 19, 0, 0, 28, 28, 0, 0, 28, 28, 0,
+            0, 28, 28, 0, 0, 28, 28, 0, 0, 28, 28, 0, 0, 28, 28, 0, 0, 28, 28, 0, 0, 28, 28, 3, 3,
+            29, 29, 3, 3, 29, 29, 3, 3, 29, 29, 3, 3, 29, 29, 3, 3, 29, 29, 3, 3, 29, 29, 3, 3, 29,
+            29, 3, 3, 29, 29, 6, 10, 30, 32, 6, 10, 30, 32, 6, 10, 30, 32, 6, 10, 30, 32, 6, 10, 30,
+            32, 6, 10, 30, 32, 6, 10, 30, 32, 6, 10, 30, 32, 6, 10, 31, 33, 6, 10, 31, 33, 6, 10,
+            31, 33, 6, 10, 31, 33, 6, 10, 31, 33, 6, 10, 31, 33, 6, 10, 31, 33, 6, 10, 31, 33, 9, 9,
+            9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9,
+            9,
+        };
+        static const StickOutput left_stick_lut_outputs[] PROGMEM = {
+            { 0, SIGN_X | (SIGN_X << 4), 0, 0 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 56, 56 },
+            { LEFT_X, SIGN_X | (SIGN_Y << 4), 53, 0 },
+            { LEFT_Y, SIGN_X | (SIGN_Y << 4), 0, 43 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 59, 25 },
+            { LEFT_X, SIGN_X | (SIGN_Y << 4), 27, 0 },
+            { LEFT_Y, SIGN_X | (SIGN_Y << 4), 0, 59 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 25, 59 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 73, 31 },
+            { LEFT_X, SIGN_X | (SIGN_Y << 4), 80, 0 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 80, 59 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 31, 73 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 63, 39 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 39, 63 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 68, 42 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 42, 68 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 49, 42 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 51, 61 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 51, 43 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 47, 57 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 56, 29 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 29, 56 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 70, 36 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 36, 70 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 56, 41 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 41, 56 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 59, 43 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 47, 64 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 56, 55 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 51, 30 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 38, 70 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 40, 68 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 80, 70 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 80, 68 },
+        };
+        static const StickLut left_stick_lut PROGMEM = {
+            left_stick_lut_bits,
+            5,
+            8,
+            left_stick_lut_rows,
+            left_stick_lut_cells,
+            left_stick_lut_outputs,
+        };
+
+        // Right stick lookup table: 3 index bits (3 low, 0 high), 1 of 1 rows unique,
+        // 3 outputs, 33 bytes in total.
+        static const uint32_t right_stick_lut_bits[] PROGMEM = {
+            C_HORIZONTAL, C_VERTICAL, MOD_X,
+        };
+        static const uint8_t right_stick_lut_rows[] PROGMEM = {
+            0,
+        };
+        static const uint8_t right_stick_lut_cells[] PROGMEM = {
+            0, 0, 0, 1, 0, 2, 0, 1,
+        };
+        static const StickOutput right_stick_lut_outputs[] PROGMEM = {
+            { 0, SIGN_X | (SIGN_X << 4), 0, 0 },
+            { RIGHT_X | RIGHT_Y, SIGN_CX | (SIGN_CY << 4), 42, 68 },
+            { RIGHT_X | RIGHT_Y, SIGN_CX | (SIGN_Y << 4), 68, 42 },
+        };
+        static const StickLut right_stick_lut PROGMEM = {
+            right_stick_lut_bits,
+            3,
+            0,
+            right_stick_lut_rows,
+            right_stick_lut_cells,
+            right_stick_lut_outputs,
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,159 @@
+// Generated by builder_scripts/mode_tables.py from src/modes/specs/ProjectM.json. Do not edit.
+
+#ifndef _MODES_GENERATED_PROJECTM_RULES_HPP
+#define _MODES_GENERATED_PROJECTM_RULES_HPP
+
+#include "core/stick_rules.hpp"
+
+namespace stick_rules {
+    namespace project_m {
+        constexpr uint32_t LEDGEDASH_MAX_JUMP_TRAJ = MODE_FLAG_0;
+
+        static const StickRule analog_rules[] PROGMEM = {
+            // 48.25 deg, magnitude 125
+            left_stick(DIAGONAL, Y_NEGATIVE, 83, 93),
+            left_x(MOD_X | HORIZONTAL, 0, 70),
+            left_y(MOD_X | VERTICAL, 0, 60),
+            // 19.49 deg, magnitude 69
+            right_stick(MOD_X | C_HORIZONTAL, 0, 65, SIGN_Y, 23),
+            // 25.91 deg, magnitude 78
+            left_stick(MOD_X | DIAGONAL, 0, 70, 34),
+            // 20.04 deg, magnitude 90
+            left_stick(MOD_X | DIAGONAL | B, 0, 85, 31),
+            // 23.11 deg, magnitude 89
+            left_stick(MOD_X | DIAGONAL | R, 0, 82, 35),
+            // 35.54 deg, magnitude 95
+            left_stick(MOD_X | DIAGONAL | C_UP, 0, 77, 55),
+            // 23.70 deg, magnitude 90
+            left_stick(MOD_X | DIAGONAL | C_DOWN, 0, 82, 36),
+            // 30.76 deg, magnitude 98
+            left_stick(MOD_X | DIAGONAL | C_LEFT, 0, 84, 50),
+            // 40.27 deg, magnitude 94
+            left_stick(MOD_X | DIAGONAL | C_RIGHT, 0, 72, 61),
+            left_x(MOD_Y | HORIZONTAL, 0, 35),
+            left_y(MOD_Y | VERTICAL, 0, 70),
+            // 64.23 deg, magnitude 64
+            left_stick(MOD_Y | DIAGONAL, 0, 28, 58),
+            // 71.77 deg, magnitude 89
+            left_stick(MOD_Y | DIAGONAL | B, 0, 28, 85),
+            // 58.12 deg, magnitude 97
+            left_stick(MOD_Y | DIAGONAL | R, 0, 51, 82),
+            // 54.46 deg, magnitude 95
+            left_stick(MOD_Y | DIAGONAL | C_UP, 0, 55, 77),
+            // 67.48 deg, magnitude 89
+            left_stick(MOD_Y | DIAGONAL | C_DOWN, 0, 34, 82),
+            // 64.54 deg, magnitude 93
+            left_stick(MOD_Y | DIAGONAL | C_LEFT, 0, 40, 84),
+            // 49.27 deg, magnitude 95
+            left_stick(MOD_Y | DIAGONAL | C_RIGHT, 0, 62, 72),
+            // C-stick ASDI Slideoff angle overrides any other C-stick modifiers (such as angled fsmash).
+            // We don't apply this for c-up + c-left/c-right in case we want to implement C-stick nair
+            // somehow.
+            // 3000 9875 = 30 78
+            // 70.35 deg, magnitude 104
+            right_stick(C_HORIZONTAL | C_Y_NEGATIVE, 0, 35, SIGN_CY, 98),
+            // Horizontal SOCD overrides X-axis modifiers (for ledgedash maximum jump trajectory).
+            left_x(LEDGEDASH_MAX_JUMP_TRAJ | HORIZONTAL_SOCD, VERTICAL | SHIELD, 100),
+        };
+
+        // Left stick lookup table: 14 index bits (6 low, 8 high), 9 of 256 rows unique,
+        // 21 outputs, 972 bytes in total.
+        static const uint32_t left_stick_lut_bits[] PROGMEM = {
+            HORIZONTAL, B, R, C_LEFT, C_RIGHT, C_DOWN, VERTICAL, Y_NEGATIVE, MOD_X, MOD_Y, C_UP,
+            SHIELD, HORIZONTAL_SOCD, LEDGEDASH_MAX_JUMP_TRAJ,
+        };
+        static const uint8_t left_stick_lut_rows[] PROGMEM = {
+            0, 1, 0, 0, 2, 3, 2, 3, 4, 5, 4, 5, 4, 5, 4, 5, 0, 1, 0, 0, 2, 6, 2, 6, 4, 7, 4, 7, 4,
+            7, 4, 7, 0, 1, 0, 0, 2, 3, 2, 3, 4, 5, 4, 5, 4, 5, 4, 5, 0, 1, 0, 0, 2, 6, 2, 6, 4, 7,
+            4, 7, 4, 7, 4, 7, 0, 1, 0, 0, 2, 3, 2, 3, 4, 5, 4, 5, 4, 5, 4, 5, 0, 1, 0, 0, 2, 6, 2,
+            6, 4, 7, 4, 7, 4, 7, 4, 7, 0, 1, 0, 0, 2, 3, 2, 3, 4, 5, 4, 5, 4, 5, 4, 5, 0, 1, 0, 0,
+            2, 6, 2, 6, 4, 7, 4, 7, 4, 7, 4, 7, 0, 1, 0, 0, 2, 3, 2, 3, 4, 5, 4, 5, 4, 5, 4, 5, 0,
+            1, 0, 0, 2, 6, 2, 6, 4, 7, 4, 7, 4, 7, 4, 7, 0, 1, 0, 0, 2, 3, 2, 3, 4, 5, 4, 5, 4, 5,
+            4, 5, 0, 1, 0, 0, 2, 6, 2, 6, 4, 7, 4, 7, 4, 7, 4, 7, 8, 1, 8, 0, 8, 3, 8, 3, 8, 5, 8,
+            5, 8, 5, 8, 5, 8, 1, 8, 0, 8, 6, 8, 6, 8, 7, 8, 7, 8, 7, 8, 7, 0, 1, 0, 0, 2, 3, 2, 3,
+            4, 5, 4, 5, 4, 5, 4, 5, 0, 1, 0, 0, 2, 6, 2, 6, 4, 7, 4, 7, 4, 7, 4, 7,
+        };
+        static const uint8_t left_stick_lut_cells[] PROGMEM = {
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+            1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+            0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 2, 0, 2, 0, 2, 0, 2, 0, 2, 0, 2, 0, 2, 0, 2, 0,
+            2, 0, 2, 0, 2, 0, 2, 0, 2, 0, 2, 0, 2, 0, 2, 0, 2, 0, 2, 0, 2, 0, 2, 0, 2, 0, 2, 0, 2,
+            0, 2, 0, 2, 0, 2, 0, 2, 0, 2, 0, 2, 0, 2, 0, 2, 0, 2, 3, 4, 3, 8, 3, 10, 3, 10, 3, 12,
+            3, 12, 3, 12, 3, 12, 3, 14, 3, 14, 3, 14, 3, 14, 3, 14, 3, 14, 3, 14, 3, 14, 3, 16, 3,
+            16, 3, 16, 3, 16, 3, 12, 3, 12, 3, 12, 3, 12, 3, 14, 3, 14, 3, 14, 3, 14, 3, 14, 3, 14,
+            3, 14, 3, 14, 0, 5, 0, 5, 0, 5, 0, 5, 0, 5, 0, 5, 0, 5, 0, 5, 0, 5, 0, 5, 0, 5, 0, 5, 0,
+            5, 0, 5, 0, 5, 0, 5, 0, 5, 0, 5, 0, 5, 0, 5, 0, 5, 0, 5, 0, 5, 0, 5, 0, 5, 0, 5, 0, 5,
+            0, 5, 0, 5, 0, 5, 0, 5, 0, 5, 6, 7, 6, 9, 6, 11, 6, 11, 6, 13, 6, 13, 6, 13, 6, 13, 6,
+            15, 6, 15, 6, 15, 6, 15, 6, 15, 6, 15, 6, 15, 6, 15, 6, 17, 6, 17, 6, 17, 6, 17, 6, 13,
+            6, 13, 6, 13, 6, 13, 6, 15, 6, 15, 6, 15, 6, 15, 6, 15, 6, 15, 6, 15, 6, 15, 3, 18, 3,
+            18, 3, 18, 3, 18, 3, 12, 3, 12, 3, 12, 3, 12, 3, 14, 3, 14, 3, 14, 3, 14, 3, 14, 3, 14,
+            3, 14, 3, 14, 3, 16, 3, 16, 3, 16, 3, 16, 3, 12, 3, 12, 3, 12, 3, 12, 3, 14, 3, 14, 3,
+            14, 3, 14, 3, 14, 3, 14, 3, 14, 3, 14, 6, 19, 6, 19, 6, 19, 6, 19, 6, 13, 6, 13, 6, 13,
+            6, 13, 6, 15, 6, 15, 6, 15, 6, 15, 6, 15, 6, 15, 6, 15, 6, 15, 6, 17, 6, 17, 6, 17, 6,
+            17, 6, 13, 6, 13, 6, 13, 6, 13, 6, 15, 6, 15, 6, 15, 6, 15, 6, 15, 6, 15, 6, 15, 6, 15,
+            20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20,
+            20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20,
+            20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20,
+        };
+        static const StickOutput left_stick_lut_outputs[] PROGMEM = {
+            { 0, SIGN_X | (SIGN_X << 4), 0, 0 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 83, 93 },
+            { LEFT_X, SIGN_X | (SIGN_Y << 4), 70, 0 },
+            { LEFT_Y, SIGN_X | (SIGN_Y << 4), 0, 60 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 70, 34 },
+            { LEFT_X, SIGN_X | (SIGN_Y << 4), 35, 0 },
+            { LEFT_Y, SIGN_X | (SIGN_Y << 4), 0, 70 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 28, 58 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 85, 31 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 28, 85 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 82, 35 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 51, 82 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 84, 50 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 40, 84 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 72, 61 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 62, 72 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 82, 36 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 34, 82 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 77, 55 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 55, 77 },
+            { LEFT_X, SIGN_X | (SIGN_Y << 4), 100, 0 },
+        };
+        static const StickLut left_stick_lut PROGMEM = {
+            left_stick_lut_bits,
+            6,
+            8,
+            left_stick_lut_rows,
+            left_stick_lut_cells,
+            left_stick_lut_outputs,
+        };
+
+        // Right stick lookup table: 3 index bits (3 low, 0 high), 1 of 1 rows unique,
+        // 3 outputs, 33 bytes in total.
+        static const uint32_t right_stick_lut_bits[] PROGMEM = {
+            C_HORIZONTAL, C_Y_NEGATIVE, MOD_X,
+        };
+        static const uint8_t right_stick_lut_rows[] PROGMEM = {
+            0,
+        };
+        static const uint8_t right_stick_lut_cells[] PROGMEM = {
+            0, 0, 0, 1, 0, 2, 0, 1,
+        };
+        static const StickOutput right_stick_lut_outputs[] PROGMEM = {
+            { 0, SIGN_X | (SIGN_X << 4), 0, 0 },
+            { RIGHT_X | RIGHT_Y, SIGN_CX | (SIGN_CY << 4), 35, 98 },
+            { RIGHT_X | RIGHT_Y, SIGN_CX | (SIGN_Y << 4), 65, 23 },
+        };
+        static const StickLut right_stick_lut PROGMEM = {
+            right_stick_lut_bits,
+            3,
+            0,
+            right_stick_lut_rows,
+            right_stick_lut_cells,
+            right_stick_lut_outputs,
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,217 @@
+// Generated by builder_scripts/mode_tables.py from src/modes/specs/Rivals2.json. Do not edit.
+
+#ifndef _MODES_GENERATED_RIVALS2_RULES_HPP
+#define _MODES_GENERATED_RIVALS2_RULES_HPP
+
+#include "core/stick_rules.hpp"
+
+namespace stick_rules {
+    namespace rivals2 {
+        constexpr uint32_t ANGLED_TILT_HELD = MODE_FLAG_0;
+        constexpr uint32_t ANGLED_TILT_LOCKOUT = MODE_FLAG_1;
+
+        static const StickRule analog_rules[] PROGMEM = {
+            // Accurate diagonals rather than (+/- 1.2, 1.2) should be (0.87~, 0.87~).
+            // 92 (0.78 in-game), reduced below 0.8 to allow crouch tilts/crouch turn-around tilts.
+            // Y value 0.83. >0.8 allows fast fall.
+            // 46.22 deg, magnitude 133
+            left_stick(DIAGONAL, SHIELD, 92, 96),
+            // (0.77~, 0.77~) to prevent spot dodging when pressing diagonal on the ground
+            // 45.00 deg, magnitude 130
+            left_stick(DIAGONAL | SHIELD, 0, 92, 92),
+            // MX Angled Tilts
+            // (x, y), (69, 53), (~0.506, ~0.31) [coords, code_values, in-game values]
+            // 37.53 deg, magnitude 87
+            left_stick(ANGLED_TILT_HELD, 0, 69, 53),
+            // 76 gives 0.58~ in-game for a medium speed walk. will also do tilts
+            left_x(MOD_X | HORIZONTAL, 0, 76),
+            // 48 (0.31~ in-game), 0.3 allows tilts and shield drop
+            left_y(MOD_X | VERTICAL, 0, 53),
+            // For max-length diagonal wavedash while holding ModX
+            // 28.93 deg, magnitude 87
+            left_stick(MOD_X | DIAGONAL | SHIELD, 0, 76, 42),
+            // MX 100% Magnitude UpB when holding B
+            // (x, y), (123, 51), (1.14~, 0.29~) [coords, code_values, in-game values]
+            // 22.52 deg, magnitude 133
+            left_stick(MOD_X | DIAGONAL | B, SHIELD | Z, 123, 51),
+            // (x, y), (120, 61), (1.1~, 0.41~) [coords, code_values, in-game values]
+            // 26.95 deg, magnitude 135
+            left_stick(MOD_X | DIAGONAL | B | C_DOWN, SHIELD | Z, 120, 61),
+            // (x, y), (115, 69), (1.04~, 0.51~) [coords, code_values, in-game values]
+            // 30.96 deg, magnitude 134
+            left_stick(MOD_X | DIAGONAL | B | C_LEFT, SHIELD | Z, 115, 69),
+            // (x, y), (110, 78), (0.98~, 0.61~) [coords, code_values, in-game values]
+            // 35.34 deg, magnitude 135
+            left_stick(MOD_X | DIAGONAL | B | C_UP, SHIELD | Z, 110, 78),
+            // (x, y), (103, 87), (0.9~, 0.71~) [coords, code_values, in-game values]
+            // 40.19 deg, magnitude 135
+            left_stick(MOD_X | DIAGONAL | B | C_RIGHT, SHIELD | Z, 103, 87),
+            // MX 60% Magnitude UpB when not holding B nor Z
+            // (x, y), (68, 42), (~0.49, ~0.188) [coords, code_values, in-game values]
+            // 31.70 deg, magnitude 80
+            left_stick(MOD_X | DIAGONAL, SHIELD | Z | B | ANGLED_TILT_LOCKOUT, 68, 42),
+            // (x, y), (71, 47), (~0.52, ~0.24) [coords, code_values, in-game values]
+            // 33.50 deg, magnitude 85
+            left_stick(MOD_X | DIAGONAL | C_DOWN, SHIELD | Z | B | ANGLED_TILT_LOCKOUT, 71, 47),
+            // (x, y), (71, 51), (~0.52, 0.29~) [coords, code_values, in-game values]
+            // 35.69 deg, magnitude 87
+            left_stick(MOD_X | DIAGONAL | C_LEFT, SHIELD | Z | B | ANGLED_TILT_LOCKOUT, 71, 51),
+            // (x, y), (69, 55), (~0.51, ~0.34) [coords, code_values, in-game values]
+            // 38.56 deg, magnitude 88
+            left_stick(MOD_X | DIAGONAL | C_UP, SHIELD | Z | B | ANGLED_TILT_LOCKOUT, 69, 55),
+            // (x, y), (64, 60), (, ~0.38) [coords, code_values, in-game values]
+            // 43.15 deg, magnitude 88
+            left_stick(MOD_X | DIAGONAL | C_RIGHT, SHIELD | Z | B | ANGLED_TILT_LOCKOUT, 64, 60),
+            // MX Shortest UpB when holding Z
+            // (x, y), (53, 68), (~0.31, ~0.188) [coords, code_values, in-game values]
+            // 38.40 deg, magnitude 68
+            left_stick(MOD_X | DIAGONAL | Z, SHIELD, 53, 42),
+            // ModX Angled Tilts
+            // 37.53 deg, magnitude 87
+            left_stick(MOD_X | DIAGONAL | A, SHIELD, 69, 53),
+            // 53 equates to 0.318~ in-game. 0.3 is min to achieve a walk
+            left_x(MOD_Y | HORIZONTAL, 0, 53),
+            // 0.75~ in-game. will shield drop and tap jump; will not fast fall
+            left_y(MOD_Y | VERTICAL, 0, 90),
+            // MY 100% Magnitude UpB when holding B
+            // (x, y), (51, 123), (~0.29, ~1.14) [coords, code_values, in-game values]
+            // 67.48 deg, magnitude 133
+            left_stick(MOD_Y | DIAGONAL | B, SHIELD | Z, 51, 123),
+            // (x, y), (61, 120), (~0.41, ~1.1) [coords, code_values, in-game values]
+            // 63.05 deg, magnitude 135
+            left_stick(MOD_Y | DIAGONAL | B | C_DOWN, SHIELD | Z, 61, 120),
+            // (x, y), (69, 115), (~0.51, 1.04~) [coords, code_values, in-game values]
+            // 59.04 deg, magnitude 134
+            left_stick(MOD_Y | DIAGONAL | B | C_LEFT, SHIELD | Z, 69, 115),
+            // (x, y), (78, 110), (~0.61, 0.98~) [coords, code_values, in-game values]
+            // 54.66 deg, magnitude 135
+            left_stick(MOD_Y | DIAGONAL | B | C_UP, SHIELD | Z, 78, 110),
+            // (x, y), (87, 103), (~0.71, 0.9~) [coords, code_values, in-game values]
+            // 49.81 deg, magnitude 135
+            left_stick(MOD_Y | DIAGONAL | B | C_RIGHT, SHIELD | Z, 87, 103),
+            // MY 60% Magnitude UpB when not holding B nor Z
+            // (x, y), (42, 68), (~0.188, ~0.49) [coords, code_values, in-game values]
+            // 58.30 deg, magnitude 80
+            left_stick(MOD_Y | DIAGONAL, SHIELD | Z | B, 42, 68),
+            // (x, y), (47, 71), (~0.24, ~0.52) [coords, code_values, in-game values]
+            // 56.50 deg, magnitude 85
+            left_stick(MOD_Y | DIAGONAL | C_DOWN, SHIELD | Z | B, 47, 71),
+            // (x, y), (51, 71), (~0.29, ~0.52) [coords, code_values, in-game values]
+            // 54.31 deg, magnitude 87
+            left_stick(MOD_Y | DIAGONAL | C_LEFT, SHIELD | Z | B, 51, 71),
+            // (x, y), (55, 69), (~0.34, ~0.51) [coords, code_values, in-game values]
+            // 51.44 deg, magnitude 88
+            left_stick(MOD_Y | DIAGONAL | C_UP, SHIELD | Z | B, 55, 69),
+            // (x, y), (60, 64), (~0.38, ~0.) [coords, code_values, in-game values]
+            // 46.85 deg, magnitude 88
+            left_stick(MOD_Y | DIAGONAL | C_RIGHT, SHIELD | Z | B, 60, 64),
+            // MY Shortest UpB when holding Z
+            // (x, y), (42, 53), (~0.188, ~0.31) [coords, code_values, in-game values]
+            // 51.60 deg, magnitude 68
+            left_stick(MOD_Y | DIAGONAL | Z, SHIELD, 42, 53),
+        };
+
+        // Left stick lookup table: 14 index bits (6 low, 8 high), 14 of 256 rows unique,
+        // 35 outputs, 1348 bytes in total.
+        static const uint32_t left_stick_lut_bits[] PROGMEM = {
+            B, ANGLED_TILT_LOCKOUT, ANGLED_TILT_HELD, SHIELD, HORIZONTAL, VERTICAL, MOD_X, MOD_Y, A,
+            Z, C_LEFT, C_RIGHT, C_DOWN, C_UP,
+        };
+        static const uint8_t left_stick_lut_rows[] PROGMEM = {
+            0, 1, 2, 2, 0, 3, 2, 2, 0, 4, 5, 5, 0, 3, 5, 5, 0, 6, 7, 7, 0, 3, 7, 7, 0, 4, 5, 5, 0,
+            3, 5, 5, 0, 8, 9, 9, 0, 3, 9, 9, 0, 4, 5, 5, 0, 3, 5, 5, 0, 8, 9, 9, 0, 3, 9, 9, 0, 4,
+            5, 5, 0, 3, 5, 5, 0, 10, 11, 11, 0, 3, 11, 11, 0, 4, 5, 5, 0, 3, 5, 5, 0, 6, 7, 7, 0, 3,
+            7, 7, 0, 4, 5, 5, 0, 3, 5, 5, 0, 8, 9, 9, 0, 3, 9, 9, 0, 4, 5, 5, 0, 3, 5, 5, 0, 8, 9,
+            9, 0, 3, 9, 9, 0, 4, 5, 5, 0, 3, 5, 5, 0, 12, 13, 13, 0, 3, 13, 13, 0, 4, 5, 5, 0, 3, 5,
+            5, 0, 12, 13, 13, 0, 3, 13, 13, 0, 4, 5, 5, 0, 3, 5, 5, 0, 8, 9, 9, 0, 3, 9, 9, 0, 4, 5,
+            5, 0, 3, 5, 5, 0, 8, 9, 9, 0, 3, 9, 9, 0, 4, 5, 5, 0, 3, 5, 5, 0, 12, 13, 13, 0, 3, 13,
+            13, 0, 4, 5, 5, 0, 3, 5, 5, 0, 12, 13, 13, 0, 3, 13, 13, 0, 4, 5, 5, 0, 3, 5, 5, 0, 8,
+            9, 9, 0, 3, 9, 9, 0, 4, 5, 5, 0, 3, 5, 5, 0, 8, 9, 9, 0, 3, 9, 9, 0, 4, 5, 5, 0, 3, 5,
+            5,
+        };
+        static const uint8_t left_stick_lut_cells[] PROGMEM = {
+            0, 0, 0, 0, 8, 8, 8, 8, 0, 0, 0, 0, 8, 8, 8, 8, 0, 0, 0, 0, 8, 8, 8, 8, 0, 0, 0, 0, 8,
+            8, 8, 8, 0, 0, 0, 0, 8, 8, 8, 8, 0, 0, 0, 0, 8, 8, 8, 8, 1, 1, 1, 1, 8, 8, 8, 8, 29, 29,
+            29, 29, 8, 8, 8, 8, 0, 0, 0, 0, 8, 8, 8, 8, 0, 0, 0, 0, 8, 8, 8, 8, 2, 2, 2, 2, 32, 32,
+            32, 32, 2, 2, 2, 2, 32, 32, 32, 32, 3, 3, 3, 3, 8, 8, 8, 8, 3, 3, 3, 3, 8, 8, 8, 8, 4,
+            9, 32, 9, 4, 9, 32, 9, 30, 30, 30, 30, 30, 30, 30, 30, 0, 0, 0, 0, 8, 8, 8, 8, 0, 0, 0,
+            0, 8, 8, 8, 8, 5, 5, 5, 5, 33, 33, 33, 33, 5, 5, 5, 5, 33, 33, 33, 33, 6, 6, 6, 6, 34,
+            34, 34, 34, 6, 6, 6, 6, 34, 34, 34, 34, 7, 10, 7, 10, 7, 10, 7, 10, 31, 31, 31, 31, 31,
+            31, 31, 31, 0, 0, 0, 0, 8, 8, 8, 8, 0, 0, 0, 0, 8, 8, 8, 8, 2, 2, 2, 2, 32, 32, 32, 32,
+            2, 2, 2, 2, 32, 32, 32, 32, 3, 3, 3, 3, 8, 8, 8, 8, 3, 3, 3, 3, 8, 8, 8, 8, 8, 8, 8, 8,
+            8, 8, 8, 8, 30, 30, 30, 30, 30, 30, 30, 30, 0, 0, 0, 0, 8, 8, 8, 8, 0, 0, 0, 0, 8, 8, 8,
+            8, 2, 2, 2, 2, 32, 32, 32, 32, 2, 2, 2, 2, 32, 32, 32, 32, 3, 3, 3, 3, 8, 8, 8, 8, 3, 3,
+            3, 3, 8, 8, 8, 8, 11, 11, 11, 11, 11, 11, 11, 11, 30, 30, 30, 30, 30, 30, 30, 30, 0, 0,
+            0, 0, 8, 8, 8, 8, 0, 0, 0, 0, 8, 8, 8, 8, 5, 5, 5, 5, 33, 33, 33, 33, 5, 5, 5, 5, 33,
+            33, 33, 33, 6, 6, 6, 6, 34, 34, 34, 34, 6, 6, 6, 6, 34, 34, 34, 34, 12, 12, 12, 12, 12,
+            12, 12, 12, 31, 31, 31, 31, 31, 31, 31, 31, 0, 0, 0, 0, 8, 8, 8, 8, 0, 0, 0, 0, 8, 8, 8,
+            8, 2, 2, 2, 2, 32, 32, 32, 32, 2, 2, 2, 2, 32, 32, 32, 32, 3, 3, 3, 3, 8, 8, 8, 8, 3, 3,
+            3, 3, 8, 8, 8, 8, 13, 15, 32, 15, 13, 15, 32, 15, 30, 30, 30, 30, 30, 30, 30, 30, 0, 0,
+            0, 0, 8, 8, 8, 8, 0, 0, 0, 0, 8, 8, 8, 8, 5, 5, 5, 5, 33, 33, 33, 33, 5, 5, 5, 5, 33,
+            33, 33, 33, 6, 6, 6, 6, 34, 34, 34, 34, 6, 6, 6, 6, 34, 34, 34, 34, 14, 16, 14, 16, 14,
+            16, 14, 16, 31, 31, 31, 31, 31, 31, 31, 31, 0, 0, 0, 0, 8, 8, 8, 8, 0, 0, 0, 0, 8, 8, 8,
+            8, 2, 2, 2, 2, 32, 32, 32, 32, 2, 2, 2, 2, 32, 32, 32, 32, 3, 3, 3, 3, 8, 8, 8, 8, 3, 3,
+            3, 3, 8, 8, 8, 8, 17, 19, 32, 19, 17, 19, 32, 19, 30, 30, 30, 30, 30, 30, 30, 30, 0, 0,
+            0, 0, 8, 8, 8, 8, 0, 0, 0, 0, 8, 8, 8, 8, 5, 5, 5, 5, 33, 33, 33, 33, 5, 5, 5, 5, 33,
+            33, 33, 33, 6, 6, 6, 6, 34, 34, 34, 34, 6, 6, 6, 6, 34, 34, 34, 34, 18, 20, 18, 20, 18,
+            20, 18, 20, 31, 31, 31, 31, 31, 31, 31, 31, 0, 0, 0, 0, 8, 8, 8, 8, 0, 0, 0, 0, 8, 8, 8,
+            8, 2, 2, 2, 2, 32, 32, 32, 32, 2, 2, 2, 2, 32, 32, 32, 32, 3, 3, 3, 3, 8, 8, 8, 8, 3, 3,
+            3, 3, 8, 8, 8, 8, 21, 23, 32, 23, 21, 23, 32, 23, 30, 30, 30, 30, 30, 30, 30, 30, 0, 0,
+            0, 0, 8, 8, 8, 8, 0, 0, 0, 0, 8, 8, 8, 8, 5, 5, 5, 5, 33, 33, 33, 33, 5, 5, 5, 5, 33,
+            33, 33, 33, 6, 6, 6, 6, 34, 34, 34, 34, 6, 6, 6, 6, 34, 34, 34, 34, 22, 24, 22, 24, 22,
+            24, 22, 24, 31, 31, 31, 31, 31, 31, 31, 31, 0, 0, 0, 0, 8, 8, 8, 8, 0, 0, 0, 0, 8, 8, 8,
+            8, 2, 2, 2, 2, 32, 32, 32, 32, 2, 2, 2, 2, 32, 32, 32, 32, 3, 3, 3, 3, 8, 8, 8, 8, 3, 3,
+            3, 3, 8, 8, 8, 8, 25, 27, 32, 27, 25, 27, 32, 27, 30, 30, 30, 30, 30, 30, 30, 30, 0, 0,
+            0, 0, 8, 8, 8, 8, 0, 0, 0, 0, 8, 8, 8, 8, 5, 5, 5, 5, 33, 33, 33, 33, 5, 5, 5, 5, 33,
+            33, 33, 33, 6, 6, 6, 6, 34, 34, 34, 34, 6, 6, 6, 6, 34, 34, 34, 34, 26, 28, 26, 28, 26,
+            28, 26, 28, 31, 31, 31, 31, 31, 31, 31, 31,
+        };
+        static const StickOutput left_stick_lut_outputs[] PROGMEM = {
+            { 0, SIGN_X | (SIGN_X << 4), 0, 0 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 92, 96 },
+            { LEFT_X, SIGN_X | (SIGN_Y << 4), 76, 0 },
+            { LEFT_Y, SIGN_X | (SIGN_Y << 4), 0, 53 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 68, 42 },
+            { LEFT_X, SIGN_X | (SIGN_Y << 4), 53, 0 },
+            { LEFT_Y, SIGN_X | (SIGN_Y << 4), 0, 90 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 42, 68 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 69, 53 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 123, 51 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 51, 123 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 53, 42 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 42, 53 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 71, 51 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 51, 71 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 115, 69 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 69, 115 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 64, 60 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 60, 64 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 103, 87 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 87, 103 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 71, 47 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 47, 71 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 120, 61 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 61, 120 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 69, 55 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 55, 69 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 110, 78 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 78, 110 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 92, 92 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 76, 42 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 53, 90 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 76, 53 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 53, 53 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 69, 90 },
+        };
+        static const StickLut left_stick_lut PROGMEM = {
+            left_stick_lut_bits,
+            6,
+            8,
+            left_stick_lut_rows,
+            left_stick_lut_cells,
+            left_stick_lut_outputs,
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,202 @@
+// Generated by builder_scripts/mode_tables.py from src/modes/specs/UltimateR4.json. Do not edit.
+
+#ifndef _MODES_GENERATED_ULTIMATER4_RULES_HPP
+#define _MODES_GENERATED_ULTIMATER4_RULES_HPP
+
+#include "core/stick_rules.hpp"
+
+namespace stick_rules {
+    namespace ultimate_r4 {
+        static const StickRule analog_rules[] PROGMEM = {
+            // Angled fsmash/ftilt with C-Stick + MX
+            // 30.54 deg, magnitude 116
+            right_stick(MOD_X | C_HORIZONTAL, SHIELD, 100, SIGN_POSITIVE, 59),
+            // MX + q1/2/3/4 = 53 34
+            // 50.81 deg, magnitude 84
+            left_stick(MOD_X | DIAGONAL, SHIELD, 53, 65),
+            // Fastest walking speed before run
+            left_x(MOD_X | HORIZONTAL, SHIELD | DIAGONAL, 53),
+            // Crouch with mod_x = 65
+            left_y(MOD_X | VERTICAL, SHIELD | HORIZONTAL, 65),
+            // MX Up B angles
+            // (39.05) = 53 43
+            // 39.05 deg, magnitude 68
+            left_stick(MOD_X | DIAGONAL | C_DOWN, 0, 53, 43),
+            // (36.35) = 53 39
+            // 36.35 deg, magnitude 66
+            left_stick(MOD_X | DIAGONAL | C_LEFT, 0, 53, 39),
+            // (30.32) = 56 41
+            // 30.32 deg, magnitude 61
+            left_stick(MOD_X | DIAGONAL | C_UP, 0, 53, 31),
+            // (27.85) = 49 42
+            // 27.85 deg, magnitude 60
+            left_stick(MOD_X | DIAGONAL | C_RIGHT, 0, 53, 28),
+            // MX Extended Up B Angles
+            // (33.29) = 67 44
+            // 41.85 deg, magnitude 90
+            left_stick(MOD_X | DIAGONAL | B, 0, 67, 60),
+            // (39.38) = 67 55
+            // 39.38 deg, magnitude 87
+            left_stick(MOD_X | DIAGONAL | B | C_DOWN, 0, 67, 55),
+            // (36.18) = 67 49
+            // 36.18 deg, magnitude 83
+            left_stick(MOD_X | DIAGONAL | B | C_LEFT, 0, 67, 49),
+            // (30.2) = 67 39
+            // 30.20 deg, magnitude 78
+            left_stick(MOD_X | DIAGONAL | B | C_UP, 0, 67, 39),
+            // (27.58) = 67 35
+            // 27.58 deg, magnitude 76
+            left_stick(MOD_X | DIAGONAL | B | C_RIGHT, 0, 67, 35),
+            // Angled Ftilts
+            // 35.84 deg, magnitude 44
+            left_stick(MOD_X | DIAGONAL | A, 0, 36, 26),
+            // Angled fsmash/ftilt with C-Stick + MY
+            // 30.54 deg, magnitude 116
+            right_stick(MOD_Y | C_HORIZONTAL, SHIELD, 100, SIGN_POSITIVE, -59),
+            // 50.81 deg, magnitude 84
+            left_stick(MOD_Y | DIAGONAL, SHIELD, 53, 65),
+            // Allow tink/yink walk shield
+            left_x(MOD_Y | HORIZONTAL, SHIELD | DIAGONAL, 28),
+            // Crouch with mod_y = 65
+            left_y(MOD_Y | VERTICAL, SHIELD | HORIZONTAL, 65),
+            // MY Up B angles
+            // (50.95) = 43 53
+            // 50.95 deg, magnitude 68
+            left_stick(MOD_Y | DIAGONAL | C_DOWN, 0, 43, 53),
+            // (53.65) = 39 53
+            // 47.25 deg, magnitude 72
+            left_stick(MOD_Y | DIAGONAL | C_LEFT, 0, 49, 53),
+            // (59.68) = 31 53
+            // 59.68 deg, magnitude 61
+            left_stick(MOD_Y | DIAGONAL | C_UP, 0, 31, 53),
+            // (62.15) = 28 53
+            // 62.15 deg, magnitude 60
+            left_stick(MOD_Y | DIAGONAL | C_RIGHT, 0, 28, 53),
+            // MY Extended Up B Angles
+            // (56.71) = 44 67
+            // 56.71 deg, magnitude 80
+            left_stick(MOD_Y | DIAGONAL | B, 0, 44, 67),
+            // (50.62) = 55 67
+            // 50.62 deg, magnitude 87
+            left_stick(MOD_Y | DIAGONAL | B | C_DOWN, 0, 55, 67),
+            // (53.82) = 49 67
+            // 53.82 deg, magnitude 83
+            left_stick(MOD_Y | DIAGONAL | B | C_LEFT, 0, 49, 67),
+            // (59.8) = 39 67
+            // 59.80 deg, magnitude 78
+            left_stick(MOD_Y | DIAGONAL | B | C_UP, 0, 39, 67),
+            // (62.42) = 35 67
+            // 62.42 deg, magnitude 76
+            left_stick(MOD_Y | DIAGONAL | B | C_RIGHT, 0, 35, 67),
+            // MY Pivot Uptilt/Dtilt
+            // 52.43 deg, magnitude 82
+            left_stick(MOD_Y | DIAGONAL | A, 0, 50, 65),
+            // Angled special while running to do down special
+            // 56.98 deg, magnitude 119
+            rule(
+                B | HORIZONTAL | DOWN,
+                MOD_X | MOD_Y,
+                LEFT_X | LEFT_Y,
+                SIGN_X,
+                65,
+                SIGN_POSITIVE,
+                -100
+            ),
+            // C-stick ASDI Slideoff angle overrides any other C-stick modifiers (such as angled fsmash).
+            // 5250 8500 = 42 68
+            // 58.30 deg, magnitude 80
+            right_stick(C_HORIZONTAL | C_VERTICAL, 0, 42, SIGN_CY, 68),
+        };
+
+        // Left stick lookup table: 12 index bits (4 low, 8 high), 13 of 256 rows unique,
+        // 26 outputs, 616 bytes in total.
+        static const uint32_t left_stick_lut_bits[] PROGMEM = {
+            B, A, C_LEFT, C_RIGHT, HORIZONTAL, VERTICAL, MOD_X, MOD_Y, DOWN, C_DOWN, C_UP, SHIELD,
+        };
+        static const uint8_t left_stick_lut_rows[] PROGMEM = {
+            0, 0, 0, 0, 0, 1, 2, 3, 0, 4, 2, 5, 0, 4, 2, 5, 0, 6, 0, 6, 0, 1, 2, 3, 0, 4, 2, 5, 0,
+            4, 2, 5, 0, 0, 0, 0, 0, 1, 2, 7, 0, 4, 2, 8, 0, 4, 2, 8, 0, 6, 0, 6, 0, 1, 2, 7, 0, 4,
+            2, 8, 0, 4, 2, 8, 0, 0, 0, 0, 0, 1, 2, 9, 0, 4, 2, 10, 0, 4, 2, 10, 0, 6, 0, 6, 0, 1, 2,
+            9, 0, 4, 2, 10, 0, 4, 2, 10, 0, 0, 0, 0, 0, 1, 2, 9, 0, 4, 2, 10, 0, 4, 2, 10, 0, 6, 0,
+            6, 0, 1, 2, 9, 0, 4, 2, 10, 0, 4, 2, 10, 0, 0, 0, 0, 0, 0, 0, 11, 0, 0, 0, 12, 0, 0, 0,
+            12, 0, 6, 0, 6, 0, 0, 0, 11, 0, 0, 0, 12, 0, 0, 0, 12, 0, 0, 0, 0, 0, 0, 0, 7, 0, 0, 0,
+            8, 0, 0, 0, 8, 0, 6, 0, 6, 0, 0, 0, 7, 0, 0, 0, 8, 0, 0, 0, 8, 0, 0, 0, 0, 0, 0, 0, 9,
+            0, 0, 0, 10, 0, 0, 0, 10, 0, 6, 0, 6, 0, 0, 0, 9, 0, 0, 0, 10, 0, 0, 0, 10, 0, 0, 0, 0,
+            0, 0, 0, 9, 0, 0, 0, 10, 0, 0, 0, 10, 0, 6, 0, 6, 0, 0, 0, 9, 0, 0, 0, 10, 0, 0, 0, 10,
+        };
+        static const uint8_t left_stick_lut_cells[] PROGMEM = {
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+            1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 3, 7, 5, 5, 10, 12, 5, 5, 14,
+            16, 5, 5, 14, 16, 5, 5, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 3, 8, 6, 6, 11,
+            13, 6, 6, 15, 17, 6, 6, 15, 17, 6, 6, 0, 9, 0, 9, 0, 9, 0, 9, 0, 9, 0, 9, 0, 9, 0, 9,
+            18, 20, 5, 5, 10, 12, 5, 5, 14, 16, 5, 5, 14, 16, 5, 5, 19, 21, 6, 6, 11, 13, 6, 6, 15,
+            17, 6, 6, 15, 17, 6, 6, 22, 24, 5, 5, 22, 24, 5, 5, 14, 16, 5, 5, 14, 16, 5, 5, 23, 25,
+            6, 6, 23, 25, 6, 6, 15, 17, 6, 6, 15, 17, 6, 6, 0, 7, 5, 5, 10, 12, 5, 5, 14, 16, 5, 5,
+            14, 16, 5, 5, 0, 8, 6, 6, 11, 13, 6, 6, 15, 17, 6, 6, 15, 17, 6, 6,
+        };
+        static const StickOutput left_stick_lut_outputs[] PROGMEM = {
+            { 0, SIGN_X | (SIGN_X << 4), 0, 0 },
+            { LEFT_X, SIGN_X | (SIGN_Y << 4), 53, 0 },
+            { LEFT_Y, SIGN_X | (SIGN_Y << 4), 0, 65 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 53, 65 },
+            { LEFT_X, SIGN_X | (SIGN_Y << 4), 28, 0 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 36, 26 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 50, 65 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 67, 60 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 44, 67 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_POSITIVE << 4), 65, -100 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 53, 39 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 49, 53 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 67, 49 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 49, 67 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 53, 28 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 28, 53 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 67, 35 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 35, 67 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 53, 43 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 43, 53 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 67, 55 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 55, 67 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 53, 31 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 31, 53 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 67, 39 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 39, 67 },
+        };
+        static const StickLut left_stick_lut PROGMEM = {
+            left_stick_lut_bits,
+            4,
+            8,
+            left_stick_lut_rows,
+            left_stick_lut_cells,
+            left_stick_lut_outputs,
+        };
+
+        // Right stick lookup table: 5 index bits (2 low, 3 high), 3 of 8 rows unique,
+        // 4 outputs, 56 bytes in total.
+        static const uint32_t right_stick_lut_bits[] PROGMEM = {
+            C_HORIZONTAL, C_VERTICAL, MOD_X, MOD_Y, SHIELD,
+        };
+        static const uint8_t right_stick_lut_rows[] PROGMEM = {
+            0, 1, 2, 2, 0, 0, 0, 0,
+        };
+        static const uint8_t right_stick_lut_cells[] PROGMEM = {
+            0, 0, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1,
+        };
+        static const StickOutput right_stick_lut_outputs[] PROGMEM = {
+            { 0, SIGN_X | (SIGN_X << 4), 0, 0 },
+            { RIGHT_X | RIGHT_Y, SIGN_CX | (SIGN_CY << 4), 42, 68 },
+            { RIGHT_X | RIGHT_Y, SIGN_CX | (SIGN_POSITIVE << 4), 100, 59 },
+            { RIGHT_X | RIGHT_Y, SIGN_CX | (SIGN_POSITIVE << 4), 100, -59 },
+        };
+        static const StickLut right_stick_lut PROGMEM = {
+            right_stick_lut_bits,
+            2,
+            3,
+            right_stick_lut_rows,
+            right_stick_lut_cells,
+            right_stick_lut_outputs,
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,225 @@
+// Generated by builder_scripts/mode_tables.py from src/modes/specs/Ultimate.json. Do not edit.
+
+#ifndef _MODES_GENERATED_ULTIMATE_RULES_HPP
+#define _MODES_GENERATED_ULTIMATE_RULES_HPP
+
+#include "core/stick_rules.hpp"
+
+namespace stick_rules {
+    namespace ultimate {
+        static const StickRule analog_rules[] PROGMEM = {
+            // MX + Horizontal = 6625 = 53
+            left_x(MOD_X | HORIZONTAL, 0, 53),
+            // Horizontal Shield tilt = 51
+            left_x(MOD_X | HORIZONTAL | SHIELD, 0, 51),
+            // Horizontal Tilts = 36
+            left_x(MOD_X | HORIZONTAL | A, 0, 36),
+            // MX + Vertical = 44
+            left_y(MOD_X | VERTICAL, 0, 44),
+            // Vertical Shield Tilt = 51
+            left_y(MOD_X | VERTICAL | SHIELD, 0, 51),
+            // MX + q1/2/3/4 = 53 35
+            // 33.44 deg, magnitude 64
+            left_stick(MOD_X | DIAGONAL, 0, 53, 35),
+            // MX + L, R, LS, and MS + q1/2/3/4 = 6375 3750 = 51 30
+            // 30.47 deg, magnitude 59
+            left_stick(MOD_X | DIAGONAL | SHIELD, 0, 51, 30),
+            // Angled fsmash/ftilt with C-Stick + MX
+            // 24.92 deg, magnitude 140
+            right_stick(MOD_X | C_HORIZONTAL, 0, 127, SIGN_Y, 59),
+            // MX Up B angles
+            // (33.44) = 53 35
+            // 33.44 deg, magnitude 64
+            left_stick(MOD_X | DIAGONAL, SHIELD, 53, 35),
+            // (39.05) = 53 43
+            // 39.05 deg, magnitude 68
+            left_stick(MOD_X | DIAGONAL | C_DOWN, SHIELD, 53, 43),
+            // (36.35) = 53 39
+            // 36.35 deg, magnitude 66
+            left_stick(MOD_X | DIAGONAL | C_LEFT, SHIELD, 53, 39),
+            // (30.32) = 56 41
+            // 30.32 deg, magnitude 61
+            left_stick(MOD_X | DIAGONAL | C_UP, SHIELD, 53, 31),
+            // (27.85) = 49 42
+            // 27.85 deg, magnitude 60
+            left_stick(MOD_X | DIAGONAL | C_RIGHT, SHIELD, 53, 28),
+            // MX Extended Up B Angles
+            // (33.29) = 67 44
+            // 33.29 deg, magnitude 80
+            left_stick(MOD_X | DIAGONAL | B, SHIELD, 67, 44),
+            // (39.38) = 67 55
+            // 39.38 deg, magnitude 87
+            left_stick(MOD_X | DIAGONAL | B | C_DOWN, SHIELD, 67, 55),
+            // (36.18) = 67 49
+            // 36.18 deg, magnitude 83
+            left_stick(MOD_X | DIAGONAL | B | C_LEFT, SHIELD, 67, 49),
+            // (30.2) = 67 39
+            // 30.20 deg, magnitude 78
+            left_stick(MOD_X | DIAGONAL | B | C_UP, SHIELD, 67, 39),
+            // (27.58) = 67 35
+            // 27.58 deg, magnitude 76
+            left_stick(MOD_X | DIAGONAL | B | C_RIGHT, SHIELD, 67, 35),
+            // Angled Ftilts
+            // 35.84 deg, magnitude 44
+            left_stick(MOD_X | DIAGONAL | A, SHIELD, 36, 26),
+            // MY + Horizontal (even if shield is held) = 41
+            left_x(MOD_Y | HORIZONTAL, 0, 41),
+            // MY Horizontal Tilts
+            left_x(MOD_Y | HORIZONTAL | A, 0, 36),
+            // MY + Vertical (even if shield is held) = 53
+            left_y(MOD_Y | VERTICAL, 0, 53),
+            // MY Vertical Tilts
+            left_y(MOD_Y | VERTICAL | A, 0, 36),
+            // MY + q1/2/3/4 = 35 59
+            // 56.56 deg, magnitude 64
+            left_stick(MOD_Y | DIAGONAL, 0, 35, 53),
+            // MY + L, R, LS, and MS + q1/2 = 38 70
+            // 61.50 deg, magnitude 80
+            left_stick(MOD_Y | DIAGONAL | SHIELD, 0, 38, 70),
+            // MY + L, R, LS, and MS + q3/4 = 40 68
+            // 59.53 deg, magnitude 79
+            left_stick(MOD_Y | DIAGONAL | SHIELD | X_NEGATIVE, 0, 40, 68),
+            // MY Up B angles
+            // (56.56) = 35 53
+            // 56.56 deg, magnitude 64
+            left_stick(MOD_Y | DIAGONAL, SHIELD, 35, 53),
+            // (50.95) = 43 53
+            // 50.95 deg, magnitude 68
+            left_stick(MOD_Y | DIAGONAL | C_DOWN, SHIELD, 43, 53),
+            // (53.65) = 39 53
+            // 47.25 deg, magnitude 72
+            left_stick(MOD_Y | DIAGONAL | C_LEFT, SHIELD, 49, 53),
+            // (59.68) = 31 53
+            // 59.68 deg, magnitude 61
+            left_stick(MOD_Y | DIAGONAL | C_UP, SHIELD, 31, 53),
+            // (62.15) = 28 53
+            // 62.15 deg, magnitude 60
+            left_stick(MOD_Y | DIAGONAL | C_RIGHT, SHIELD, 28, 53),
+            // MY Extended Up B Angles
+            // (56.71) = 44 67
+            // 56.71 deg, magnitude 80
+            left_stick(MOD_Y | DIAGONAL | B, SHIELD, 44, 67),
+            // (50.62) = 55 67
+            // 50.62 deg, magnitude 87
+            left_stick(MOD_Y | DIAGONAL | B | C_DOWN, SHIELD, 55, 67),
+            // (53.82) = 49 67
+            // 53.82 deg, magnitude 83
+            left_stick(MOD_Y | DIAGONAL | B | C_LEFT, SHIELD, 49, 67),
+            // (59.8) = 39 67
+            // 59.80 deg, magnitude 78
+            left_stick(MOD_Y | DIAGONAL | B | C_UP, SHIELD, 39, 67),
+            // (62.42) = 35 67
+            // 62.42 deg, magnitude 76
+            left_stick(MOD_Y | DIAGONAL | B | C_RIGHT, SHIELD, 35, 67),
+            // MY Pivot Uptilt/Dtilt
+            // 48.18 deg, magnitude 51
+            left_stick(MOD_Y | DIAGONAL | A, SHIELD, 34, 38),
+            // C-stick ASDI Slideoff angle overrides any other C-stick modifiers (such as angled fsmash).
+            // 5250 8500 = 42 68
+            // 58.30 deg, magnitude 80
+            right_stick(C_HORIZONTAL | C_VERTICAL, 0, 42, SIGN_CY, 68),
+        };
+
+        // Left stick lookup table: 12 index bits (4 low, 8 high), 14 of 256 rows unique,
+        // 34 outputs, 664 bytes in total.
+        static const uint32_t left_stick_lut_bits[] PROGMEM = {
+            B, A, HORIZONTAL, VERTICAL, X_NEGATIVE, MOD_X, MOD_Y, C_LEFT, C_RIGHT, C_DOWN, C_UP,
+            SHIELD,
+        };
+        static const uint8_t left_stick_lut_rows[] PROGMEM = {
+            0, 0, 1, 1, 2, 2, 2, 2, 0, 0, 3, 3, 4, 4, 4, 4, 0, 0, 5, 5, 6, 6, 6, 6, 0, 0, 5, 5, 6,
+            6, 6, 6, 0, 0, 7, 7, 8, 8, 8, 8, 0, 0, 3, 3, 4, 4, 4, 4, 0, 0, 5, 5, 6, 6, 6, 6, 0, 0,
+            5, 5, 6, 6, 6, 6, 0, 0, 9, 9, 10, 10, 10, 10, 0, 0, 9, 9, 10, 10, 10, 10, 0, 0, 5, 5, 6,
+            6, 6, 6, 0, 0, 5, 5, 6, 6, 6, 6, 0, 0, 9, 9, 10, 10, 10, 10, 0, 0, 9, 9, 10, 10, 10, 10,
+            0, 0, 5, 5, 6, 6, 6, 6, 0, 0, 5, 5, 6, 6, 6, 6, 0, 0, 11, 11, 12, 13, 12, 13, 0, 0, 11,
+            11, 12, 13, 12, 13, 0, 0, 11, 11, 12, 13, 12, 13, 0, 0, 11, 11, 12, 13, 12, 13, 0, 0,
+            11, 11, 12, 13, 12, 13, 0, 0, 11, 11, 12, 13, 12, 13, 0, 0, 11, 11, 12, 13, 12, 13, 0,
+            0, 11, 11, 12, 13, 12, 13, 0, 0, 11, 11, 12, 13, 12, 13, 0, 0, 11, 11, 12, 13, 12, 13,
+            0, 0, 11, 11, 12, 13, 12, 13, 0, 0, 11, 11, 12, 13, 12, 13, 0, 0, 11, 11, 12, 13, 12,
+            13, 0, 0, 11, 11, 12, 13, 12, 13, 0, 0, 11, 11, 12, 13, 12, 13, 0, 0, 11, 11, 12, 13,
+            12, 13,
+        };
+        static const uint8_t left_stick_lut_cells[] PROGMEM = {
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 7, 7, 2, 2, 2, 2, 3,
+            11, 8, 8, 0, 0, 0, 0, 4, 4, 7, 7, 5, 5, 9, 9, 6, 12, 10, 10, 0, 0, 0, 0, 1, 1, 7, 7, 2,
+            2, 2, 2, 13, 15, 8, 8, 0, 0, 0, 0, 4, 4, 7, 7, 5, 5, 9, 9, 14, 16, 10, 10, 0, 0, 0, 0,
+            1, 1, 7, 7, 2, 2, 2, 2, 17, 19, 8, 8, 0, 0, 0, 0, 4, 4, 7, 7, 5, 5, 9, 9, 18, 20, 10,
+            10, 0, 0, 0, 0, 1, 1, 7, 7, 2, 2, 2, 2, 21, 23, 8, 8, 0, 0, 0, 0, 4, 4, 7, 7, 5, 5, 9,
+            9, 22, 24, 10, 10, 0, 0, 0, 0, 1, 1, 7, 7, 2, 2, 2, 2, 25, 27, 8, 8, 0, 0, 0, 0, 4, 4,
+            7, 7, 5, 5, 9, 9, 26, 28, 10, 10, 0, 0, 0, 0, 29, 29, 7, 7, 30, 30, 30, 30, 31, 31, 31,
+            31, 0, 0, 0, 0, 4, 4, 7, 7, 5, 5, 9, 9, 32, 32, 32, 32, 0, 0, 0, 0, 4, 4, 7, 7, 5, 5, 9,
+            9, 33, 33, 33, 33,
+        };
+        static const StickOutput left_stick_lut_outputs[] PROGMEM = {
+            { 0, SIGN_X | (SIGN_X << 4), 0, 0 },
+            { LEFT_X, SIGN_X | (SIGN_Y << 4), 53, 0 },
+            { LEFT_Y, SIGN_X | (SIGN_Y << 4), 0, 44 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 53, 35 },
+            { LEFT_X, SIGN_X | (SIGN_Y << 4), 41, 0 },
+            { LEFT_Y, SIGN_X | (SIGN_Y << 4), 0, 53 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 35, 53 },
+            { LEFT_X, SIGN_X | (SIGN_Y << 4), 36, 0 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 36, 26 },
+            { LEFT_Y, SIGN_X | (SIGN_Y << 4), 0, 36 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 34, 38 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 67, 44 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 44, 67 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 53, 39 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 49, 53 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 67, 49 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 49, 67 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 53, 28 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 28, 53 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 67, 35 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 35, 67 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 53, 43 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 43, 53 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 67, 55 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 55, 67 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 53, 31 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 31, 53 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 67, 39 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 39, 67 },
+            { LEFT_X, SIGN_X | (SIGN_Y << 4), 51, 0 },
+            { LEFT_Y, SIGN_X | (SIGN_Y << 4), 0, 51 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 51, 30 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 38, 70 },
+            { LEFT_X | LEFT_Y, SIGN_X | (SIGN_Y << 4), 40, 68 },
+        };
+        static const StickLut left_stick_lut PROGMEM = {
+            left_stick_lut_bits,
+            4,
+            8,
+            left_stick_lut_rows,
+            left_stick_lut_cells,
+            left_stick_lut_outputs,
+        };
+
+        // Right stick lookup table: 3 index bits (3 low, 0 high), 1 of 1 rows unique,
+        // 3 outputs, 33 bytes in total.
+        static const uint32_t right_stick_lut_bits[] PROGMEM = {
+            C_HORIZONTAL, C_VERTICAL, MOD_X,
+        };
+        static const uint8_t right_stick_lut_rows[] PROGMEM = {
+            0,
+        };
+        static const uint8_t right_stick_lut_cells[] PROGMEM = {
+            0, 0, 0, 1, 0, 2, 0, 1,
+        };
+        static const StickOutput right_stick_lut_outputs[] PROGMEM = {
+            { 0, SIGN_X | (SIGN_X << 4), 0, 0 },
+            { RIGHT_X | RIGHT_Y, SIGN_CX | (SIGN_CY << 4), 42, 68 },
+            { RIGHT_X | RIGHT_Y, SIGN_CX | (SIGN_Y << 4), 127, 59 },
+        };
+        static const StickLut right_stick_lut PROGMEM = {
+            right_stick_lut_bits,
+            3,
+            0,
+            right_stick_lut_rows,
+            right_stick_lut_cells,
+            right_stick_lut_outputs,
+        };
+    }
+}
+
+#endif
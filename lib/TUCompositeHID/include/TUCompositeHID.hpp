@@ -4,10 +4,59 @@
 #include <Adafruit_TinyUSB.h>
 #include <Arduino.h>
 
+#define HID_DESCRIPTOR_MAX_SIZE 1024U
+#define HID_REPORT_MAX_SIZE 64U
+
 namespace TUCompositeHID {
     extern Adafruit_USBD_HID _usb_hid;
 
-    bool addDescriptor(uint8_t *descriptor, size_t descriptor_len);
+    template <size_t Size> struct ReportDescriptor {
+        uint8_t data[Size];
+    };
+
+    // Concatenates report descriptors at compile time.
+    template <size_t... Sizes>
+    constexpr ReportDescriptor<(Sizes + ...)> combineDescriptors(const uint8_t (&...parts)[Sizes]) {
+        static_assert((Sizes + ...) <= HID_DESCRIPTOR_MAX_SIZE, "HID report descriptor too long");
+
+        ReportDescriptor<(Sizes + ...)> combined = {};
+        const uint8_t *part_data[] = { parts... };
+        const size_t part_sizes[] = { Sizes... };
+        size_t offset = 0;
+        for (size_t i = 0; i < sizeof...(Sizes); i++) {
+            for (size_t j = 0; j < part_sizes[i]; j++) {
+                combined.data[offset++] = part_data[i][j];
+            }
+        }
+        return combined;
+    }
+
+    // Report descriptor for a combination of devices, each of which has a static descriptor[].
+    // Being constexpr, this ends up in flash rather than being assembled in RAM on boot.
+    template <typename... Devices>
+    inline constexpr auto composite_descriptor = combineDescriptors(Devices::descriptor...);
+
+    void setDescriptor(const uint8_t *descriptor, size_t descriptor_len);
+
+    // Whether a report can be sent right now. If a queued report was waiting for the interface to
+    // be free, it gets sent first and this returns false, so devices that wait on ready() before
+    // every report take turns with it instead of holding it up.
+    bool ready();
+
+    // Sends a report straight away if the interface is free, and otherwise queues it to be sent by
+    // the next call to ready() that finds it free. Only one report is queued at a time, so a newer
+    // one replaces the last if it hasn't been sent yet.
+    void queueReport(uint8_t report_id, const void *report, uint8_t len);
+
+    // Uses the combined report descriptor of the given devices, e.g.
+    // TUCompositeHID::registerDescriptors<TUGamepad, TUKeyboard>(). Has to be called once, before
+    // the HID interface is started.
+    template <typename... Devices> void registerDescriptors() {
+        setDescriptor(
+            composite_descriptor<Devices...>.data,
+            sizeof(composite_descriptor<Devices...>.data)
+        );
+    }
 }
 
 #endif
\ No newline at end of file
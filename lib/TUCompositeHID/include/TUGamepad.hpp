@@ -28,6 +28,50 @@ SOFTWARE.
 #include <Arduino.h>
 #include <TUCompositeHID.hpp>
 
+// clang-format off
+
+#define TUGAMEPAD_REPORT_DESC(...) \
+    HID_USAGE_PAGE ( HID_USAGE_PAGE_DESKTOP     )                 ,\
+    HID_USAGE      ( HID_USAGE_DESKTOP_GAMEPAD  )                 ,\
+    HID_COLLECTION ( HID_COLLECTION_APPLICATION )                 ,\
+        /* Report ID if any */\
+        __VA_ARGS__ \
+        /* 16 bit X, Y, Z, Rz, Rx, Ry (min -32768 max 32767 ) */ \
+        HID_USAGE_PAGE     ( HID_USAGE_PAGE_DESKTOP                 ) ,\
+        HID_USAGE          ( HID_USAGE_DESKTOP_X                    ) ,\
+        HID_USAGE          ( HID_USAGE_DESKTOP_Y                    ) ,\
+        HID_USAGE          ( HID_USAGE_DESKTOP_Z                    ) ,\
+        HID_USAGE          ( HID_USAGE_DESKTOP_RZ                   ) ,\
+        HID_USAGE          ( HID_USAGE_DESKTOP_RX                   ) ,\
+        HID_USAGE          ( HID_USAGE_DESKTOP_RY                   ) ,\
+        HID_LOGICAL_MIN    ( 0                                      ) ,\
+        HID_LOGICAL_MAX_N  ( 0xffff, 3                              ) ,\
+        HID_REPORT_COUNT   ( 6                                      ) ,\
+        HID_REPORT_SIZE    ( 16                                     ) ,\
+        HID_INPUT          ( HID_DATA | HID_VARIABLE | HID_ABSOLUTE ) ,\
+        /* 8 bit DPad/Hat Button Map  */ \
+        HID_USAGE_PAGE     ( HID_USAGE_PAGE_DESKTOP                 ) ,\
+        HID_USAGE          ( HID_USAGE_DESKTOP_HAT_SWITCH           ) ,\
+        HID_LOGICAL_MIN    ( 1                                      ) ,\
+        HID_LOGICAL_MAX    ( 8                                      ) ,\
+        HID_PHYSICAL_MIN   ( 0                                      ) ,\
+        HID_PHYSICAL_MAX_N ( 315, 2                                 ) ,\
+        HID_REPORT_COUNT   ( 1                                      ) ,\
+        HID_REPORT_SIZE    ( 8                                      ) ,\
+        HID_INPUT          ( HID_DATA | HID_VARIABLE | HID_ABSOLUTE ) ,\
+        /* 16 bit Button Map */ \
+        HID_USAGE_PAGE     ( HID_USAGE_PAGE_BUTTON                  ) ,\
+        HID_USAGE_MIN      ( 1                                      ) ,\
+        HID_USAGE_MAX      ( 16                                     ) ,\
+        HID_LOGICAL_MIN    ( 0                                      ) ,\
+        HID_LOGICAL_MAX    ( 1                                      ) ,\
+        HID_REPORT_COUNT   ( 16                                     ) ,\
+        HID_REPORT_SIZE    ( 1                                      ) ,\
+        HID_INPUT          ( HID_DATA | HID_VARIABLE | HID_ABSOLUTE ) ,\
+    HID_COLLECTION_END
+
+// clang-format on
+
 typedef struct TU_ATTR_PACKED {
     uint16_t x;  // X value of left analog stick
     uint16_t y;  // Y value of left analog stick
@@ -41,9 +85,9 @@ typedef struct TU_ATTR_PACKED {
 
 class TUGamepad {
   public:
-    TUGamepad();
+    static const uint8_t descriptor[];
 
-    static void registerDescriptor();
+    TUGamepad();
 
     void begin();
     bool ready();
@@ -67,7 +111,6 @@ class TUGamepad {
 
   protected:
     static const uint8_t _report_id = 1;
-    static uint8_t _descriptor[];
 
     gamepad_report_t _report;
 
@@ -75,4 +118,8 @@ class TUGamepad {
     static hid_gamepad_hat_t getHatPosition(bool left, bool right, bool down, bool up);
 };
 
+inline constexpr uint8_t TUGamepad::descriptor[] = {
+    TUGAMEPAD_REPORT_DESC(HID_REPORT_ID(_report_id))
+};
+
 #endif
@@ -5,24 +5,86 @@
 #include <Arduino.h>
 #include <TUCompositeHID.hpp>
 
+// One bit for every keycode below the modifiers (0xE0).
+#define TUKEYBOARD_KEY_COUNT 224
+#define TUKEYBOARD_BITMAP_SIZE (TUKEYBOARD_KEY_COUNT / 8)
+
+// clang-format off
+
+#define TUKEYBOARD_REPORT_DESC(...) \
+    HID_USAGE_PAGE ( HID_USAGE_PAGE_DESKTOP     )                 ,\
+    HID_USAGE      ( HID_USAGE_DESKTOP_KEYBOARD )                 ,\
+    HID_COLLECTION ( HID_COLLECTION_APPLICATION )                 ,\
+        /* Report ID if any */\
+        __VA_ARGS__ \
+        /* 8 bit Modifier Keys (Shift, Control, Alt) */ \
+        HID_USAGE_PAGE     ( HID_USAGE_PAGE_KEYBOARD                ) ,\
+        HID_USAGE_MIN      ( 224                                    ) ,\
+        HID_USAGE_MAX      ( 231                                    ) ,\
+        HID_LOGICAL_MIN    ( 0                                      ) ,\
+        HID_LOGICAL_MAX    ( 1                                      ) ,\
+        HID_REPORT_COUNT   ( 8                                      ) ,\
+        HID_REPORT_SIZE    ( 1                                      ) ,\
+        HID_INPUT          ( HID_DATA | HID_VARIABLE | HID_ABSOLUTE ) ,\
+        /* Bitmap of all other keys */ \
+        HID_USAGE_PAGE     ( HID_USAGE_PAGE_KEYBOARD                ) ,\
+        HID_USAGE_MIN      ( 0                                      ) ,\
+        HID_USAGE_MAX      ( TUKEYBOARD_KEY_COUNT - 1               ) ,\
+        HID_LOGICAL_MIN    ( 0                                      ) ,\
+        HID_LOGICAL_MAX    ( 1                                      ) ,\
+        HID_REPORT_COUNT   ( TUKEYBOARD_KEY_COUNT                   ) ,\
+        HID_REPORT_SIZE    ( 1                                      ) ,\
+        HID_INPUT          ( HID_DATA | HID_VARIABLE | HID_ABSOLUTE ) ,\
+        /* 5 bit LED Indicator Kana | Compose | ScrollLock | CapsLock | NumLock */ \
+        HID_USAGE_PAGE     ( HID_USAGE_PAGE_LED                     ) ,\
+        HID_USAGE_MIN      ( 1                                      ) ,\
+        HID_USAGE_MAX      ( 5                                      ) ,\
+        HID_REPORT_COUNT   ( 5                                      ) ,\
+        HID_REPORT_SIZE    ( 1                                      ) ,\
+        HID_OUTPUT         ( HID_DATA | HID_VARIABLE | HID_ABSOLUTE ) ,\
+        /* led padding */ \
+        HID_REPORT_COUNT   ( 1                                      ) ,\
+        HID_REPORT_SIZE    ( 3                                      ) ,\
+        HID_OUTPUT         ( HID_CONSTANT                           ) ,\
+    HID_COLLECTION_END
+
+// clang-format on
+
+typedef struct TU_ATTR_PACKED {
+    uint8_t modifier;
+    uint8_t keys[TUKEYBOARD_BITMAP_SIZE];
+} nkro_keyboard_report_t;
+
+/*
+ * N-key rollover keyboard. Every key has its own bit in the report, so any number of keys can be
+ * held at once and pressing or releasing one is a single bit operation. The keyboard shares its HID
+ * interface with the gamepad, which isn't a boot interface, so hosts that only understand boot
+ * keyboards (e.g. a BIOS) won't see it.
+ */
 class TUKeyboard {
   public:
-    TUKeyboard();
+    static const uint8_t descriptor[];
 
-    static void registerDescriptor();
+    TUKeyboard();
 
     void begin();
     void setPressed(uint8_t keycode, bool pressed);
     void press(uint8_t keycode);
     void release(uint8_t keycode);
     void releaseAll();
+    // Only sends a report if any keys have changed since the last one that was sent. Doesn't wait
+    // for the interface to be free (see TUCompositeHID::queueReport()).
     void sendState();
 
   private:
     static const uint8_t _report_id = 2;
-    static uint8_t _descriptor[];
 
-    hid_keyboard_report_t _report;
+    nkro_keyboard_report_t _report;
+    nkro_keyboard_report_t _sent_report;
+};
+
+inline constexpr uint8_t TUKeyboard::descriptor[] = {
+    TUKEYBOARD_REPORT_DESC(HID_REPORT_ID(_report_id))
 };
 
 #endif
\ No newline at end of file
@@ -2,31 +2,41 @@
 
 #include <Adafruit_TinyUSB.h>
 
-#define HID_DESCRIPTOR_BUFSIZE 1024U
-
 namespace TUCompositeHID {
-    uint8_t _hid_report_desc[HID_DESCRIPTOR_BUFSIZE] = {};
-    size_t _current_descriptor_len = 0;
+    // The report descriptor is set by registerDescriptors() before the interface is started.
+    Adafruit_USBD_HID _usb_hid = Adafruit_USBD_HID(nullptr, 0, HID_ITF_PROTOCOL_NONE, 1, false);
+
+    uint8_t _queued_report[HID_REPORT_MAX_SIZE];
+    uint8_t _queued_report_id = 0;
+    uint8_t _queued_report_len = 0;
+    bool _report_queued = false;
 
-    Adafruit_USBD_HID _usb_hid = Adafruit_USBD_HID(
-        _hid_report_desc,
-        _current_descriptor_len,
-        HID_ITF_PROTOCOL_NONE,
-        1,
-        false
-    );
+    void setDescriptor(const uint8_t *descriptor, size_t descriptor_len) {
+        _usb_hid.setReportDescriptor(descriptor, descriptor_len);
+    }
 
-    bool addDescriptor(uint8_t *descriptor, size_t descriptor_len) {
-        if (_current_descriptor_len + descriptor_len > HID_DESCRIPTOR_BUFSIZE) {
+    bool ready() {
+        if (!_usb_hid.ready()) {
             return false;
         }
-        for (size_t i = 0; i < descriptor_len; i++) {
-            _hid_report_desc[_current_descriptor_len + i] = descriptor[i];
+        if (_report_queued) {
+            _report_queued =
+                !_usb_hid.sendReport(_queued_report_id, _queued_report, _queued_report_len);
+            return false;
         }
-        _current_descriptor_len += descriptor_len;
-
-        _usb_hid.setReportDescriptor(_hid_report_desc, _current_descriptor_len);
-
         return true;
     }
+
+    void queueReport(uint8_t report_id, const void *report, uint8_t len) {
+        if (!_report_queued && _usb_hid.ready() && _usb_hid.sendReport(report_id, report, len)) {
+            return;
+        }
+        if (len > sizeof(_queued_report)) {
+            len = sizeof(_queued_report);
+        }
+        memcpy(_queued_report, report, len);
+        _queued_report_id = report_id;
+        _queued_report_len = len;
+        _report_queued = true;
+    }
 }
@@ -27,58 +27,8 @@ SOFTWARE.
 #include <Arduino.h>
 #include <TUCompositeHID.hpp>
 
-// clang-format off
-
-#define HID_REPORT_DESC(...) \
-    HID_USAGE_PAGE ( HID_USAGE_PAGE_DESKTOP     )                 ,\
-    HID_USAGE      ( HID_USAGE_DESKTOP_GAMEPAD  )                 ,\
-    HID_COLLECTION ( HID_COLLECTION_APPLICATION )                 ,\
-        /* Report ID if any */\
-        __VA_ARGS__ \
-        /* 16 bit X, Y, Z, Rz, Rx, Ry (min -32768 max 32767 ) */ \
-        HID_USAGE_PAGE     ( HID_USAGE_PAGE_DESKTOP                 ) ,\
-        HID_USAGE          ( HID_USAGE_DESKTOP_X                    ) ,\
-        HID_USAGE          ( HID_USAGE_DESKTOP_Y                    ) ,\
-        HID_USAGE          ( HID_USAGE_DESKTOP_Z                    ) ,\
-        HID_USAGE          ( HID_USAGE_DESKTOP_RZ                   ) ,\
-        HID_USAGE          ( HID_USAGE_DESKTOP_RX                   ) ,\
-        HID_USAGE          ( HID_USAGE_DESKTOP_RY                   ) ,\
-        HID_LOGICAL_MIN    ( 0                                      ) ,\
-        HID_LOGICAL_MAX_N  ( 0xffff, 3                              ) ,\
-        HID_REPORT_COUNT   ( 6                                      ) ,\
-        HID_REPORT_SIZE    ( 16                                     ) ,\
-        HID_INPUT          ( HID_DATA | HID_VARIABLE | HID_ABSOLUTE ) ,\
-        /* 8 bit DPad/Hat Button Map  */ \
-        HID_USAGE_PAGE     ( HID_USAGE_PAGE_DESKTOP                 ) ,\
-        HID_USAGE          ( HID_USAGE_DESKTOP_HAT_SWITCH           ) ,\
-        HID_LOGICAL_MIN    ( 1                                      ) ,\
-        HID_LOGICAL_MAX    ( 8                                      ) ,\
-        HID_PHYSICAL_MIN   ( 0                                      ) ,\
-        HID_PHYSICAL_MAX_N ( 315, 2                                 ) ,\
-        HID_REPORT_COUNT   ( 1                                      ) ,\
-        HID_REPORT_SIZE    ( 8                                      ) ,\
-        HID_INPUT          ( HID_DATA | HID_VARIABLE | HID_ABSOLUTE ) ,\
-        /* 16 bit Button Map */ \
-        HID_USAGE_PAGE     ( HID_USAGE_PAGE_BUTTON                  ) ,\
-        HID_USAGE_MIN      ( 1                                      ) ,\
-        HID_USAGE_MAX      ( 16                                     ) ,\
-        HID_LOGICAL_MIN    ( 0                                      ) ,\
-        HID_LOGICAL_MAX    ( 1                                      ) ,\
-        HID_REPORT_COUNT   ( 16                                     ) ,\
-        HID_REPORT_SIZE    ( 1                                      ) ,\
-        HID_INPUT          ( HID_DATA | HID_VARIABLE | HID_ABSOLUTE ) ,\
-    HID_COLLECTION_END
-
-// clang-format on
-
-uint8_t TUGamepad::_descriptor[] = { HID_REPORT_DESC(HID_REPORT_ID(_report_id)) };
-
 TUGamepad::TUGamepad() {}
 
-void TUGamepad::registerDescriptor() {
-    TUCompositeHID::addDescriptor(_descriptor, sizeof(_descriptor));
-}
-
 void TUGamepad::begin() {
     TUCompositeHID::_usb_hid.begin();
 
@@ -87,7 +37,7 @@ void TUGamepad::begin() {
 }
 
 bool TUGamepad::ready() {
-    return TUCompositeHID::_usb_hid.ready();
+    return TUCompositeHID::ready();
 };
 
 bool TUGamepad::sendState() {
@@ -3,19 +3,15 @@
 #include <Adafruit_TinyUSB.h>
 #include <TUCompositeHID.hpp>
 
-uint8_t TUKeyboard::_descriptor[] = { TUD_HID_REPORT_DESC_KEYBOARD(HID_REPORT_ID(_report_id)) };
-
 #define MODIFIER_MASK(mod_kc) (1 << (mod_kc & 0x0F))
 
 TUKeyboard::TUKeyboard() {}
 
-void TUKeyboard::registerDescriptor() {
-    TUCompositeHID::addDescriptor(_descriptor, sizeof(_descriptor));
-}
-
 void TUKeyboard::begin() {
     TUCompositeHID::_usb_hid.begin();
     releaseAll();
+    // The host starts off assuming that no keys are pressed.
+    _sent_report = _report;
 }
 
 void TUKeyboard::press(uint8_t keycode) {
@@ -23,26 +19,10 @@ void TUKeyboard::press(uint8_t keycode) {
     if (keycode >= 0xE0) {
         // Create bitmask from the modifier keycode to set the corresponding bit in the modifier
         // byte.
-        uint8_t bitmask = MODIFIER_MASK(keycode);
-        _report.modifier |= bitmask;
+        _report.modifier |= MODIFIER_MASK(keycode);
         return;
     }
-
-    // Check if the key is already pressed so that we don't send the same keycode multiple times in
-    // the same report.
-    for (int i = 0; i < 6; i++) {
-        if (_report.keycode[i] == keycode) {
-            return;
-        }
-    }
-
-    // Place this keycode in the report in place of the first empty keycode.
-    for (int i = 0; i < 6; i++) {
-        if (_report.keycode[i] == HID_KEY_NONE) {
-            _report.keycode[i] = keycode;
-            return;
-        }
-    }
+    _report.keys[keycode >> 3] |= 1 << (keycode & 7);
 }
 
 void TUKeyboard::release(uint8_t keycode) {
@@ -50,17 +30,10 @@ void TUKeyboard::release(uint8_t keycode) {
     if (keycode >= 0xE0) {
         // Create bitmask from the modifier keycode to unset the corresponding bit in the modifier
         // byte.
-        uint8_t bitmask = ~MODIFIER_MASK(keycode);
-        _report.modifier &= bitmask;
+        _report.modifier &= ~MODIFIER_MASK(keycode);
         return;
     }
-
-    // Loop through keycodes in report. If we find the specified key code, we clear it.
-    for (int i = 0; i < 6; i++) {
-        if (_report.keycode[i] == keycode) {
-            _report.keycode[i] = HID_KEY_NONE;
-        }
-    }
+    _report.keys[keycode >> 3] &= ~(1 << (keycode & 7));
 }
 
 void TUKeyboard::setPressed(uint8_t keycode, bool pressed) {
@@ -72,15 +45,16 @@ void TUKeyboard::setPressed(uint8_t keycode, bool pressed) {
 }
 
 void TUKeyboard::releaseAll() {
-    for (int i = 0; i < 6; i++) {
-        _report.keycode[i] = 0;
-    }
-    _report.modifier = 0;
+    memset(&_report, 0, sizeof(_report));
 }
 
 void TUKeyboard::sendState() {
-    while (!TUCompositeHID::_usb_hid.ready()) {
-        tight_loop_contents();
+    if (memcmp(&_report, &_sent_report, sizeof(_report)) == 0) {
+        return;
     }
-    TUCompositeHID::_usb_hid.sendReport(_report_id, &_report, sizeof(hid_keyboard_report_t));
+
+    // Queued rather than waiting for the interface, so the keyboard doesn't hold up the gamepad
+    // and vice versa.
+    TUCompositeHID::queueReport(_report_id, &_report, sizeof(_report));
+    _sent_report = _report;
 }
\ No newline at end of file
@@ -0,0 +1,36 @@
+#include "comms/gc_adapter.hpp"
+
+#include "core/state.hpp"
+#include "stdlib.hpp"
+
+namespace gc_adapter {
+    void encode_report(const OutputState &outputs, uint8_t port, uint8_t *report) {
+        memset(report, 0, GC_ADAPTER_REPORT_SIZE);
+        report[0] = INPUT_REPORT;
+
+        uint8_t *state = report + 1 + port * GC_ADAPTER_PORT_SIZE;
+        state[0] = PORT_WIRED;
+        state[1] = (outputs.a ? BUTTON_A : 0) | (outputs.b ? BUTTON_B : 0) |
+                   (outputs.x ? BUTTON_X : 0) | (outputs.y ? BUTTON_Y : 0) |
+                   (outputs.dpadLeft || outputs.select ? DPAD_LEFT : 0) |
+                   (outputs.dpadRight || outputs.home ? DPAD_RIGHT : 0) |
+                   (outputs.dpadDown ? DPAD_DOWN : 0) | (outputs.dpadUp ? DPAD_UP : 0);
+        state[2] = (outputs.start ? BUTTON_START : 0) | (outputs.buttonR ? BUTTON_Z : 0) |
+                   (outputs.triggerRDigital ? BUTTON_R : 0) |
+                   (outputs.triggerLDigital ? BUTTON_L : 0);
+        state[3] = outputs.leftStickX;
+        state[4] = outputs.leftStickY;
+        state[5] = outputs.rightStickX;
+        state[6] = outputs.rightStickY;
+        state[7] = outputs.triggerLAnalog;
+        state[8] = outputs.triggerRAnalog;
+    }
+
+    bool decode_rumble(const uint8_t *command, size_t len, uint8_t port, bool &rumble) {
+        if (len < GC_ADAPTER_RUMBLE_SIZE || command[0] != RUMBLE) {
+            return false;
+        }
+        rumble = command[1 + port] & 0x01;
+        return true;
+    }
+}
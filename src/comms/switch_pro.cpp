@@ -0,0 +1,273 @@
+#include "comms/switch_pro.hpp"
+
+#include "core/state.hpp"
+#include "stdlib.hpp"
+
+// Offset of the ACK byte in a subcommand reply, after the timer, connection info, inputs and
+// vibrator report.
+#define SUBCOMMAND_REPLY_HEADER_SIZE (3 + SWITCH_PRO_INPUTS_SIZE + 1)
+// Offset of the subcommand ID in a subcommand, after the packet number and rumble data.
+#define SUBCOMMAND_OFFSET 10
+
+// Full battery, charging, Pro Controller powered over USB.
+#define CONNECTION_INFO 0x91
+#define VIBRATOR_REPORT 0x0C
+
+// Center of a 12-bit stick axis.
+#define STICK_CENTER 0x800
+// Distance from the center to a full press in the stick calibration, which is the same amount of
+// scaling that NintendoSwitchBackend applies to its 8-bit sticks.
+#define STICK_RANGE_X 0x652
+#define STICK_RANGE_Y 0x65F
+
+// A pair of 12-bit X and Y values, packed into 3 bytes like the Pro Controller does.
+#define STICK_PAIR(x, y) (x) & 0xFF, ((x) >> 8) | (((y) & 0xF) << 4), (y) >> 4
+
+namespace switch_pro {
+    static const uint8_t mac_address[] = { 0x98, 0xB6, 0xE9, 0x48, 0x42, 0x01 };
+
+    typedef struct {
+        uint16_t address;
+        uint8_t length;
+        const uint8_t *data;
+    } SpiRegion;
+
+    // Accelerometer and gyro origins and sensitivity.
+    static const uint8_t spi_imu_calibration[] PROGMEM = {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x40, 0x00, 0x40,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3B, 0x34, 0x3B, 0x34, 0x3B, 0x34,
+    };
+
+    // Left stick: maximum above center, center, minimum below center. Right stick: center,
+    // minimum below center, maximum above center.
+    static const uint8_t spi_stick_calibration[] PROGMEM = {
+        STICK_PAIR(STICK_RANGE_X, STICK_RANGE_Y),
+        STICK_PAIR(STICK_CENTER, STICK_CENTER),
+        STICK_PAIR(STICK_RANGE_X, STICK_RANGE_Y),
+        STICK_PAIR(STICK_CENTER, STICK_CENTER),
+        STICK_PAIR(STICK_RANGE_X, STICK_RANGE_Y),
+        STICK_PAIR(STICK_RANGE_X, STICK_RANGE_Y),
+    };
+
+    // Body, buttons, left grip and right grip colours.
+    static const uint8_t spi_colors[] PROGMEM = {
+        0x32, 0x32, 0x32, 0xFF, 0xFF, 0xFF, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+    };
+
+    // Sensor parameters, then left and right stick parameters (dead zone and range ratio), the
+    // same as a real Pro Controller.
+    static const uint8_t spi_device_parameters[] PROGMEM = {
+        0x50, 0xFD, 0x00, 0x00, 0xC6, 0x0F, 0x0F, 0x30, 0x61, 0x96, 0x30, 0xF3,
+        0xD4, 0x14, 0x54, 0x41, 0x15, 0x54, 0xC7, 0x79, 0x9C, 0x33, 0x36, 0x63,
+        0x0F, 0x30, 0x61, 0x96, 0x30, 0xF3, 0xD4, 0x14, 0x54, 0x41, 0x15, 0x54,
+        0xC7, 0x79, 0x9C, 0x33, 0x36, 0x63,
+    };
+
+    // Everything else, including the user calibration, is left erased.
+    static const SpiRegion spi_regions[] = {
+        { 0x6020, sizeof(spi_imu_calibration), spi_imu_calibration },
+        { 0x603D, sizeof(spi_stick_calibration), spi_stick_calibration },
+        { 0x6050, sizeof(spi_colors), spi_colors },
+        { 0x6080, sizeof(spi_device_parameters), spi_device_parameters },
+    };
+
+    // Reply to SET_MCU_CONFIG, as sent by a real Pro Controller (the last byte is a CRC).
+    static const uint8_t mcu_config_reply[] PROGMEM = {
+        0x01, 0x00, 0xFF, 0x00, 0x03, 0x00, 0x05, 0x01, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5C,
+    };
+
+    static uint16_t stick_axis(uint8_t value) {
+        return STICK_CENTER + (value - 128) * 16;
+    }
+
+    static void encode_stick(uint8_t x, uint8_t y, uint8_t *stick) {
+        uint16_t x12 = stick_axis(x);
+        uint16_t y12 = stick_axis(y);
+        stick[0] = x12 & 0xFF;
+        stick[1] = (x12 >> 8) | ((y12 & 0xF) << 4);
+        stick[2] = y12 >> 4;
+    }
+
+    void encode_inputs(const OutputState &outputs, uint8_t *inputs) {
+        inputs[0] = (outputs.y ? 0x01 : 0) | (outputs.x ? 0x02 : 0) | (outputs.b ? 0x04 : 0) |
+                    (outputs.a ? 0x08 : 0) | (outputs.triggerRDigital ? 0x40 : 0) |
+                    (outputs.buttonR ? 0x80 : 0);
+        inputs[1] = (outputs.select ? 0x01 : 0) | (outputs.start ? 0x02 : 0) |
+                    (outputs.rightStickClick ? 0x04 : 0) | (outputs.leftStickClick ? 0x08 : 0) |
+                    (outputs.home ? 0x10 : 0);
+        inputs[2] = (outputs.dpadDown ? 0x01 : 0) | (outputs.dpadUp ? 0x02 : 0) |
+                    (outputs.dpadRight ? 0x04 : 0) | (outputs.dpadLeft ? 0x08 : 0) |
+                    (outputs.triggerLDigital ? 0x40 : 0) | (outputs.buttonL ? 0x80 : 0);
+        encode_stick(outputs.leftStickX, outputs.leftStickY, inputs + 3);
+        encode_stick(outputs.rightStickX, outputs.rightStickY, inputs + 6);
+    }
+
+    uint8_t spi_read(uint32_t address) {
+        for (size_t i = 0; i < sizeof(spi_regions) / sizeof(spi_regions[0]); i++) {
+            const SpiRegion &region = spi_regions[i];
+            if (address >= region.address && address < region.address + region.length) {
+                return pgm_read_byte(region.data + (address - region.address));
+            }
+        }
+        return 0xFF;
+    }
+
+    void Protocol::HandleOutputReport(const uint8_t *report, size_t len) {
+        if (len < 2) {
+            return;
+        }
+        switch (report[0]) {
+            case USB_COMMAND:
+                HandleUsbCommand(report, len);
+                break;
+            case RUMBLE_AND_SUBCOMMAND:
+                HandleSubcommand(report, len);
+                break;
+            default:
+                // Nothing to do for rumble, as there's nothing to rumble.
+                break;
+        }
+    }
+
+    void Protocol::HandleUsbCommand(const uint8_t *report, size_t len) {
+        memset(_reply, 0, sizeof(_reply));
+        _reply[0] = report[1];
+
+        switch (report[1]) {
+            case USB_STATUS:
+                // Controller type, followed by the MAC address in reverse.
+                _reply[2] = 0x03;
+                for (size_t i = 0; i < sizeof(mac_address); i++) {
+                    _reply[3 + i] = mac_address[sizeof(mac_address) - 1 - i];
+                }
+                break;
+            case USB_HANDSHAKE:
+            case USB_BAUDRATE:
+                break;
+            case USB_HID_ONLY:
+                // No reply, the host just starts getting full input reports.
+                _streaming = true;
+                return;
+            case USB_ENABLE_TIMEOUT:
+                _streaming = false;
+                return;
+            default:
+                return;
+        }
+        SendReply(USB_REPLY);
+    }
+
+    void Protocol::HandleSubcommand(const uint8_t *report, size_t len) {
+        if (len <= SUBCOMMAND_OFFSET) {
+            return;
+        }
+        uint8_t subcommand = report[SUBCOMMAND_OFFSET];
+        const uint8_t *args = report + SUBCOMMAND_OFFSET + 1;
+        size_t args_len = len - SUBCOMMAND_OFFSET - 1;
+
+        uint8_t *data;
+        switch (subcommand) {
+            case BLUETOOTH_PAIRING:
+                data = StartSubcommandReply(0x81, subcommand);
+                data[0] = 0x03;
+                break;
+            case DEVICE_INFO:
+                // Firmware version, Pro Controller, MAC address, and use the colours in SPI flash.
+                data = StartSubcommandReply(0x82, subcommand);
+                data[0] = 0x03;
+                data[1] = 0x48;
+                data[2] = 0x03;
+                data[3] = 0x02;
+                memcpy(data + 4, mac_address, sizeof(mac_address));
+                data[10] = 0x01;
+                data[11] = 0x01;
+                break;
+            case TRIGGER_ELAPSED_TIME:
+                StartSubcommandReply(0x83, subcommand);
+                break;
+            case SPI_READ: {
+                if (args_len < 5) {
+                    return;
+                }
+                uint32_t address = args[0] | (args[1] << 8) | ((uint32_t)args[2] << 16) |
+                                   ((uint32_t)args[3] << 24);
+                uint8_t size = args[4];
+                // Whatever is left of the report after the address and size.
+                size_t max_size = SWITCH_PRO_REPORT_SIZE - SUBCOMMAND_REPLY_HEADER_SIZE - 2 - 5;
+                if (size > max_size) {
+                    size = max_size;
+                }
+
+                data = StartSubcommandReply(0x90, subcommand);
+                memcpy(data, args, 5);
+                data[4] = size;
+                for (uint8_t i = 0; i < size; i++) {
+                    data[5 + i] = spi_read(address + i);
+                }
+                break;
+            }
+            case SET_MCU_CONFIG:
+                data = StartSubcommandReply(0xA0, subcommand);
+                memcpy_P(data, mcu_config_reply, sizeof(mcu_config_reply));
+                break;
+            default:
+                // Report mode, lights, IMU, vibration etc. only need acknowledging.
+                StartSubcommandReply(0x80, subcommand);
+                break;
+        }
+        SendReply(SUBCOMMAND_REPLY);
+    }
+
+    uint8_t *Protocol::StartSubcommandReply(uint8_t ack, uint8_t subcommand) {
+        memset(_reply, 0, sizeof(_reply));
+        _reply[0] = ack;
+        _reply[1] = subcommand;
+        return _reply + 2;
+    }
+
+    void Protocol::SendReply(uint8_t report_id) {
+        _reply_id = report_id;
+        _reply_pending = true;
+    }
+
+    size_t Protocol::NextInputReport(const OutputState &outputs, uint8_t *report) {
+        memset(report, 0, SWITCH_PRO_REPORT_SIZE);
+
+        if (_reply_pending && _reply_id == USB_REPLY) {
+            report[0] = USB_REPLY;
+            memcpy(report + 1, _reply, SWITCH_PRO_REPORT_SIZE - 1);
+            _reply_pending = false;
+            return SWITCH_PRO_REPORT_SIZE;
+        }
+
+        if (!_reply_pending && !_streaming) {
+            return 0;
+        }
+
+        // Subcommand replies and full input reports both start with the input state.
+        report[1] = _timer++;
+        report[2] = CONNECTION_INFO;
+        encode_inputs(outputs, report + 3);
+        report[3 + SWITCH_PRO_INPUTS_SIZE] = VIBRATOR_REPORT;
+
+        if (_reply_pending) {
+            report[0] = SUBCOMMAND_REPLY;
+            memcpy(
+                report + SUBCOMMAND_REPLY_HEADER_SIZE,
+                _reply,
+                SWITCH_PRO_REPORT_SIZE - SUBCOMMAND_REPLY_HEADER_SIZE
+            );
+            _reply_pending = false;
+        } else {
+            // The IMU data that follows is left at zero.
+            report[0] = FULL_INPUT;
+        }
+        return SWITCH_PRO_REPORT_SIZE;
+    }
+
+    bool Protocol::Streaming() {
+        return _streaming;
+    }
+}
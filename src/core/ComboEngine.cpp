@@ -0,0 +1,47 @@
+#include "core/ComboEngine.hpp"
+
+#include "core/state.hpp"
+
+bool ComboEngine::Update(const InputState &inputs, CommunicationBackend *backend) {
+    uint32_t buttons = pack_buttons(inputs);
+
+    uint32_t held = 0;
+    for (size_t i = 0; i < _combo_count; i++) {
+        uint32_t mask = pgm_read_dword(&_combos[i].mask);
+        uint32_t match = pgm_read_dword(&_combos[i].match);
+        held |= (uint32_t)((buttons & mask) == match) << i;
+    }
+
+    uint16_t now = millis();
+    uint32_t pressed = held & ~_held;
+    _held = held;
+    _fired &= held;
+
+    uint32_t waiting = held & ~_fired;
+    for (size_t i = 0; waiting != 0; i++) {
+        uint32_t bit = 1UL << i;
+        if (!(waiting & bit)) {
+            continue;
+        }
+        waiting &= ~bit;
+
+        if (pressed & bit) {
+            _held_since[i] = now;
+        }
+
+        combo::Combo combo;
+        memcpy_P(&combo, &_combos[i], sizeof(combo));
+        if ((uint16_t)(now - _held_since[i]) < combo.hold_ms) {
+            continue;
+        }
+
+        // Anything else held now counts as fired, so the first combo listed takes priority.
+        _fired = held;
+        if (combo.action != nullptr) {
+            combo.action(backend);
+        }
+        return true;
+    }
+
+    return false;
+}
@@ -1,13 +1,31 @@
 #include "core/CommunicationBackend.hpp"
 
 #include "core/ControllerMode.hpp"
+#include "core/InputRecorder.hpp"
 #include "core/InputSource.hpp"
 #include "core/state.hpp"
+#include "stdlib.hpp"
+
+// Moves a running average an eighth of the way to a new sample, so that one slow scan (e.g. one
+// that got interrupted) doesn't count for much.
+static void update_average_x8(uint16_t &average_x8, uint32_t sample_us) {
+    int32_t sample_x8 = sample_us > UINT16_MAX / 8 ? UINT16_MAX : sample_us * 8;
+    average_x8 += (sample_x8 - (int32_t)average_x8) / 8;
+}
 
 CommunicationBackend::CommunicationBackend(InputSource **input_sources, size_t input_source_count) {
     _gamemode = nullptr;
     _input_sources = input_sources;
-    _input_source_count = input_source_count;
+
+    // Anything beyond the maximum wouldn't fit in the scan lists. Configs get the count from
+    // input_source_count_of(), which refuses to build with too many, so this is only a backstop.
+    _input_source_count =
+        input_source_count > MAX_INPUT_SOURCES ? MAX_INPUT_SOURCES : input_source_count;
+
+    for (size_t i = 0; i < _input_source_count; i++) {
+        size_t speed = (size_t)_input_sources[i]->ScanSpeed();
+        _scan_lists[speed][_scan_list_lengths[speed]++] = i;
+    }
 }
 
 InputState &CommunicationBackend::GetInputs() {
@@ -21,12 +39,91 @@ void CommunicationBackend::ScanInputs() {
 }
 
 void CommunicationBackend::ScanInputs(InputScanSpeed input_source_filter) {
-    for (size_t i = 0; i < _input_source_count; i++) {
-        InputSource *input_source = _input_sources[i];
-        if (input_source->ScanSpeed() == input_source_filter) {
-            input_source->UpdateInputs(_inputs);
+    if (input_source_filter == InputScanSpeed::SLOW && _slow_scan_interval_ms > 0) {
+        uint32_t now = millis();
+        if (_slow_scanned && now - _last_slow_scan < _slow_scan_interval_ms) {
+            return;
         }
+        _last_slow_scan = now;
+        _slow_scanned = true;
     }
+
+    size_t speed = (size_t)input_source_filter;
+
+    // Only time the sources when something is going to use it, as this happens while we're
+    // responding to a poll.
+    if (input_source_filter != InputScanSpeed::FAST || _fast_scan_budget_us == 0) {
+        for (size_t i = 0; i < _scan_list_lengths[speed]; i++) {
+            _input_sources[_scan_lists[speed][i]]->UpdateInputs(_inputs);
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < _scan_list_lengths[speed]; i++) {
+        uint8_t index = _scan_lists[speed][i];
+
+        uint32_t scan_start = micros();
+        _input_sources[index]->UpdateInputs(_inputs);
+        update_average_x8(_scan_costs_x8[index], micros() - scan_start);
+    }
+    DemoteOverBudgetSources();
+}
+
+void CommunicationBackend::SetSlowScanInterval(uint32_t interval_ms) {
+    _slow_scan_interval_ms = interval_ms;
+    _slow_scanned = false;
+}
+
+void CommunicationBackend::SetFastScanBudget(uint32_t budget_us) {
+    _fast_scan_budget_us = budget_us;
+}
+
+uint32_t CommunicationBackend::GetScanCost(size_t input_source_index) {
+    if (input_source_index >= _input_source_count) {
+        return 0;
+    }
+    return _scan_costs_x8[input_source_index] / 8;
+}
+
+void CommunicationBackend::SampleInputs(uint32_t duration_us) {
+#ifndef HAYBOX_PRESS_TIMES
+    // Scanning in the meantime only helps press times, so just wait.
+    delayMicroseconds(duration_us);
+#else
+    uint32_t start = micros();
+
+    // Only start another scan if it will finish in time, going by how long they usually take.
+    uint32_t now = start;
+    while (now - start + _fast_scan_cost_x8 / 8 < duration_us) {
+        ScanInputs(InputScanSpeed::FAST);
+        uint32_t scan_end = micros();
+        update_average_x8(_fast_scan_cost_x8, scan_end - now);
+        now = scan_end;
+    }
+
+    uint32_t elapsed = micros() - start;
+    if (elapsed < duration_us) {
+        delayMicroseconds(duration_us - elapsed);
+    }
+#endif
+}
+
+void CommunicationBackend::DemoteOverBudgetSources() {
+    uint8_t *fast_list = _scan_lists[(size_t)InputScanSpeed::FAST];
+    uint8_t &fast_count = _scan_list_lengths[(size_t)InputScanSpeed::FAST];
+    uint8_t *medium_list = _scan_lists[(size_t)InputScanSpeed::MEDIUM];
+    uint8_t &medium_count = _scan_list_lengths[(size_t)InputScanSpeed::MEDIUM];
+
+    size_t kept = 0;
+    for (size_t i = 0; i < fast_count; i++) {
+        uint8_t index = fast_list[i];
+        if (_scan_costs_x8[index] / 8 > _fast_scan_budget_us) {
+            medium_list[medium_count++] = index;
+        } else {
+            fast_list[kept++] = index;
+        }
+    }
+    fast_count = kept;
 }
 
 void CommunicationBackend::ResetOutputs() {
@@ -34,6 +131,11 @@ void CommunicationBackend::ResetOutputs() {
 }
 
 void CommunicationBackend::UpdateOutputs() {
+    uint32_t now = micros();
+    _frame_clock.Update(now);
+    if (_input_recorder != nullptr) {
+        _input_recorder->Capture(_inputs, now);
+    }
     ResetOutputs();
     if (_gamemode != nullptr) {
         _gamemode->UpdateOutputs(_inputs, _outputs);
@@ -43,4 +145,40 @@ void CommunicationBackend::UpdateOutputs() {
 void CommunicationBackend::SetGameMode(ControllerMode *gamemode) {
     delete _gamemode;
     _gamemode = gamemode;
+    if (_gamemode != nullptr) {
+        _gamemode->SetFrameClock(&_frame_clock);
+    }
+}
+
+FrameClock &CommunicationBackend::GetFrameClock() {
+    return _frame_clock;
+}
+
+void CommunicationBackend::SetInputRecorder(InputRecorder *recorder) {
+    _input_recorder = recorder;
+}
+
+uint32_t CommunicationBackend::TimeToFirstReport() {
+    return _first_report_us;
+}
+
+bool CommunicationBackend::CanStall(uint32_t duration_us) {
+    return true;
+}
+
+void CommunicationBackend::ReportSent() {
+    if (_first_report_us == 0) {
+        // Can't be 0, because that means no report has been sent.
+        uint32_t now = micros();
+        _first_report_us = now > 0 ? now : 1;
+    }
+}
+
+bool CommunicationBackend::SkipUnlessReady(bool ready) {
+    if (ready) {
+        return false;
+    }
+    ScanInputs(InputScanSpeed::FAST);
+    UpdateOutputs();
+    return true;
 }
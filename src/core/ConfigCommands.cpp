@@ -0,0 +1,221 @@
+#include "core/ConfigCommands.hpp"
+
+#include "core/CommunicationBackend.hpp"
+#include "core/ConfigProtocol.hpp"
+#include "core/InputRecorder.hpp"
+#include "core/Profile.hpp"
+#include "stdlib.hpp"
+
+using namespace config_protocol;
+
+static void put_u16(uint8_t *bytes, uint16_t value) {
+    bytes[0] = value;
+    bytes[1] = value >> 8;
+}
+
+static void put_u32(uint8_t *bytes, uint32_t value) {
+    put_u16(bytes, value);
+    put_u16(bytes + 2, value >> 16);
+}
+
+static uint16_t get_u16(const uint8_t *bytes) {
+    return bytes[0] | (bytes[1] << 8);
+}
+
+ConfigCommands::ConfigCommands(
+    CommunicationBackend *backend,
+    InputRecorder *recorder,
+    bool (*select_mode)(CommunicationBackend *backend, uint16_t mode),
+    uint16_t mode_count
+) {
+    _backend = backend;
+    _recorder = recorder;
+    _select_mode = select_mode;
+    _mode_count = mode_count;
+}
+
+void ConfigCommands::SetProfileStorage(
+    const uint8_t *profile,
+    size_t max_size,
+    uint32_t usable_pins,
+    void (*write_profile)(const uint8_t *data, size_t len),
+    uint32_t write_time_us
+) {
+    _profile = profile;
+    _profile_max_size = max_size;
+    _profile_pins = usable_pins;
+    _write_profile = write_profile;
+    _profile_write_time_us = write_time_us;
+}
+
+void ConfigCommands::SetConsoleDetection(
+    uint32_t first_reply_us,
+    uint32_t finished_us,
+    bool remembered
+) {
+    _console_first_reply_us = first_reply_us;
+    _console_finished_us = finished_us;
+    _console_remembered = remembered;
+}
+
+void ConfigCommands::Update() {
+    // Between reports like a mode selected with a button combo, rather than inside the protocol's
+    // slice.
+    if (_mode_pending) {
+        _select_mode(_backend, _pending_mode);
+        _mode_pending = false;
+    }
+
+    if (_profile_save_length > 0 && _backend->CanStall(_profile_write_time_us)) {
+        _write_profile(_profile_buffer, _profile_save_length);
+        _profile_save_length = 0;
+    }
+}
+
+uint8_t ConfigCommands::Handle(
+    uint8_t command,
+    const uint8_t *payload,
+    uint8_t length,
+    uint8_t *reply,
+    uint8_t &reply_length
+) {
+    switch (command) {
+        case GET_STATS:
+            return GetStats(reply, reply_length);
+        case SET_MODE:
+            if (length != 2) {
+                return BAD_REQUEST;
+            }
+            if (get_u16(payload) >= _mode_count) {
+                return INVALID;
+            }
+            _pending_mode = get_u16(payload);
+            _mode_pending = true;
+            return OK;
+        case READ_PROFILE:
+            return ReadProfile(payload, length, reply, reply_length);
+        case WRITE_PROFILE:
+            return WriteProfile(payload, length);
+        case SAVE_PROFILE:
+            return SaveProfile(payload, length);
+        case DUMP_INPUTS:
+            return StartDump(reply, reply_length);
+        default:
+            return UNKNOWN_COMMAND;
+    }
+}
+
+uint8_t ConfigCommands::Continue(uint8_t command, uint8_t *reply, uint8_t &reply_length) {
+    if (command != DUMP_INPUTS) {
+        return OK;
+    }
+
+    reply_length = 0;
+    size_t count = _recorder->Count();
+    for (size_t i = 0; i < CONFIG_DUMP_RECORDS_PER_REPLY && _dump_next < count; i++) {
+        InputRecorder::Encode(_recorder->Get(_dump_next++), reply + reply_length);
+        reply_length += INPUT_CAPTURE_RECORD_SIZE;
+    }
+    if (reply_length > 0) {
+        return MORE;
+    }
+
+    _backend->SetInputRecorder(_recorder);
+    return OK;
+}
+
+void ConfigCommands::Abort(uint8_t command) {
+    // Recording was only paused for the dump.
+    if (command == DUMP_INPUTS) {
+        _backend->SetInputRecorder(_recorder);
+    }
+}
+
+uint8_t ConfigCommands::GetStats(uint8_t *reply, uint8_t &reply_length) {
+    FrameClock::Stats frame_clock = _backend->GetFrameClock().GetStats();
+    put_u32(reply, _backend->TimeToFirstReport());
+    put_u32(reply + 4, _console_first_reply_us);
+    put_u32(reply + 8, _console_finished_us);
+    reply[12] = (_console_remembered ? CONFIG_STATS_CONSOLE_REMEMBERED : 0) |
+                (frame_clock.locked ? CONFIG_STATS_FRAME_CLOCK_LOCKED : 0) |
+                (_profile_save_length > 0 ? CONFIG_STATS_PROFILE_SAVE_PENDING : 0);
+#ifdef HAYBOX_PRESS_TIMES
+    reply[12] |= CONFIG_STATS_PRESS_TIMES;
+#endif
+    put_u32(reply + 13, frame_clock.boundaries);
+    put_u16(reply + 17, frame_clock.average_error_us);
+    put_u16(reply + 19, frame_clock.max_error_us);
+    reply_length = 21;
+    return OK;
+}
+
+uint8_t ConfigCommands::ReadProfile(
+    const uint8_t *payload,
+    uint8_t length,
+    uint8_t *reply,
+    uint8_t &reply_length
+) {
+    if (_profile == nullptr) {
+        return UNSUPPORTED;
+    }
+    if (length != 3) {
+        return BAD_REQUEST;
+    }
+    size_t offset = get_u16(payload);
+    size_t read_length = payload[2];
+    if (read_length > CONFIG_MAX_PAYLOAD || offset + read_length > _profile_max_size) {
+        return BAD_REQUEST;
+    }
+    memcpy(reply, _profile + offset, read_length);
+    reply_length = read_length;
+    return OK;
+}
+
+uint8_t ConfigCommands::WriteProfile(const uint8_t *payload, uint8_t length) {
+    if (_profile == nullptr) {
+        return UNSUPPORTED;
+    }
+    if (length < 2) {
+        return BAD_REQUEST;
+    }
+    size_t offset = get_u16(payload);
+    size_t data_length = length - 2;
+    if (offset + data_length > CONFIG_PROFILE_BUFFER_SIZE) {
+        return BAD_REQUEST;
+    }
+    // Not while the buffer is still waiting to be saved.
+    if (_profile_save_length > 0) {
+        return INVALID;
+    }
+    memcpy(_profile_buffer + offset, payload + 2, data_length);
+    return OK;
+}
+
+uint8_t ConfigCommands::SaveProfile(const uint8_t *payload, uint8_t length) {
+    if (_profile == nullptr) {
+        return UNSUPPORTED;
+    }
+    if (length != 2) {
+        return BAD_REQUEST;
+    }
+    size_t save_length = get_u16(payload);
+    Profile profile;
+    if (save_length > CONFIG_PROFILE_BUFFER_SIZE || save_length > _profile_max_size ||
+        !profile.Open(_profile_buffer, save_length, _profile_pins)) {
+        return INVALID;
+    }
+    _profile_save_length = save_length;
+    return OK;
+}
+
+uint8_t ConfigCommands::StartDump(uint8_t *reply, uint8_t &reply_length) {
+    if (_recorder == nullptr) {
+        return UNSUPPORTED;
+    }
+    // Nothing new gets recorded until the dump is done, so the records stay where they are.
+    _backend->SetInputRecorder(nullptr);
+    _recorder->EncodeHeader(reply);
+    reply_length = INPUT_CAPTURE_HEADER_SIZE;
+    _dump_next = 0;
+    return MORE;
+}
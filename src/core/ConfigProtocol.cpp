@@ -0,0 +1,191 @@
+#include "core/ConfigProtocol.hpp"
+
+#include "serial.hpp"
+#include "stdlib.hpp"
+
+using namespace config_protocol;
+
+// CRC-8 with polynomial 0x07.
+static uint8_t crc8(uint8_t crc, const uint8_t *data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = crc & 0x80 ? (crc << 1) ^ 0x07 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+ConfigProtocol::ConfigProtocol(ConfigHandler &handler) : _handler(handler) {}
+
+void ConfigProtocol::Service() {
+    uint32_t start_us = micros();
+
+    Flush();
+    if (_continuing) {
+        Continue(start_us);
+    } else {
+        Receive(start_us);
+    }
+
+    uint32_t slice_us = micros() - start_us;
+    if (slice_us > _longest_slice_us) {
+        _longest_slice_us = slice_us;
+    }
+}
+
+uint32_t ConfigProtocol::LongestSliceUs() {
+    return _longest_slice_us;
+}
+
+void ConfigProtocol::Flush() {
+    size_t written = 0;
+    while (_tx_count > 0) {
+        // Only whole frames, so that nothing else writing to the port can end up in the middle.
+        size_t frame_length = CONFIG_REPLY_OVERHEAD + TxByte(3);
+        if (written + frame_length > CONFIG_TX_BYTES_PER_SLICE ||
+            serial::available_for_write() < (int)frame_length) {
+            return;
+        }
+
+        uint8_t frame[CONFIG_REPLY_OVERHEAD + CONFIG_MAX_PAYLOAD];
+        for (size_t i = 0; i < frame_length; i++) {
+            frame[i] = TxByte(i);
+        }
+        serial::write(frame, frame_length);
+
+        _tx_start = (_tx_start + frame_length) % CONFIG_TX_BUFFER_SIZE;
+        _tx_count -= frame_length;
+        written += frame_length;
+    }
+}
+
+void ConfigProtocol::Continue(uint32_t now_us) {
+    // Nothing is sent while the replies are still coming, so a sync byte is the start of a new
+    // request. Keep it as such.
+    for (size_t i = 0; i < CONFIG_RX_BYTES_PER_SLICE && serial::available() > 0; i++) {
+        if (serial::read() == CONFIG_REQUEST_SYNC) {
+            Abort();
+            _request[0] = CONFIG_REQUEST_SYNC;
+            _request_length = 1;
+            _last_receive_us = now_us;
+            return;
+        }
+    }
+
+    if (!RoomForReply()) {
+        if (now_us - _last_reply_us > CONFIG_CONTINUE_TIMEOUT_US) {
+            Abort();
+        }
+        return;
+    }
+
+    uint8_t reply[CONFIG_MAX_PAYLOAD];
+    uint8_t reply_length = 0;
+    uint8_t status = _handler.Continue(_continue_command, reply, reply_length);
+    _continuing = status == MORE;
+    _last_reply_us = now_us;
+    Reply(_continue_command, status, reply, reply_length);
+}
+
+void ConfigProtocol::Abort() {
+    _handler.Abort(_continue_command);
+    _continuing = false;
+    // Only whole frames are ever left in the buffer, and nobody is waiting for these any more.
+    _tx_start = 0;
+    _tx_count = 0;
+}
+
+void ConfigProtocol::Receive(uint32_t now_us) {
+    if (_request_length > 0 && now_us - _last_receive_us > CONFIG_REQUEST_TIMEOUT_US) {
+        _request_length = 0;
+    }
+
+    for (size_t i = 0; i < CONFIG_RX_BYTES_PER_SLICE && serial::available() > 0; i++) {
+        // Don't take in another request until there's room to reply to this one.
+        if (_request_length == 0 && !RoomForReply()) {
+            return;
+        }
+
+        uint8_t byte = serial::read();
+        _last_receive_us = now_us;
+        if (_request_length == 0 && byte != CONFIG_REQUEST_SYNC) {
+            continue;
+        }
+        _request[_request_length++] = byte;
+
+        if (_request_length >= 3 && _request[2] > CONFIG_MAX_PAYLOAD) {
+            Reply(_request[1], BAD_REQUEST, nullptr, 0);
+            _request_length = 0;
+        } else if (_request_length >= 3 &&
+                   _request_length == CONFIG_REQUEST_OVERHEAD + (size_t)_request[2]) {
+            HandleRequest(now_us);
+            _request_length = 0;
+            // One request per slice.
+            return;
+        }
+    }
+}
+
+void ConfigProtocol::HandleRequest(uint32_t now_us) {
+    uint8_t command = _request[1];
+    uint8_t length = _request[2];
+    const uint8_t *payload = _request + 3;
+    if (crc8(0, _request + 1, length + 2) != _request[3 + length]) {
+        Reply(command, BAD_CHECKSUM, nullptr, 0);
+        return;
+    }
+
+    uint8_t reply[CONFIG_MAX_PAYLOAD];
+    uint8_t reply_length = 0;
+    uint8_t status;
+    if (command == INFO) {
+        uint16_t longest_slice_us = _longest_slice_us > UINT16_MAX ? UINT16_MAX
+                                                                    : _longest_slice_us;
+        reply[0] = CONFIG_PROTOCOL_VERSION;
+        reply[1] = CONFIG_MAX_PAYLOAD;
+        reply[2] = longest_slice_us;
+        reply[3] = longest_slice_us >> 8;
+        reply_length = 4;
+        status = OK;
+    } else {
+        status = _handler.Handle(command, payload, length, reply, reply_length);
+    }
+
+    _continuing = status == MORE;
+    _continue_command = command;
+    _last_reply_us = now_us;
+    Reply(command, status, reply, reply_length);
+}
+
+bool ConfigProtocol::RoomForReply() {
+    return CONFIG_TX_BUFFER_SIZE - _tx_count >= CONFIG_REPLY_OVERHEAD + CONFIG_MAX_PAYLOAD;
+}
+
+void ConfigProtocol::Reply(
+    uint8_t command,
+    uint8_t status,
+    const uint8_t *payload,
+    uint8_t length
+) {
+    uint8_t header[] = { command, status, length };
+    uint8_t crc = crc8(crc8(0, header, sizeof(header)), payload, length);
+
+    PushByte(CONFIG_REPLY_SYNC);
+    for (size_t i = 0; i < sizeof(header); i++) {
+        PushByte(header[i]);
+    }
+    for (size_t i = 0; i < length; i++) {
+        PushByte(payload[i]);
+    }
+    PushByte(crc);
+}
+
+void ConfigProtocol::PushByte(uint8_t byte) {
+    _tx[(_tx_start + _tx_count) % CONFIG_TX_BUFFER_SIZE] = byte;
+    _tx_count++;
+}
+
+uint8_t ConfigProtocol::TxByte(size_t index) {
+    return _tx[(_tx_start + index) % CONFIG_TX_BUFFER_SIZE];
+}
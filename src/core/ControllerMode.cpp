@@ -6,9 +6,28 @@ ControllerMode::ControllerMode() {
 }
 
 void ControllerMode::UpdateOutputs(InputState &inputs, OutputState &outputs) {
-    HandleSocd(inputs);
-    UpdateDigitalOutputs(inputs, outputs);
-    UpdateAnalogOutputs(inputs, outputs);
+    UpdateOutputsWith(*this, inputs, outputs);
+}
+
+void ControllerMode::SetFrameClock(const FrameClock *frame_clock) {
+    _frame_clock = frame_clock;
+    _last_frame_boundary = Frame();
+}
+
+uint32_t ControllerMode::Frame() {
+    return _frame_clock != nullptr ? _frame_clock->Frame() : 0;
+}
+
+uint32_t ControllerMode::FramesSince(uint32_t frame) {
+    return Frame() - frame;
+}
+
+bool ControllerMode::NextFrameBoundary(uint32_t &frame) {
+    if (_last_frame_boundary == Frame()) {
+        return false;
+    }
+    frame = ++_last_frame_boundary;
+    return true;
 }
 
 void ControllerMode::ResetDirections() {
@@ -87,3 +106,84 @@ void ControllerMode::UpdateDirections(
         }
     }
 }
+
+uint32_t ControllerMode::StickConditions(const InputState &inputs) {
+    using namespace stick_rules;
+
+    return (directions.horizontal ? HORIZONTAL : 0) | (directions.vertical ? VERTICAL : 0) |
+           (directions.diagonal ? DIAGONAL : 0) | (directions.x == -1 ? X_NEGATIVE : 0) |
+           (directions.y == -1 ? Y_NEGATIVE : 0) | (directions.cx != 0 ? C_HORIZONTAL : 0) |
+           (directions.cy != 0 ? C_VERTICAL : 0) | (directions.cy == -1 ? C_Y_NEGATIVE : 0) |
+           (inputs.mod_x ? MOD_X : 0) | (inputs.mod_y ? MOD_Y : 0) | (inputs.a ? A : 0) |
+           (inputs.b ? B : 0) | (inputs.z ? Z : 0) | (inputs.r ? R : 0) |
+           (inputs.down ? DOWN : 0) | (inputs.c_left ? C_LEFT : 0) |
+           (inputs.c_right ? C_RIGHT : 0) | (inputs.c_down ? C_DOWN : 0) |
+           (inputs.c_up ? C_UP : 0);
+}
+
+void ControllerMode::ApplyStickRules(
+    const stick_rules::StickRule *rules,
+    size_t rule_count,
+    uint32_t conditions,
+    uint8_t analogStickNeutral,
+    OutputState &outputs
+) {
+    for (size_t i = 0; i < rule_count; i++) {
+        stick_rules::StickRule rule;
+        memcpy_P(&rule, &rules[i], sizeof(rule));
+        if ((conditions & rule.mask) == rule.match) {
+            ApplyStickOutput(rule.output, analogStickNeutral, outputs);
+        }
+    }
+}
+
+void ControllerMode::ApplyStickLut(
+    const stick_rules::StickLut *lut_P,
+    uint32_t conditions,
+    uint8_t analogStickNeutral,
+    OutputState &outputs
+) {
+    stick_rules::StickLut lut;
+    memcpy_P(&lut, lut_P, sizeof(lut));
+
+    // Same number of steps whichever conditions are set, so the time taken doesn't depend on the
+    // inputs being held.
+    uint16_t index = 0;
+    for (uint8_t i = 0; i < lut.low_bit_count + lut.high_bit_count; i++) {
+        index |= (uint16_t)((conditions & pgm_read_dword(&lut.index_bits[i])) != 0) << i;
+    }
+
+    uint16_t low_mask = (1 << lut.low_bit_count) - 1;
+    uint16_t row = pgm_read_byte(&lut.rows[index >> lut.low_bit_count]);
+    uint8_t cell = pgm_read_byte(&lut.cells[(row << lut.low_bit_count) | (index & low_mask)]);
+
+    stick_rules::StickOutput output;
+    memcpy_P(&output, &lut.outputs[cell], sizeof(output));
+    ApplyStickOutput(output, analogStickNeutral, outputs);
+}
+
+void ControllerMode::ApplyStickOutput(
+    const stick_rules::StickOutput &output,
+    uint8_t analogStickNeutral,
+    OutputState &outputs
+) {
+    using namespace stick_rules;
+
+    // Indexed by stick_rules::Sign.
+    const int8_t signs[] = { directions.x, directions.y, directions.cx, directions.cy, 1 };
+
+    uint8_t x = analogStickNeutral + signs[output.signs & 0x0F] * output.x;
+    uint8_t y = analogStickNeutral + signs[output.signs >> 4] * output.y;
+    if (output.targets & LEFT_X) {
+        outputs.leftStickX = x;
+    }
+    if (output.targets & LEFT_Y) {
+        outputs.leftStickY = y;
+    }
+    if (output.targets & RIGHT_X) {
+        outputs.rightStickX = x;
+    }
+    if (output.targets & RIGHT_Y) {
+        outputs.rightStickY = y;
+    }
+}
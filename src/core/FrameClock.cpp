@@ -0,0 +1,121 @@
+#include "core/FrameClock.hpp"
+
+#include "stdlib.hpp"
+
+// Number of consecutive boundaries close to the prediction before the estimate counts as locked.
+static constexpr uint8_t frame_lock_threshold = 8;
+
+FrameClock::FrameClock(uint32_t frame_period_us) {
+    SetFramePeriod(frame_period_us);
+}
+
+void FrameClock::SetFramePeriod(uint32_t frame_period_us) {
+    _nominal_period_us = frame_period_us;
+    _period_us = frame_period_us;
+    _consistent_boundaries = 0;
+}
+
+void FrameClock::Poll(uint32_t now_us) {
+    uint32_t gap = now_us - _last_poll_us;
+    bool first_poll = !_polled;
+    _last_poll_us = now_us;
+    _polled = true;
+
+    // Any poll shortly after another one is part of the same burst, so it says nothing new.
+    if (!first_poll && gap < _period_us / 2) {
+        return;
+    }
+
+    Update(now_us);
+    _boundaries++;
+
+    // How far this boundary is from the nearest predicted one. Negative means it came early.
+    uint32_t since_boundary = now_us - (_next_boundary_us - _period_us);
+    int32_t error = since_boundary > _period_us / 2 ? (int32_t)(since_boundary - _period_us)
+                                                    : (int32_t)since_boundary;
+    uint32_t abs_error = error < 0 ? -error : error;
+
+    // Way off means the game changed how it polls or we lost track, so start over from here.
+    if (first_poll || abs_error > _period_us / 4) {
+        Restart(now_us);
+        return;
+    }
+
+    // Nudge the phase a quarter of the way there, so that jitter in any one poll mostly averages
+    // out, and the period by a 32nd of the error, within 2% of nominal.
+    _next_boundary_us += error / 4;
+    int32_t period = (int32_t)_period_us + error / 32;
+    int32_t max_drift = _nominal_period_us / 50;
+    if (period > (int32_t)_nominal_period_us + max_drift) {
+        period = _nominal_period_us + max_drift;
+    } else if (period < (int32_t)_nominal_period_us - max_drift) {
+        period = _nominal_period_us - max_drift;
+    }
+    _period_us = period;
+
+    if (abs_error > _period_us / 8) {
+        _consistent_boundaries = 0;
+        return;
+    }
+    if (_consistent_boundaries < frame_lock_threshold) {
+        _consistent_boundaries++;
+        return;
+    }
+
+    if (abs_error > UINT16_MAX) {
+        abs_error = UINT16_MAX;
+    }
+    if (_average_error_x16 == 0) {
+        _average_error_x16 = abs_error << 4;
+    } else {
+        _average_error_x16 = _average_error_x16 - (_average_error_x16 >> 4) + abs_error;
+    }
+    if (abs_error > _max_error_us) {
+        _max_error_us = abs_error;
+    }
+}
+
+void FrameClock::Update(uint32_t now_us) {
+    if (!_started) {
+        _next_boundary_us = now_us + _period_us;
+        _started = true;
+        return;
+    }
+
+    // Usually at most one boundary goes by between reports.
+    while ((int32_t)(now_us - _next_boundary_us) >= 0) {
+        _next_boundary_us += _period_us;
+        _frame++;
+    }
+}
+
+uint32_t FrameClock::Frame() const {
+    return _frame;
+}
+
+uint32_t FrameClock::FramesSince(uint32_t frame) const {
+    return _frame - frame;
+}
+
+uint32_t FrameClock::FramePeriodUs() const {
+    return _period_us;
+}
+
+FrameClock::Stats FrameClock::GetStats() const {
+    return Stats{
+        .locked = _consistent_boundaries >= frame_lock_threshold,
+        .boundaries = _boundaries,
+        .average_error_us = (uint16_t)(_average_error_x16 >> 4),
+        .max_error_us = _max_error_us,
+    };
+}
+
+void FrameClock::Restart(uint32_t boundary_us) {
+    // The current frame starts now, but keeps its number so that frame counts never go backwards.
+    _period_us = _nominal_period_us;
+    _next_boundary_us = boundary_us + _period_us;
+    _consistent_boundaries = 0;
+    _boundaries = 1;
+    _average_error_x16 = 0;
+    _max_error_us = 0;
+}
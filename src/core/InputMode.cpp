@@ -5,50 +5,106 @@
 
 InputMode::InputMode() {}
 
-InputMode::~InputMode() {
-    delete[] _socd_pairs;
-    delete[] _socd_states;
+InputMode::~InputMode() {}
+
+void InputMode::SetSocdPairs(const socd::SocdPair *socd_pairs, size_t count) {
+    if (count > MAX_SOCD_PAIRS) {
+        count = MAX_SOCD_PAIRS;
+    }
+    for (size_t i = 0; i < count; i++) {
+        _socd_pairs[i] = socd_pairs[i];
+    }
+    _socd_pair_count = count;
+    UpdateSocdStages();
 }
 
 void InputMode::HandleSocd(InputState &inputs) {
-    if (_socd_pairs == nullptr) {
+    if (_socd_stage_count == 0) {
         return;
     }
 
-    // Initialize SOCD states if they aren't initialized.
-    if (_socd_states == nullptr) {
-        _socd_states = new socd::SocdState[_socd_pair_count];
+    uint32_t buttons = pack_buttons(inputs);
+    uint32_t original_buttons = buttons;
+
+    for (size_t stage = 0; stage < _socd_stage_count; stage++) {
+        const socd::PairMasks &masks = _socd_stages[stage];
+
+        socd::PairMask input_dir1 = 0;
+        socd::PairMask input_dir2 = 0;
+        socd::PairMask dir1_newer = 0;
+        socd::PairMask dir2_newer = 0;
+        for (size_t i = 0; i < _socd_pair_count; i++) {
+            input_dir1 |= ((buttons >> _socd_dir1_bits[i]) & 1) << i;
+            input_dir2 |= ((buttons >> _socd_dir2_bits[i]) & 1) << i;
+#ifdef HAYBOX_PRESS_TIMES
+            if (masks.second_input_priority_timestamp & (1 << i)) {
+                uint32_t dir1_time = inputs.press_times[_socd_dir1_bits[i]];
+                uint32_t dir2_time = inputs.press_times[_socd_dir2_bits[i]];
+                int32_t dir1_newer_by = (int32_t)(dir1_time - dir2_time);
+                dir1_newer |= (dir1_newer_by > 0) << i;
+                dir2_newer |= (dir1_newer_by < 0) << i;
+            }
+#endif
+        }
+
+        socd::resolve(input_dir1, input_dir2, dir1_newer, dir2_newer, masks, _socd_states);
+
+        socd::PairMask resolved = socd::pairs(masks);
+        for (size_t i = 0; i < _socd_pair_count; i++) {
+            if (resolved & (1 << i)) {
+                buttons &= ~((1UL << _socd_dir1_bits[i]) | (1UL << _socd_dir2_bits[i]));
+                buttons |= (uint32_t)((input_dir1 >> i) & 1) << _socd_dir1_bits[i];
+                buttons |= (uint32_t)((input_dir2 >> i) & 1) << _socd_dir2_bits[i];
+            }
+        }
+    }
+
+    // Only write back the buttons that SOCD resolution actually changed.
+    bool *input_buttons = &inputs.left;
+    uint32_t changed = buttons ^ original_buttons;
+    for (size_t i = 0; changed != 0; i++, changed >>= 1) {
+        if (changed & 1) {
+            input_buttons[i] = (buttons >> i) & 1;
+        }
     }
+}
+
+void InputMode::UpdateSocdStages() {
+    size_t pair_stages[MAX_SOCD_PAIRS];
+    // Only needed to find where each button is within InputState.
+    InputState inputs;
+    _socd_stage_count = 0;
+    _socd_states = socd::PairStates();
 
-    // Handle SOCD resolution for each SOCD button pair.
     for (size_t i = 0; i < _socd_pair_count; i++) {
-        socd::SocdPair pair = _socd_pairs[i];
-        switch (pair.socd_type) {
-            case socd::SOCD_NEUTRAL:
-                socd::neutral(inputs.*(pair.input_dir1), inputs.*(pair.input_dir2));
-                break;
-            case socd::SOCD_2IP:
-                socd::second_input_priority(
-                    inputs.*(pair.input_dir1),
-                    inputs.*(pair.input_dir2),
-                    _socd_states[i]
-                );
-                break;
-            case socd::SOCD_2IP_NO_REAC:
-                socd::second_input_priority_no_reactivation(
-                    inputs.*(pair.input_dir1),
-                    inputs.*(pair.input_dir2),
-                    _socd_states[i]
-                );
-                break;
-            case socd::SOCD_DIR1_PRIORITY:
-                socd::dir1_priority(inputs.*(pair.input_dir1), inputs.*(pair.input_dir2));
-                break;
-            case socd::SOCD_DIR2_PRIORITY:
-                socd::dir1_priority(inputs.*(pair.input_dir2), inputs.*(pair.input_dir1));
-                break;
-            case socd::SOCD_NONE:
-                break;
+        const socd::SocdPair &pair = _socd_pairs[i];
+        _socd_dir1_bits[i] = button_index(inputs, pair.input_dir1);
+        _socd_dir2_bits[i] = button_index(inputs, pair.input_dir2);
+        if (pair.socd_type == socd::SOCD_NONE) {
+            // Never changes anything, so there's no need to resolve it at all.
+            continue;
+        }
+
+        // Go after every earlier pair that this one shares a button with.
+        size_t stage = 0;
+        for (size_t j = 0; j < i; j++) {
+            const socd::SocdPair &other = _socd_pairs[j];
+            if (other.socd_type == socd::SOCD_NONE) {
+                continue;
+            }
+            if (pair.input_dir1 == other.input_dir1 || pair.input_dir1 == other.input_dir2 ||
+                pair.input_dir2 == other.input_dir1 || pair.input_dir2 == other.input_dir2) {
+                if (pair_stages[j] + 1 > stage) {
+                    stage = pair_stages[j] + 1;
+                }
+            }
+        }
+        pair_stages[i] = stage;
+
+        if (stage == _socd_stage_count) {
+            _socd_stages[stage] = socd::PairMasks();
+            _socd_stage_count++;
         }
+        socd::add_pair(_socd_stages[stage], i, pair.socd_type);
     }
 }
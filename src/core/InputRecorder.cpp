@@ -0,0 +1,116 @@
+#include "core/InputRecorder.hpp"
+
+#include "core/state.hpp"
+#include "stdlib.hpp"
+
+static uint32_t pack_inputs(const InputState &inputs) {
+    return pack_buttons(inputs) | (inputs.nunchuk_connected ? CAPTURE_NUNCHUK_CONNECTED : 0) |
+           (inputs.nunchuk_c ? CAPTURE_NUNCHUK_C : 0) | (inputs.nunchuk_z ? CAPTURE_NUNCHUK_Z : 0);
+}
+
+static void put_u16(uint8_t *bytes, uint16_t value) {
+    bytes[0] = value;
+    bytes[1] = value >> 8;
+}
+
+static void put_u32(uint8_t *bytes, uint32_t value) {
+    put_u16(bytes, value);
+    put_u16(bytes + 2, value >> 16);
+}
+
+static uint16_t get_u16(const uint8_t *bytes) {
+    return bytes[0] | (bytes[1] << 8);
+}
+
+static uint32_t get_u32(const uint8_t *bytes) {
+    return get_u16(bytes) | ((uint32_t)get_u16(bytes + 2) << 16);
+}
+
+void InputRecorder::Capture(const InputState &inputs, uint32_t now_us) {
+    uint32_t buttons = pack_inputs(inputs);
+
+    if (_count > 0) {
+        Record &last = _buffer[(_next + _capacity - 1) % _capacity];
+        if (last.buttons == buttons && last.nunchuk_x == inputs.nunchuk_x &&
+            last.nunchuk_y == inputs.nunchuk_y && last.reports < UINT16_MAX) {
+            last.reports++;
+            return;
+        }
+    }
+
+    _buffer[_next] = Record{ now_us, buttons, inputs.nunchuk_x, inputs.nunchuk_y, 1 };
+    _next = (_next + 1) % _capacity;
+    if (_count < _capacity) {
+        _count++;
+    }
+}
+
+void InputRecorder::Clear() {
+    _next = 0;
+    _count = 0;
+}
+
+size_t InputRecorder::Count() {
+    return _count;
+}
+
+const InputRecorder::Record &InputRecorder::Get(size_t index) {
+    return _buffer[(_next + _capacity - _count + index) % _capacity];
+}
+
+void InputRecorder::Dump(void (*write)(uint8_t *bytes, size_t len)) {
+    uint8_t header[INPUT_CAPTURE_HEADER_SIZE];
+    EncodeHeader(header);
+    write(header, sizeof(header));
+
+    uint8_t bytes[INPUT_CAPTURE_RECORD_SIZE];
+    for (size_t i = 0; i < _count; i++) {
+        Encode(Get(i), bytes);
+        write(bytes, sizeof(bytes));
+    }
+}
+
+void InputRecorder::EncodeHeader(uint8_t *bytes) {
+    memset(bytes, 0, INPUT_CAPTURE_HEADER_SIZE);
+    memcpy(bytes, INPUT_CAPTURE_MAGIC, 4);
+    bytes[4] = INPUT_CAPTURE_VERSION;
+    bytes[5] = INPUT_CAPTURE_RECORD_SIZE;
+    put_u32(bytes + 8, _count);
+}
+
+void InputRecorder::Encode(const Record &record, uint8_t *bytes) {
+    put_u32(bytes, record.time_us);
+    put_u32(bytes + 4, record.buttons);
+    bytes[8] = record.nunchuk_x;
+    bytes[9] = record.nunchuk_y;
+    put_u16(bytes + 10, record.reports);
+}
+
+InputRecorder::Record InputRecorder::Decode(const uint8_t *bytes) {
+    return Record{
+        get_u32(bytes),
+        get_u32(bytes + 4),
+        (int8_t)bytes[8],
+        (int8_t)bytes[9],
+        get_u16(bytes + 10),
+    };
+}
+
+void InputRecorder::Restore(const Record &record, InputState &inputs) {
+    bool *buttons = &inputs.left;
+    for (size_t i = 0; i < RECTANGLE_INPUT_COUNT; i++) {
+        bool pressed = record.buttons & (1UL << i);
+#ifdef HAYBOX_PRESS_TIMES
+        if (pressed && !buttons[i]) {
+            inputs.press_times[i] = record.time_us;
+        }
+#endif
+        buttons[i] = pressed;
+    }
+
+    inputs.nunchuk_connected = record.buttons & CAPTURE_NUNCHUK_CONNECTED;
+    inputs.nunchuk_c = record.buttons & CAPTURE_NUNCHUK_C;
+    inputs.nunchuk_z = record.buttons & CAPTURE_NUNCHUK_Z;
+    inputs.nunchuk_x = record.nunchuk_x;
+    inputs.nunchuk_y = record.nunchuk_y;
+}
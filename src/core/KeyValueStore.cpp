@@ -0,0 +1,167 @@
+#include "core/KeyValueStore.hpp"
+
+#include "stdlib.hpp"
+#include "storage.hpp"
+
+#define KV_MAGIC_0 'K'
+#define KV_MAGIC_1 'V'
+#define KV_CHECK 0xA5
+
+// Compact once there's less than a quarter of the bank left.
+#define KV_COMPACT_THRESHOLD (STORAGE_BANK_SIZE / 4)
+
+static bool read_header(uint8_t bank, uint16_t &sequence) {
+    if (storage::read(bank, 0) != KV_MAGIC_0 || storage::read(bank, 1) != KV_MAGIC_1) {
+        return false;
+    }
+    sequence = storage::read(bank, 2) | (storage::read(bank, 3) << 8);
+    return true;
+}
+
+static uint8_t check_byte(uint8_t key, uint16_t value) {
+    return key ^ (value & 0xFF) ^ (value >> 8) ^ KV_CHECK;
+}
+
+void KeyValueStore::Load() {
+    _stored = 0;
+    _dirty = 0;
+    _bank = -1;
+    _end = 0;
+
+    // The newest bank is the one with the later sequence number, allowing for it wrapping around.
+    uint16_t sequences[2];
+    bool valid[2] = { read_header(0, sequences[0]), read_header(1, sequences[1]) };
+    if (valid[0] && valid[1]) {
+        _bank = (int16_t)(sequences[1] - sequences[0]) > 0 ? 1 : 0;
+    } else if (valid[0] || valid[1]) {
+        _bank = valid[0] ? 0 : 1;
+    } else {
+        return;
+    }
+    _sequence = sequences[_bank];
+
+    // Records end at the first one that's still erased. Any that fail the check were cut short by
+    // a power loss and are skipped.
+    size_t offset = KV_HEADER_SIZE;
+    for (; offset + KV_RECORD_SIZE <= STORAGE_BANK_SIZE; offset += KV_RECORD_SIZE) {
+        uint8_t record[KV_RECORD_SIZE];
+        bool erased = true;
+        for (size_t i = 0; i < KV_RECORD_SIZE; i++) {
+            record[i] = storage::read(_bank, offset + i);
+            erased &= record[i] == 0xFF;
+        }
+        if (erased) {
+            break;
+        }
+
+        uint8_t key = record[0];
+        uint16_t value = record[1] | (record[2] << 8);
+        if (key < KV_MAX_KEYS && record[3] == check_byte(key, value)) {
+            _values[key] = value;
+            _stored |= 1 << key;
+        }
+    }
+    _end = offset;
+}
+
+void KeyValueStore::Compact() {
+    if (_bank < 0 || STORAGE_BANK_SIZE - _end < KV_COMPACT_THRESHOLD) {
+        MoveToOtherBank();
+    }
+}
+
+bool KeyValueStore::Get(uint8_t key, uint16_t &value) {
+    if (key >= KV_MAX_KEYS || !(_stored & (1 << key))) {
+        return false;
+    }
+    value = _values[key];
+    return true;
+}
+
+void KeyValueStore::Set(uint8_t key, uint16_t value) {
+    if (key >= KV_MAX_KEYS || ((_stored & (1 << key)) && _values[key] == value)) {
+        return;
+    }
+    _values[key] = value;
+    _stored |= 1 << key;
+    _dirty |= 1 << key;
+}
+
+bool KeyValueStore::Pending() {
+    return _dirty != 0;
+}
+
+uint32_t KeyValueStore::CommitTimeUs() {
+    if (!Full()) {
+        return STORAGE_WRITE_TIME_US;
+    }
+    // Erasing, then writing every value and the header.
+    size_t count = StoredCount();
+    return STORAGE_ERASE_TIME_US(STORAGE_BANK_SIZE) + (count + 1) * STORAGE_WRITE_TIME_US;
+}
+
+void KeyValueStore::Commit() {
+    if (_dirty == 0) {
+        return;
+    }
+    if (Full()) {
+        MoveToOtherBank();
+        return;
+    }
+
+    uint8_t key = 0;
+    while (!(_dirty & (1 << key))) {
+        key++;
+    }
+    WriteRecord(_bank, _end, key);
+    _end += KV_RECORD_SIZE;
+    _dirty &= ~(1 << key);
+}
+
+bool KeyValueStore::Full() {
+    return _bank < 0 || _end + KV_RECORD_SIZE > STORAGE_BANK_SIZE;
+}
+
+size_t KeyValueStore::StoredCount() {
+    size_t count = 0;
+    for (uint8_t key = 0; key < KV_MAX_KEYS; key++) {
+        count += (_stored >> key) & 1;
+    }
+    return count;
+}
+
+void KeyValueStore::MoveToOtherBank() {
+    uint8_t bank = _bank < 0 ? 0 : !_bank;
+    size_t offset = KV_HEADER_SIZE;
+
+    // The whole bank, not just what we're about to write, as later records get appended up to the
+    // end of it. EEPROM doesn't clear anything by itself, so stale records from the last time this
+    // bank was used would otherwise be read back after the new ones.
+    storage::erase(bank, STORAGE_BANK_SIZE);
+
+    for (uint8_t key = 0; key < KV_MAX_KEYS; key++) {
+        if (_stored & (1 << key)) {
+            WriteRecord(bank, offset, key);
+            offset += KV_RECORD_SIZE;
+        }
+    }
+
+    // The header goes last, so that the old bank stays the newest one until every value has made
+    // it across.
+    uint16_t sequence = _bank < 0 ? 0 : _sequence + 1;
+    uint8_t header[KV_HEADER_SIZE] = { KV_MAGIC_0, KV_MAGIC_1, (uint8_t)sequence,
+                                       (uint8_t)(sequence >> 8) };
+    storage::write(bank, 0, header, sizeof(header));
+
+    _bank = bank;
+    _sequence = sequence;
+    _end = offset;
+    _dirty = 0;
+}
+
+void KeyValueStore::WriteRecord(uint8_t bank, size_t offset, uint8_t key) {
+    uint16_t value = _values[key];
+    uint8_t record[KV_RECORD_SIZE] = { key, (uint8_t)value, (uint8_t)(value >> 8),
+                                       check_byte(key, value) };
+    storage::write(bank, offset, record, sizeof(record));
+}
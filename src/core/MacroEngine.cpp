@@ -0,0 +1,66 @@
+#include "core/MacroEngine.hpp"
+
+#include "core/state.hpp"
+#include "stdlib.hpp"
+
+static_assert(
+    offsetof(OutputState, rightStickClick) - offsetof(OutputState, a) + 1 == OUTPUT_BUTTON_COUNT,
+    "OUTPUT_BUTTON_COUNT doesn't match OutputState"
+);
+static_assert(
+    offsetof(OutputState, triggerLAnalog) - offsetof(OutputState, leftStickX) + 1 ==
+        OUTPUT_AXIS_COUNT,
+    "OUTPUT_AXIS_COUNT doesn't match OutputState"
+);
+
+void MacroEngine::Play(const macro::Macro *macro, uint32_t now_us, uint32_t frame) {
+    memcpy_P(&_macro, macro, sizeof(_macro));
+    _start = _macro.unit == macro::FRAMES ? frame : now_us;
+    _next_step = 0;
+    _patch = macro::Patch{};
+    _playing = true;
+}
+
+void MacroEngine::Stop() {
+    _playing = false;
+}
+
+bool MacroEngine::Playing() {
+    return _playing;
+}
+
+void MacroEngine::Apply(uint32_t now_us, uint32_t frame, OutputState &outputs) {
+    if (!_playing) {
+        return;
+    }
+
+    uint32_t elapsed = (_macro.unit == macro::FRAMES ? frame : now_us) - _start;
+    if (elapsed >= _macro.duration) {
+        _playing = false;
+        return;
+    }
+
+    // Catch up to the step we're in now. Usually this is at most one step.
+    while (_next_step < _macro.step_count &&
+           pgm_read_dword(&_macro.steps[_next_step].offset) <= elapsed) {
+        memcpy_P(&_patch, &_macro.steps[_next_step].patch, sizeof(_patch));
+        _next_step++;
+    }
+
+    bool *buttons = &outputs.a;
+    for (size_t i = 0; i < OUTPUT_BUTTON_COUNT; i++) {
+        uint32_t bit = 1UL << i;
+        if (_patch.press & bit) {
+            buttons[i] = true;
+        } else if (_patch.release & bit) {
+            buttons[i] = false;
+        }
+    }
+
+    uint8_t *axes = &outputs.leftStickX;
+    for (size_t i = 0; i < OUTPUT_AXIS_COUNT; i++) {
+        if (_patch.axes & (1 << i)) {
+            axes[i] = _patch.axis_values[i];
+        }
+    }
+}
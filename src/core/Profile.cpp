@@ -0,0 +1,136 @@
+#include "core/Profile.hpp"
+
+#include "core/InputMode.hpp"
+#include "core/socd.hpp"
+#include "core/state.hpp"
+#include "stdlib.hpp"
+
+// Every rectangle input, in InputState order.
+static bool InputState::*const rectangle_inputs[] = {
+    &InputState::left,      &InputState::right,  &InputState::down,   &InputState::up,
+    &InputState::c_left,    &InputState::c_right, &InputState::c_down, &InputState::c_up,
+    &InputState::a,         &InputState::b,      &InputState::x,      &InputState::y,
+    &InputState::l,         &InputState::r,      &InputState::z,      &InputState::lightshield,
+    &InputState::midshield, &InputState::select, &InputState::start,  &InputState::home,
+    &InputState::mod_x,     &InputState::mod_y,
+};
+
+static_assert(
+    sizeof(rectangle_inputs) / sizeof(rectangle_inputs[0]) == RECTANGLE_INPUT_COUNT,
+    "rectangle_inputs doesn't match InputState"
+);
+
+static uint16_t get_u16(const uint8_t *bytes) {
+    return bytes[0] | (bytes[1] << 8);
+}
+
+static uint32_t get_u32(const uint8_t *bytes) {
+    return get_u16(bytes) | ((uint32_t)get_u16(bytes + 2) << 16);
+}
+
+// The same CRC-32 as zlib.crc32() in Python.
+static uint32_t crc32(uint32_t crc, const uint8_t *data, size_t len) {
+    crc = ~crc;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+        }
+    }
+    return ~crc;
+}
+
+bool Profile::Open(const uint8_t *data, size_t max_size, uint32_t usable_pins) {
+    _data = nullptr;
+    if (max_size < PROFILE_HEADER_SIZE + PROFILE_NAME_SIZE ||
+        memcmp(data, PROFILE_MAGIC, 4) != 0 || data[4] != PROFILE_VERSION) {
+        return false;
+    }
+
+    uint8_t button_count = data[5];
+    uint8_t socd_pair_count = data[6];
+    size_t size = get_u16(data + 8);
+    size_t expected_size = PROFILE_HEADER_SIZE + PROFILE_NAME_SIZE +
+                           button_count * PROFILE_BUTTON_SIZE +
+                           socd_pair_count * PROFILE_SOCD_PAIR_SIZE;
+    if (size != expected_size || size > max_size || socd_pair_count > MAX_SOCD_PAIRS) {
+        return false;
+    }
+
+    uint32_t crc = crc32(0, data, 12);
+    crc = crc32(crc, data + PROFILE_HEADER_SIZE, size - PROFILE_HEADER_SIZE);
+    if (crc != get_u32(data + 12) || data[PROFILE_HEADER_SIZE + PROFILE_NAME_SIZE - 1] != 0) {
+        return false;
+    }
+
+    // Anything that would index out of bounds once we start using it, and pins that don't exist or
+    // are already used for something else.
+    const uint8_t *buttons = data + PROFILE_HEADER_SIZE + PROFILE_NAME_SIZE;
+    for (size_t i = 0; i < button_count; i++) {
+        const uint8_t *button = buttons + i * PROFILE_BUTTON_SIZE;
+        if (button[0] >= RECTANGLE_INPUT_COUNT || button[1] >= 32 ||
+            !(usable_pins & (1UL << button[1]))) {
+            return false;
+        }
+    }
+    const uint8_t *socd_pairs = buttons + button_count * PROFILE_BUTTON_SIZE;
+    for (size_t i = 0; i < socd_pair_count; i++) {
+        const uint8_t *pair = socd_pairs + i * PROFILE_SOCD_PAIR_SIZE;
+        if (pair[0] >= RECTANGLE_INPUT_COUNT || pair[1] >= RECTANGLE_INPUT_COUNT ||
+            pair[2] > socd::LAST_SOCD_TYPE) {
+            return false;
+        }
+    }
+
+    _data = data;
+    return true;
+}
+
+bool Profile::Valid() {
+    return _data != nullptr;
+}
+
+const char *Profile::Name() {
+    return (const char *)(_data + PROFILE_HEADER_SIZE);
+}
+
+uint8_t Profile::DefaultMode() {
+    return _data[7];
+}
+
+bool Profile::Option(uint16_t option) {
+    return get_u16(_data + 10) & option;
+}
+
+size_t Profile::ButtonCount() {
+    return _data[5];
+}
+
+uint8_t Profile::ButtonInput(size_t index) {
+    return Buttons()[index * PROFILE_BUTTON_SIZE];
+}
+
+uint8_t Profile::ButtonPin(size_t index) {
+    return Buttons()[index * PROFILE_BUTTON_SIZE + 1];
+}
+
+size_t Profile::SocdPairCount() {
+    return _data[6];
+}
+
+socd::SocdPair Profile::SocdPair(size_t index) {
+    const uint8_t *pair = SocdPairs() + index * PROFILE_SOCD_PAIR_SIZE;
+    return socd::SocdPair{
+        rectangle_inputs[pair[0]],
+        rectangle_inputs[pair[1]],
+        (socd::SocdType)pair[2],
+    };
+}
+
+const uint8_t *Profile::Buttons() {
+    return _data + PROFILE_HEADER_SIZE + PROFILE_NAME_SIZE;
+}
+
+const uint8_t *Profile::SocdPairs() {
+    return Buttons() + ButtonCount() * PROFILE_BUTTON_SIZE;
+}
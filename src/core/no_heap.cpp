@@ -0,0 +1,35 @@
+#ifdef HAYBOX_NO_HEAP
+
+#include "stdlib.hpp"
+
+/*
+ * With the no_heap profile, everything HayBox creates at boot lives in static storage (see
+ * core/static_alloc.hpp), so nothing should ever need the heap. This symbol is deliberately never
+ * defined, so if anything does still reach operator new, the build fails at link time with an error
+ * naming the function that called it, instead of quietly pulling malloc back in.
+ */
+extern "C" void haybox_no_heap_operator_new_was_called(void);
+
+void *operator new(size_t size) {
+    haybox_no_heap_operator_new_was_called();
+    return (void *)1;
+}
+
+void *operator new[](size_t size) {
+    haybox_no_heap_operator_new_was_called();
+    return (void *)1;
+}
+
+// Virtual destructors still reference operator delete, so these have to exist for the build to link
+// even though nothing is ever allocated.
+void operator delete(void *ptr) noexcept {}
+
+void operator delete[](void *ptr) noexcept {}
+
+#if __cpp_sized_deallocation
+void operator delete(void *ptr, size_t size) noexcept {}
+
+void operator delete[](void *ptr, size_t size) noexcept {}
+#endif
+
+#endif
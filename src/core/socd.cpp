@@ -1,5 +1,119 @@
 #include "core/socd.hpp"
 
+void socd::add_pair(PairMasks &masks, size_t pair_index, SocdType socd_type) {
+    PairMask bit = 1 << pair_index;
+    switch (socd_type) {
+        case SOCD_NEUTRAL:
+            masks.neutral |= bit;
+            break;
+        case SOCD_2IP:
+            masks.second_input_priority |= bit;
+            break;
+        case SOCD_2IP_NO_REAC:
+            masks.second_input_priority_no_reactivation |= bit;
+            break;
+        case SOCD_DIR1_PRIORITY:
+            masks.dir1_priority |= bit;
+            break;
+        case SOCD_DIR2_PRIORITY:
+            masks.dir2_priority |= bit;
+            break;
+#ifdef HAYBOX_PRESS_TIMES
+        case SOCD_2IP_TIMESTAMP:
+            masks.second_input_priority_timestamp |= bit;
+            break;
+#endif
+        case SOCD_NONE:
+            break;
+    }
+}
+
+socd::PairMask socd::pairs(const PairMasks &masks) {
+    return masks.neutral | masks.second_input_priority |
+           masks.second_input_priority_no_reactivation | masks.dir1_priority |
+           masks.dir2_priority | masks.second_input_priority_timestamp;
+}
+
+void socd::resolve(
+    PairMask &input_dir1,
+    PairMask &input_dir2,
+    PairMask dir1_newer,
+    PairMask dir2_newer,
+    const PairMasks &masks,
+    PairStates &states
+) {
+    /*
+     * Each SOCD type below is the function of the same name further down, rewritten as bitwise
+     * operations on every pair at once. Every pair only ever has one of these cases true.
+     */
+    PairMask both = input_dir1 & input_dir2;
+    PairMask only_dir1 = input_dir1 & ~input_dir2;
+    PairMask only_dir2 = input_dir2 & ~input_dir1;
+    PairMask was_dir1 = states.was_dir1;
+    PairMask was_dir2 = states.was_dir2;
+    PairMask lock_dir1 = states.lock_dir1;
+    PairMask lock_dir2 = states.lock_dir2;
+
+    // Neutral.
+    PairMask mask = masks.neutral;
+    PairMask dir1 = only_dir1 & mask;
+    PairMask dir2 = only_dir2 & mask;
+
+    // Dir1 priority and dir2 priority.
+    mask = masks.dir1_priority;
+    dir1 |= input_dir1 & mask;
+    dir2 |= only_dir2 & mask;
+    mask = masks.dir2_priority;
+    dir1 |= only_dir1 & mask;
+    dir2 |= input_dir2 & mask;
+
+    // Second input priority.
+    mask = masks.second_input_priority;
+    dir1 |= (only_dir1 | (both & was_dir2 & ~was_dir1)) & mask;
+    dir2 |= (only_dir2 | (both & was_dir1)) & mask;
+    PairMask new_was_dir1 = (only_dir1 | (was_dir1 & ~only_dir2)) & mask;
+    PairMask new_was_dir2 = (only_dir2 | (was_dir2 & ~only_dir1)) & mask;
+    PairMask new_lock_dir1 = lock_dir1 & mask;
+    PairMask new_lock_dir2 = lock_dir2 & mask;
+
+    // Second input priority by timestamp, which is the same except when both are held.
+    mask = masks.second_input_priority_timestamp;
+    PairMask tied = both & ~dir1_newer & ~dir2_newer;
+    dir1 |= (only_dir1 | (both & dir1_newer) | (tied & was_dir2 & ~was_dir1)) & mask;
+    dir2 |= (only_dir2 | (both & dir2_newer) | (tied & was_dir1)) & mask;
+    new_was_dir1 |= (only_dir1 | (was_dir1 & ~only_dir2)) & mask;
+    new_was_dir2 |= (only_dir2 | (was_dir2 & ~only_dir1)) & mask;
+    new_lock_dir1 |= lock_dir1 & mask;
+    new_lock_dir2 |= lock_dir2 & mask;
+
+    // Second input priority without reactivation.
+    mask = masks.second_input_priority_no_reactivation;
+    dir1 |= ((both & was_dir2 & ~was_dir1) | (only_dir1 & ~lock_dir1)) & mask;
+    dir2 |= ((both & was_dir1) | (only_dir2 & ~lock_dir2)) & mask;
+    new_was_dir1 |= ((both & was_dir1) | (only_dir2 & lock_dir2 & was_dir1) |
+                     (only_dir1 & (~lock_dir1 | was_dir1))) &
+                    mask;
+    new_was_dir2 |= ((both & was_dir2) | (only_dir1 & lock_dir1 & was_dir2) |
+                     (only_dir2 & (~lock_dir2 | was_dir2))) &
+                    mask;
+    new_lock_dir1 |= ((both & (lock_dir1 | was_dir1)) | (only_dir1 & lock_dir1) |
+                      (only_dir2 & lock_dir2 & lock_dir1)) &
+                     mask;
+    new_lock_dir2 |= ((both & (lock_dir2 | was_dir2)) | (only_dir2 & lock_dir2) |
+                      (only_dir1 & lock_dir1 & lock_dir2)) &
+                     mask;
+
+    // Anything not resolved here keeps its inputs and state.
+    mask = ~pairs(masks);
+    input_dir1 = dir1 | (input_dir1 & mask);
+    input_dir2 = dir2 | (input_dir2 & mask);
+    mask |= masks.neutral | masks.dir1_priority | masks.dir2_priority;
+    states.was_dir1 = new_was_dir1 | (was_dir1 & mask);
+    states.was_dir2 = new_was_dir2 | (was_dir2 & mask);
+    states.lock_dir1 = new_lock_dir1 | (lock_dir1 & mask);
+    states.lock_dir2 = new_lock_dir2 | (lock_dir2 & mask);
+}
+
 void socd::second_input_priority_no_reactivation(
     bool &input_dir1,
     bool &input_dir2,
@@ -70,6 +184,23 @@ void socd::second_input_priority(bool &input_dir1, bool &input_dir2, SocdState &
     input_dir2 = is_dir2;
 }
 
+void socd::second_input_priority_timestamp(
+    bool &input_dir1,
+    bool &input_dir2,
+    uint32_t press_time_dir1,
+    uint32_t press_time_dir2,
+    SocdState &socd_state
+) {
+    // Compare as a difference so that micros() wrapping around doesn't matter.
+    int32_t dir1_newer_by = (int32_t)(press_time_dir1 - press_time_dir2);
+    if (input_dir1 && input_dir2 && dir1_newer_by != 0) {
+        input_dir1 = dir1_newer_by > 0;
+        input_dir2 = dir1_newer_by < 0;
+        return;
+    }
+    second_input_priority(input_dir1, input_dir2, socd_state);
+}
+
 void socd::neutral(bool &input_dir1, bool &input_dir2) {
     if (input_dir1 && input_dir2) {
         input_dir1 = false;
@@ -18,8 +18,11 @@ InputScanSpeed GpioButtonInput::ScanSpeed() {
 }
 
 void GpioButtonInput::UpdateInputs(InputState &inputs) {
+    uint32_t now = ScanTime();
     for (size_t i = 0; i < _button_count; i++) {
         GpioButtonMapping button_mapping = _button_mappings[i];
-        inputs.*(button_mapping.button) = !gpio::read_digital(button_mapping.pin);
+        bool pressed = !gpio::read_digital(button_mapping.pin);
+        inputs.*(button_mapping.button) = pressed;
+        UpdatePressTime(inputs, button_mapping.button, pressed, now);
     }
 }
@@ -0,0 +1,29 @@
+#include "input/ProfileButtonInput.hpp"
+
+#include "gpio.hpp"
+
+ProfileButtonInput::ProfileButtonInput(Profile &profile) : _profile(profile) {
+    InitPins();
+}
+
+void ProfileButtonInput::InitPins() {
+    // Initialize button pins.
+    for (size_t i = 0; i < _profile.ButtonCount(); i++) {
+        gpio::init_pin(_profile.ButtonPin(i), gpio::GpioMode::GPIO_INPUT_PULLUP);
+    }
+}
+
+InputScanSpeed ProfileButtonInput::ScanSpeed() {
+    return InputScanSpeed::FAST;
+}
+
+void ProfileButtonInput::UpdateInputs(InputState &inputs) {
+    uint32_t now = ScanTime();
+    bool *buttons = &inputs.left;
+    for (size_t i = 0; i < _profile.ButtonCount(); i++) {
+        uint8_t input = _profile.ButtonInput(i);
+        bool pressed = !gpio::read_digital(_profile.ButtonPin(i));
+        buttons[input] = pressed;
+        UpdatePressTime(inputs, input, pressed, now);
+    }
+}
@@ -0,0 +1,10 @@
+#include "modes/FgcHotkeys.hpp"
+
+#include "core/state.hpp"
+
+FgcHotkeys::FgcHotkeys() {}
+
+void FgcHotkeys::UpdateKeys(InputState &inputs) {
+    Press(HID_KEY_ESCAPE, inputs.home);
+    Press(HID_KEY_ENTER, inputs.select);
+}
@@ -4,14 +4,18 @@
 #define ANALOG_STICK_NEUTRAL 128
 #define ANALOG_STICK_MAX 208
 
-Melee18Button::Melee18Button(socd::SocdType socd_type, Melee18ButtonOptions options) {
-    _socd_pair_count = 4;
-    _socd_pairs = new socd::SocdPair[_socd_pair_count]{
+Melee18Button::Melee18Button(socd::SocdType socd_type, Melee18ButtonOptions options)
+    : StaticControllerMode(Melee18ButtonStages(
+          stages::DpadLayer(stages::MOD_X_AND_MOD_Y),
+          stages::CStickShutoff(stages::MOD_X_AND_MOD_Y | stages::NUNCHUK_C, ANALOG_STICK_NEUTRAL),
+          stages::NunchukLeftStick()
+      )) {
+    SetSocdPairs({
         socd::SocdPair{&InputState::left,    &InputState::right,   socd_type},
         socd::SocdPair{ &InputState::down,   &InputState::up,      socd_type},
         socd::SocdPair{ &InputState::c_left, &InputState::c_right, socd_type},
         socd::SocdPair{ &InputState::c_down, &InputState::c_up,    socd_type},
-    };
+    });
 
     _options = options;
     horizontal_socd = false;
@@ -40,14 +44,6 @@ void Melee18Button::UpdateDigitalOutputs(InputState &inputs, OutputState &output
     outputs.triggerRDigital = inputs.r;
     outputs.start = inputs.start;
 
-    // Activate D-Pad layer by holding Mod X + Mod Y.
-    if (inputs.mod_x && inputs.mod_y) {
-        outputs.dpadUp = inputs.c_up;
-        outputs.dpadDown = inputs.c_down;
-        outputs.dpadLeft = inputs.c_left;
-        outputs.dpadRight = inputs.c_right;
-    }
-
     if (inputs.select)
         outputs.dpadLeft = true;
     if (inputs.home)
@@ -290,16 +286,4 @@ void Melee18Button::UpdateAnalogOutputs(InputState &inputs, OutputState &outputs
     if (!inputs.r && horizontal_socd && !directions.vertical) {
         outputs.leftStickX = 128 + (directions.x * 80);
     }
-
-    // Shut off C-stick when using D-Pad layer.
-    if ((inputs.mod_x && inputs.mod_y) || inputs.nunchuk_c) {
-        outputs.rightStickX = 128;
-        outputs.rightStickY = 128;
-    }
-
-    // Nunchuk overrides left stick.
-    if (inputs.nunchuk_connected) {
-        outputs.leftStickX = inputs.nunchuk_x;
-        outputs.leftStickY = inputs.nunchuk_y;
-    }
 }
@@ -1,17 +1,37 @@
 #include "modes/ProjectM.hpp"
 
+#include "modes/generated/ProjectMRules.hpp"
+
 #define ANALOG_STICK_MIN 28
 #define ANALOG_STICK_NEUTRAL 128
 #define ANALOG_STICK_MAX 228
 
-ProjectM::ProjectM(socd::SocdType socd_type, ProjectMOptions options) {
-    _socd_pair_count = 4;
-    _socd_pairs = new socd::SocdPair[_socd_pair_count]{
+// Z on its own, for the lightshield + A macro.
+static const combo::Combo z_press_combo[] PROGMEM = {
+    combo::chord(BUTTON_BIT(z), BUTTON_BIT(mod_x), nullptr),
+};
+
+// Lightshield + A for two frames, so that at least one whole frame sees it wherever in the frame Z
+// was pressed.
+static const macro::Step z_press_steps[] PROGMEM = {
+    { 0, macro::with_axis(macro::press(OUTPUT_BIT(a)), macro::TRIGGER_R, 49) },
+};
+static const macro::Macro z_press_macro PROGMEM = { z_press_steps, 1, macro::FRAMES, 2 };
+
+ProjectM::ProjectM(socd::SocdType socd_type, ProjectMOptions options)
+    : StaticControllerMode(ProjectMStages(
+          stages::DpadLayer(stages::MOD_X_AND_MOD_Y | stages::NUNCHUK_C),
+          stages::ShieldAnalog(140, 49),
+          stages::CStickShutoff(stages::MOD_X_AND_MOD_Y | stages::NUNCHUK_C, ANALOG_STICK_NEUTRAL),
+          stages::NunchukLeftStick()
+      )),
+      _z_press(z_press_combo) {
+    SetSocdPairs({
         socd::SocdPair{&InputState::left,    &InputState::right,   socd_type},
         socd::SocdPair{ &InputState::down,   &InputState::up,      socd_type},
         socd::SocdPair{ &InputState::c_left, &InputState::c_right, socd_type},
         socd::SocdPair{ &InputState::c_down, &InputState::c_up,    socd_type},
-    };
+    });
 
     _options = options;
     _horizontal_socd = false;
@@ -27,12 +47,16 @@ void ProjectM::UpdateDigitalOutputs(InputState &inputs, OutputState &outputs) {
     outputs.b = inputs.b;
     outputs.x = inputs.x;
     outputs.y = inputs.y;
-    // True Z press vs macro lightshield + A.
+    // True Z press vs macro lightshield + A, which is either held along with Z or played once per
+    // press on top of the outputs at the end of UpdateAnalogOutputs().
     if (_options.true_z_press || inputs.mod_x) {
         outputs.buttonR = inputs.z;
-    } else {
+    } else if (!_options.z_press_macro) {
         outputs.a = inputs.a || inputs.z;
     }
+    if (_options.z_press_macro && !_options.true_z_press && _z_press.Update(inputs, nullptr)) {
+        _macros.Play(&z_press_macro, micros(), Frame());
+    }
     if (inputs.nunchuk_connected) {
         outputs.triggerLDigital = inputs.nunchuk_z;
     } else {
@@ -41,14 +65,6 @@ void ProjectM::UpdateDigitalOutputs(InputState &inputs, OutputState &outputs) {
     outputs.triggerRDigital = inputs.r;
     outputs.start = inputs.start;
 
-    // Activate D-Pad layer by holding Mod X + Mod Y or Nunchuk C button.
-    if ((inputs.mod_x && inputs.mod_y) || inputs.nunchuk_c) {
-        outputs.dpadUp = inputs.c_up;
-        outputs.dpadDown = inputs.c_down;
-        outputs.dpadLeft = inputs.c_left;
-        outputs.dpadRight = inputs.c_right;
-    }
-
     // Don't override dpad up if it's already pressed using the MX + MY dpad
     // layer.
     outputs.dpadUp = outputs.dpadUp || inputs.midshield;
@@ -59,6 +75,9 @@ void ProjectM::UpdateDigitalOutputs(InputState &inputs, OutputState &outputs) {
         outputs.dpadRight = true;
 }
 
+using namespace stick_rules;
+using namespace stick_rules::project_m;
+
 void ProjectM::UpdateAnalogOutputs(InputState &inputs, OutputState &outputs) {
     UpdateDirections(
         inputs.left,
@@ -76,150 +95,18 @@ void ProjectM::UpdateAnalogOutputs(InputState &inputs, OutputState &outputs) {
     );
 
     bool shield_button_pressed = inputs.l || inputs.lightshield;
-
-    if (directions.diagonal) {
-        if (directions.y == 1) {
-            outputs.leftStickX = 128 + (directions.x * 83);
-            outputs.leftStickY = 128 + (directions.y * 93);
-        }
-    }
-
-    if (inputs.mod_x) {
-        if (directions.horizontal) {
-            outputs.leftStickX = 128 + (directions.x * 70);
-        }
-        if (directions.vertical) {
-            outputs.leftStickY = 128 + (directions.y * 60);
-        }
-
-        if (directions.cx != 0) {
-            outputs.rightStickX = 128 + (directions.cx * 65);
-            outputs.rightStickY = 128 + (directions.y * 23);
-        }
-
-        if (directions.diagonal) {
-            outputs.leftStickX = 128 + (directions.x * 70);
-            outputs.leftStickY = 128 + (directions.y * 34);
-
-            if (inputs.b) {
-                outputs.leftStickX = 128 + (directions.x * 85);
-                outputs.leftStickY = 128 + (directions.y * 31);
-            }
-
-            if (inputs.r) {
-                outputs.leftStickX = 128 + (directions.x * 82);
-                outputs.leftStickY = 128 + (directions.y * 35);
-            }
-
-            if (inputs.c_up) {
-                outputs.leftStickX = 128 + (directions.x * 77);
-                outputs.leftStickY = 128 + (directions.y * 55);
-            }
-
-            if (inputs.c_down) {
-                outputs.leftStickX = 128 + (directions.x * 82);
-                outputs.leftStickY = 128 + (directions.y * 36);
-            }
-
-            if (inputs.c_left) {
-                outputs.leftStickX = 128 + (directions.x * 84);
-                outputs.leftStickY = 128 + (directions.y * 50);
-            }
-
-            if (inputs.c_right) {
-                outputs.leftStickX = 128 + (directions.x * 72);
-                outputs.leftStickY = 128 + (directions.y * 61);
-            }
-        }
-    }
-
-    if (inputs.mod_y) {
-        if (directions.horizontal) {
-            outputs.leftStickX = 128 + (directions.x * 35);
-        }
-        if (directions.vertical) {
-            outputs.leftStickY = 128 + (directions.y * 70);
-        }
-
-        if (directions.diagonal) {
-            outputs.leftStickX = 128 + (directions.x * 28);
-            outputs.leftStickY = 128 + (directions.y * 58);
-
-            if (inputs.b) {
-                outputs.leftStickX = 128 + (directions.x * 28);
-                outputs.leftStickY = 128 + (directions.y * 85);
-            }
-
-            if (inputs.r) {
-                outputs.leftStickX = 128 + (directions.x * 51);
-                outputs.leftStickY = 128 + (directions.y * 82);
-            }
-
-            if (inputs.c_up) {
-                outputs.leftStickX = 128 + (directions.x * 55);
-                outputs.leftStickY = 128 + (directions.y * 77);
-            }
-
-            if (inputs.c_down) {
-                outputs.leftStickX = 128 + (directions.x * 34);
-                outputs.leftStickY = 128 + (directions.y * 82);
-            }
-
-            if (inputs.c_left) {
-                outputs.leftStickX = 128 + (directions.x * 40);
-                outputs.leftStickY = 128 + (directions.y * 84);
-            }
-
-            if (inputs.c_right) {
-                outputs.leftStickX = 128 + (directions.x * 62);
-                outputs.leftStickY = 128 + (directions.y * 72);
-            }
-        }
-    }
-
-    // C-stick ASDI Slideoff angle overrides any other C-stick modifiers (such as
-    // angled fsmash).
-    // We don't apply this for c-up + c-left/c-right in case we want to implement
-    // C-stick nair somehow.
-    if (directions.cx != 0 && directions.cy == -1) {
-        // 3000 9875 = 30 78
-        outputs.rightStickX = 128 + (directions.cx * 35);
-        outputs.rightStickY = 128 + (directions.cy * 98);
-    }
-
-    // Horizontal SOCD overrides X-axis modifiers (for ledgedash maximum jump
-    // trajectory).
-    if (_options.ledgedash_max_jump_traj && _horizontal_socd && !directions.vertical &&
-        !shield_button_pressed) {
-        outputs.leftStickX = 128 + (directions.x * 100);
-    }
-
-    if (inputs.lightshield) {
-        outputs.triggerRAnalog = 49;
-    }
+    uint32_t conditions = StickConditions(inputs) | (shield_button_pressed ? SHIELD : 0) |
+                          (_horizontal_socd ? HORIZONTAL_SOCD : 0) |
+                          (_options.ledgedash_max_jump_traj ? LEDGEDASH_MAX_JUMP_TRAJ : 0);
+    ApplyStickLut(&left_stick_lut, conditions, ANALOG_STICK_NEUTRAL, outputs);
+    ApplyStickLut(&right_stick_lut, conditions, ANALOG_STICK_NEUTRAL, outputs);
 
     // Send lightshield input if we are using Z = lightshield + A macro.
-    if (inputs.z && !(inputs.mod_x || _options.true_z_press)) {
+    if (inputs.z && !(inputs.mod_x || _options.true_z_press || _options.z_press_macro)) {
         outputs.triggerRAnalog = 49;
     }
 
-    if (outputs.triggerLDigital) {
-        outputs.triggerLAnalog = 140;
-    }
-
-    if (outputs.triggerRDigital) {
-        outputs.triggerRAnalog = 140;
-    }
-
-    // Shut off C-stick when using D-Pad layer.
-    if ((inputs.mod_x && inputs.mod_y) || inputs.nunchuk_c) {
-        outputs.rightStickX = 128;
-        outputs.rightStickY = 128;
-    }
-
-    // Nunchuk overrides left stick.
-    if (inputs.nunchuk_connected) {
-        outputs.leftStickX = inputs.nunchuk_x;
-        outputs.leftStickY = inputs.nunchuk_y;
+    if (_macros.Playing()) {
+        _macros.Apply(micros(), Frame(), outputs);
     }
 }
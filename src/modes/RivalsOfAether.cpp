@@ -4,14 +4,18 @@
 #define ANALOG_STICK_NEUTRAL 128
 #define ANALOG_STICK_MAX 228
 
-RivalsOfAether::RivalsOfAether(socd::SocdType socd_type) {
-    _socd_pair_count = 4;
-    _socd_pairs = new socd::SocdPair[_socd_pair_count]{
+RivalsOfAether::RivalsOfAether(socd::SocdType socd_type)
+    : StaticControllerMode(RivalsOfAetherStages(
+          stages::DpadLayer(stages::MOD_X_AND_MOD_Y),
+          stages::CStickShutoff(stages::MOD_X_AND_MOD_Y, ANALOG_STICK_NEUTRAL),
+          stages::NunchukLeftStick()
+      )) {
+    SetSocdPairs({
         socd::SocdPair{&InputState::left,    &InputState::right,   socd_type},
         socd::SocdPair{ &InputState::down,   &InputState::up,      socd_type},
         socd::SocdPair{ &InputState::c_left, &InputState::c_right, socd_type},
         socd::SocdPair{ &InputState::c_down, &InputState::c_up,    socd_type},
-    };
+    });
 }
 
 void RivalsOfAether::UpdateDigitalOutputs(InputState &inputs, OutputState &outputs) {
@@ -35,14 +39,6 @@ void RivalsOfAether::UpdateDigitalOutputs(InputState &inputs, OutputState &outpu
     outputs.home = inputs.home;
     outputs.leftStickClick = inputs.lightshield;
     outputs.rightStickClick = inputs.midshield;
-
-    // Activate D-Pad layer by holding Mod X + Mod Y.
-    if (inputs.mod_x && inputs.mod_y) {
-        outputs.dpadUp = inputs.c_up;
-        outputs.dpadDown = inputs.c_down;
-        outputs.dpadLeft = inputs.c_left;
-        outputs.dpadRight = inputs.c_right;
-    }
 }
 
 void RivalsOfAether::UpdateAnalogOutputs(InputState &inputs, OutputState &outputs) {
@@ -64,7 +60,6 @@ void RivalsOfAether::UpdateAnalogOutputs(InputState &inputs, OutputState &output
 
     bool shield_button_pressed = inputs.l || inputs.r;
 
-
     // 48 total DI angles, 24 total Up b angles, 16 total airdodge angles
 
     if (inputs.mod_x) {
@@ -150,16 +145,4 @@ void RivalsOfAether::UpdateAnalogOutputs(InputState &inputs, OutputState &output
             }
         }
     }
-
-    // Shut off C-stick when using D-Pad layer.
-    if (inputs.mod_x && inputs.mod_y) {
-        outputs.rightStickX = 128;
-        outputs.rightStickY = 128;
-    }
-
-    // Nunchuk overrides left stick.
-    if (inputs.nunchuk_connected) {
-        outputs.leftStickX = inputs.nunchuk_x;
-        outputs.leftStickY = inputs.nunchuk_y;
-    }
 }
@@ -5,13 +5,12 @@
 #define ANALOG_STICK_MAX 255
 
 HollowKnight::HollowKnight(socd::SocdType socd_type) {
-    _socd_pair_count = 4;
-    _socd_pairs = new socd::SocdPair[_socd_pair_count]{
+    SetSocdPairs({
         socd::SocdPair{&InputState::left,    &InputState::right,   socd_type},
         socd::SocdPair{ &InputState::down,   &InputState::mod_x,   socd_type},
         socd::SocdPair{ &InputState::c_left, &InputState::c_right, socd_type},
         socd::SocdPair{ &InputState::c_down, &InputState::c_up,    socd_type},
-    };
+    });
 }
 
 void HollowKnight::UpdateDigitalOutputs(InputState &inputs, OutputState &outputs) {
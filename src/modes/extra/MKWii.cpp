@@ -4,14 +4,17 @@
 #define ANALOG_STICK_NEUTRAL 128
 #define ANALOG_STICK_MAX 255
 
-MKWii::MKWii(socd::SocdType socd_type) {
-    _socd_pair_count = 4;
-    _socd_pairs = new socd::SocdPair[_socd_pair_count]{
+MKWii::MKWii(socd::SocdType socd_type)
+    : StaticControllerMode(MKWiiStages(
+          stages::ShieldAnalog(140),
+          stages::NunchukLeftStick()
+      )) {
+    SetSocdPairs({
         socd::SocdPair{&InputState::left, &InputState::right, socd_type},
         socd::SocdPair{ &InputState::l,   &InputState::down,  socd_type},
         socd::SocdPair{ &InputState::l,   &InputState::mod_x, socd_type},
         socd::SocdPair{ &InputState::l,   &InputState::mod_y, socd_type},
-    };
+    });
 }
 
 void MKWii::UpdateDigitalOutputs(InputState &inputs, OutputState &outputs) {
@@ -40,14 +43,4 @@ void MKWii::UpdateAnalogOutputs(InputState &inputs, OutputState &outputs) {
         ANALOG_STICK_MAX,
         outputs
     );
-
-    if (inputs.z) {
-        outputs.triggerLAnalog = 140;
-    }
-
-    // Nunchuk overrides left stick.
-    if (inputs.nunchuk_connected) {
-        outputs.leftStickX = inputs.nunchuk_x;
-        outputs.leftStickY = inputs.nunchuk_y;
-    }
 }
@@ -4,14 +4,17 @@
 #define ANALOG_STICK_NEUTRAL 128
 #define ANALOG_STICK_MAX 255
 
-MultiVersus::MultiVersus(socd::SocdType socd_type) {
-    _socd_pair_count = 4;
-    _socd_pairs = new socd::SocdPair[_socd_pair_count]{
+MultiVersus::MultiVersus(socd::SocdType socd_type)
+    : StaticControllerMode(MultiVersusStages(
+          stages::ShieldAnalog(140),
+          stages::NunchukLeftStick()
+      )) {
+    SetSocdPairs({
         socd::SocdPair{&InputState::left,    &InputState::right,   socd_type},
         socd::SocdPair{ &InputState::down,   &InputState::up,      socd_type},
         socd::SocdPair{ &InputState::c_left, &InputState::c_right, socd_type},
         socd::SocdPair{ &InputState::c_down, &InputState::c_up,    socd_type},
-    };
+    });
 }
 
 void MultiVersus::UpdateDigitalOutputs(InputState &inputs, OutputState &outputs) {
@@ -110,18 +113,4 @@ void MultiVersus::UpdateAnalogOutputs(InputState &inputs, OutputState &outputs)
         outputs.rightStickX = ANALOG_STICK_NEUTRAL;
         outputs.rightStickY = ANALOG_STICK_NEUTRAL;
     }
-
-    if (outputs.triggerLDigital) {
-        outputs.triggerLAnalog = 140;
-    }
-
-    if (outputs.triggerRDigital) {
-        outputs.triggerRAnalog = 140;
-    }
-
-    // Nunchuk overrides left stick.
-    if (inputs.nunchuk_connected) {
-        outputs.leftStickX = inputs.nunchuk_x;
-        outputs.leftStickY = inputs.nunchuk_y;
-    }
 }
@@ -4,14 +4,18 @@
 #define ANALOG_STICK_NEUTRAL 128
 #define ANALOG_STICK_MAX 255
 
-RocketLeague::RocketLeague(socd::SocdType socd_type) {
-    _socd_pair_count = 4;
-    _socd_pairs = new socd::SocdPair[_socd_pair_count]{
+RocketLeague::RocketLeague(socd::SocdType socd_type)
+    : StaticControllerMode(RocketLeagueStages(
+          stages::DpadLayer(stages::MOD_X_AND_MOD_Y),
+          stages::CStickShutoff(stages::MOD_X_AND_MOD_Y, ANALOG_STICK_NEUTRAL),
+          stages::NunchukLeftStick()
+      )) {
+    SetSocdPairs({
         socd::SocdPair{&InputState::left,    &InputState::right,   socd_type               },
         socd::SocdPair{ &InputState::down,   &InputState::mod_x,   socd::SOCD_DIR2_PRIORITY},
         socd::SocdPair{ &InputState::c_left, &InputState::c_right, socd_type               },
         socd::SocdPair{ &InputState::c_down, &InputState::c_up,    socd_type               },
-    };
+    });
 }
 
 void RocketLeague::UpdateDigitalOutputs(InputState &inputs, OutputState &outputs) {
@@ -37,14 +41,6 @@ void RocketLeague::UpdateDigitalOutputs(InputState &inputs, OutputState &outputs
         outputs.select = inputs.start;
     else
         outputs.start = inputs.start;
-
-    // D-Pad
-    if (inputs.mod_x && inputs.mod_y) {
-        outputs.dpadUp = inputs.c_up;
-        outputs.dpadDown = inputs.c_down;
-        outputs.dpadLeft = inputs.c_left;
-        outputs.dpadRight = inputs.c_right;
-    }
 }
 
 void RocketLeague::UpdateAnalogOutputs(InputState &inputs, OutputState &outputs) {
@@ -78,16 +74,4 @@ void RocketLeague::UpdateAnalogOutputs(InputState &inputs, OutputState &outputs)
         // Good speed flip angle with no mods.
         outputs.leftStickX = ANALOG_STICK_NEUTRAL + (directions.x * 70);
     }
-
-    // Shut off right stick when using dpad layer.
-    if (inputs.mod_x && inputs.mod_y) {
-        outputs.rightStickX = ANALOG_STICK_NEUTRAL;
-        outputs.rightStickY = ANALOG_STICK_NEUTRAL;
-    }
-
-    // Nunchuk overrides left stick.
-    if (inputs.nunchuk_connected) {
-        outputs.leftStickX = inputs.nunchuk_x;
-        outputs.leftStickY = inputs.nunchuk_y;
-    }
 }
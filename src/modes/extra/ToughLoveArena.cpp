@@ -1,10 +1,9 @@
 #include "modes/extra/ToughLoveArena.hpp"
 
 ToughLoveArena::ToughLoveArena(socd::SocdType socd_type) {
-    _socd_pair_count = 1;
-    _socd_pairs = new socd::SocdPair[_socd_pair_count]{
+    SetSocdPairs({
         socd::SocdPair{&InputState::left, &InputState::right, socd_type},
-    };
+    });
 }
 
 void ToughLoveArena::UpdateKeys(InputState &inputs) {
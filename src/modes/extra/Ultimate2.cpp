@@ -5,14 +5,19 @@
 #define ANALOG_STICK_NEUTRAL 128
 #define ANALOG_STICK_MAX 228
 
-Ultimate2::Ultimate2(socd::SocdType socd_type) {
-    _socd_pair_count = 4;
-    _socd_pairs = new socd::SocdPair[_socd_pair_count]{
+Ultimate2::Ultimate2(socd::SocdType socd_type)
+    : StaticControllerMode(Ultimate2Stages(
+          stages::DpadLayer(stages::MOD_X_AND_MOD_Y | stages::NUNCHUK_C),
+          stages::ShieldAnalog(140),
+          stages::CStickShutoff(stages::MOD_X_AND_MOD_Y | stages::NUNCHUK_C, ANALOG_STICK_NEUTRAL),
+          stages::NunchukLeftStick()
+      )) {
+    SetSocdPairs({
         socd::SocdPair{&InputState::left,    &InputState::right,   socd_type},
         socd::SocdPair{ &InputState::down,   &InputState::up,      socd_type},
         socd::SocdPair{ &InputState::c_left, &InputState::c_right, socd_type},
         socd::SocdPair{ &InputState::c_down, &InputState::c_up,    socd_type},
-    };
+    });
 }
 
 void Ultimate2::UpdateDigitalOutputs(InputState &inputs, OutputState &outputs) {
@@ -25,14 +30,6 @@ void Ultimate2::UpdateDigitalOutputs(InputState &inputs, OutputState &outputs) {
     outputs.triggerRDigital = inputs.r;
     outputs.start = inputs.start;
 
-    // Turn on D-Pad layer by holding Mod X + Mod Y, or Nunchuk C button.
-    if ((inputs.mod_x && inputs.mod_y) || inputs.nunchuk_c) {
-        outputs.dpadUp = inputs.c_up;
-        outputs.dpadDown = inputs.c_down;
-        outputs.dpadLeft = inputs.c_left;
-        outputs.dpadRight = inputs.c_right;
-    }
-
     if (inputs.select)
         outputs.dpadLeft = true;
     if (inputs.home)
@@ -165,23 +162,4 @@ void Ultimate2::UpdateAnalogOutputs(InputState &inputs, OutputState &outputs) {
         outputs.rightStickY = 128 + (directions.cy * 68);
     }
 
-    if (inputs.l) {
-        outputs.triggerLAnalog = 140;
-    }
-
-    if (inputs.r) {
-        outputs.triggerRAnalog = 140;
-    }
-
-    // Shut off C-stick when using D-Pad layer.
-    if ((inputs.mod_x && inputs.mod_y) || inputs.nunchuk_c) {
-        outputs.rightStickX = 128;
-        outputs.rightStickY = 128;
-    }
-
-    // Nunchuk overrides left stick.
-    if (inputs.nunchuk_connected) {
-        outputs.leftStickX = inputs.nunchuk_x;
-        outputs.leftStickY = inputs.nunchuk_y;
-    }
 }
\ No newline at end of file